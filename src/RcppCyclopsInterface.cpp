@@ -15,6 +15,8 @@
 //#include "engine/ModelSpecifics.h"
 #include "priors/JointPrior.h"
 #include "CyclicCoordinateDescent.h"
+#include "engine/FastMath.h"
+#include "engine/Simd.h"
 #include "io/OutputWriter.h"
 #include "RcppOutputHelper.h"
 #include "RcppProgressLogger.h"
@@ -93,6 +95,49 @@ std::vector<std::string> cyclopsGetUseOffsetNames() {
 	return names;
 }
 
+// [[Rcpp::export(".cyclopsSetMathPrecision")]]
+void cyclopsSetMathPrecision(const std::string& precision, bool validate) {
+	using namespace bsccs::fastmath;
+	if (precision == "libm") {
+		setPrecision(Precision::LIBM);
+	} else if (precision == "accurate") {
+		setPrecision(Precision::ACCURATE);
+	} else if (precision == "fast") {
+		setPrecision(Precision::FAST);
+	} else {
+		::Rf_error("Unknown math precision: %s", precision.c_str());
+	}
+	setValidation(validate);
+	resetValidationStatistics();
+}
+
+// [[Rcpp::export(".cyclopsSetInstructionSet")]]
+std::string cyclopsSetInstructionSet(const std::string& instructionSet) {
+	using namespace bsccs::simd;
+	if (instructionSet == "scalar") {
+		setMaximumInstructionSet(InstructionSet::SCALAR);
+	} else if (instructionSet == "sse2") {
+		setMaximumInstructionSet(InstructionSet::SSE2);
+	} else if (instructionSet == "avx2") {
+		setMaximumInstructionSet(InstructionSet::AVX2);
+	} else if (instructionSet == "avx512" || instructionSet == "auto") {
+		setMaximumInstructionSet(InstructionSet::AVX512);
+	} else {
+		::Rf_error("Unknown instruction set: %s", instructionSet.c_str());
+	}
+	return getInstructionSetName(getInstructionSet());
+}
+
+// [[Rcpp::export(".cyclopsGetMathValidation")]]
+List cyclopsGetMathValidation() {
+	const bsccs::fastmath::ValidationStatistics statistics = bsccs::fastmath::getValidationStatistics();
+	return List::create(
+		Named("maxRelativeErrorExp") = statistics.maxRelativeErrorExp,
+		Named("maxRelativeErrorLog") = statistics.maxRelativeErrorLog,
+		Named("evaluations") = static_cast<double>(statistics.evaluations)
+	);
+}
+
 // [[Rcpp::export(.cyclopsSetBeta)]]
 void cyclopsSetBeta(SEXP inRcppCcdInterface, const std::vector<double>& beta) {
     using namespace bsccs;
@@ -141,6 +186,40 @@ double cyclopsGetLogLikelihood(SEXP inRcppCcdInterface) {
 	return interface->getCcd().getLogLikelihood();
 }
 
+// [[Rcpp::export(".cyclopsGetLogLikelihoodGradient")]]
+void cyclopsGetLogLikelihoodGradient(SEXP inRcppCcdInterface, NumericVector& gradient,
+        NumericVector& hessian, int threads) {
+	using namespace bsccs;
+	XPtr<RcppCcdInterface> interface(inRcppCcdInterface);
+
+	const int J = interface->getCcd().getBetaSize();
+	if (gradient.size() != J || (hessian.size() != 0 && hessian.size() != J)) {
+	    ::Rf_error("Gradient and Hessian buffers must hold one value per covariate");
+	}
+
+	// Writes in place; an empty hessian skips the Hessian diagonal
+	interface->getCcd().getLogLikelihoodGradient(&gradient[0],
+		hessian.size() == 0 ? nullptr : &hessian[0], threads);
+}
+
+// [[Rcpp::export(".cyclopsGetLogLikelihoods")]]
+std::vector<double> cyclopsGetLogLikelihoods(SEXP inRcppCcdInterface, const std::vector<double>& betas) {
+	using namespace bsccs;
+	XPtr<RcppCcdInterface> interface(inRcppCcdInterface);
+
+	return interface->getCcd().getLogLikelihoods(betas);
+}
+
+// [[Rcpp::export(".cyclopsGetLogLikelihoodSweep")]]
+std::vector<double> cyclopsGetLogLikelihoodSweep(SEXP inRcppCcdInterface, const double covariate,
+        const std::vector<double>& values) {
+	using namespace bsccs;
+	XPtr<RcppCcdInterface> interface(inRcppCcdInterface);
+
+	const size_t index = interface->getModelData().getColumnIndex(static_cast<IdType>(covariate));
+	return interface->getCcd().getLogLikelihoodSweep(index, values);
+}
+
 // [[Rcpp::export(".cyclopsGetFisherInformation")]]
 Eigen::MatrixXd cyclopsGetFisherInformation(SEXP inRcppCcdInterface, const SEXP sexpCovariates) {
 	using namespace bsccs;
@@ -246,6 +325,18 @@ List cyclopsProfileModel(SEXP inRcppCcdInterface, SEXP sexpCovariates, int threa
 	return List::create();
 }
 
+// [[Rcpp::export(".cyclopsGetProfileLogLikelihood")]]
+std::vector<double> cyclopsGetProfileLogLikelihood(SEXP inRcppCcdInterface, const double covariate,
+        const std::vector<double>& points, int threads, bool override, bool includePenalty) {
+	using namespace bsccs;
+	XPtr<RcppCcdInterface> interface(inRcppCcdInterface);
+
+	std::vector<double> values;
+	interface->evaluateProfileModel(static_cast<IdType>(covariate), points, values, threads,
+		override, includePenalty);
+	return values;
+}
+
 // [[Rcpp::export(".cyclopsPredictModel")]]
 List cyclopsPredictModel(SEXP inRcppCcdInterface) {
 	using namespace bsccs;
@@ -260,13 +351,59 @@ List cyclopsPredictModel(SEXP inRcppCcdInterface) {
 }
 
 
+// [[Rcpp::export(".cyclopsPredictNewData")]]
+List cyclopsPredictNewData(SEXP inRcppCcdInterface, SEXP inNewData,
+        const std::vector<double>& labels, const std::vector<double>& beta, int threads) {
+	using namespace bsccs;
+	XPtr<RcppCcdInterface> interface(inRcppCcdInterface);
+	XPtr<RcppModelData> newData(inNewData);
+
+	if (labels.size() != beta.size()) {
+	    ::Rf_error("Coefficient labels and estimates must have the same length");
+	}
+
+	// Align fitted coefficients to the columns of the new data by covariate label
+	std::map<IdType, double> estimates;
+	for (size_t i = 0; i < labels.size(); ++i) {
+	    estimates[static_cast<IdType>(labels[i])] = beta[i];
+	}
+	std::vector<double> alignedBeta(newData->getNumberOfColumns(), 0.0);
+	const size_t first = newData->getHasOffsetCovariate() ? 1 : 0;
+	if (first == 1) {
+	    alignedBeta[0] = 1.0; // Offset coefficient is fixed at 1, as in the fit
+	}
+	for (size_t j = first; j < alignedBeta.size(); ++j) {
+	    auto it = estimates.find(newData->getColumn(j).getNumericalLabel());
+	    if (it != estimates.end()) {
+	        alignedBeta[j] = it->second;
+	    }
+	}
+
+	std::vector<double> estimatesOut;
+	interface->getCcd().getPredictiveEstimates(*newData, alignedBeta, estimatesOut, threads);
+
+	NumericVector predictions(estimatesOut.begin(), estimatesOut.end());
+	if (newData->getHasRowLabels()) {
+	    CharacterVector rowLabels(predictions.size());
+	    for (int i = 0; i < predictions.size(); ++i) {
+	        rowLabels[i] = newData->getRowLabel(i);
+	    }
+	    predictions.names() = rowLabels;
+	}
+
+	return List::create(
+	        Rcpp::Named("prediction") = predictions
+	    );
+}
+
+
 // [[Rcpp::export(".cyclopsSetControl")]]
 void cyclopsSetControl(SEXP inRcppCcdInterface,
 		int maxIterations, double tolerance, const std::string& convergenceType,
 		bool useAutoSearch, int fold, int foldToCompute, double lowerLimit, double upperLimit, int gridSteps,
 		const std::string& noiseLevel, int threads, int seed, bool resetCoefficients, double startingVariance,
         bool useKKTSwindle, int swindleMultipler, const std::string& selectorType, double initialBound,
-        int maxBoundCount
+        int maxBoundCount, const std::string& algorithm, int maxNewtonDimension
 		) {
 	using namespace bsccs;
 	XPtr<RcppCcdInterface> interface(inRcppCcdInterface);
@@ -279,6 +416,8 @@ void cyclopsSetControl(SEXP inRcppCcdInterface,
     args.modeFinding.swindleMultipler = swindleMultipler;
     args.modeFinding.initialBound = initialBound;
     args.modeFinding.maxBoundCount = maxBoundCount;
+    args.modeFinding.algorithmType = RcppCcdInterface::parseAlgorithmType(algorithm);
+    args.modeFinding.maxNewtonDimension = maxNewtonDimension;
 
 	// Cross validation control
 	args.crossValidation.useAutoSearchCV = useAutoSearch;
@@ -333,6 +472,95 @@ List cyclopsFitModel(SEXP inRcppCcdInterface) {
 	return list;
 }
 
+// [[Rcpp::export(".cyclopsFitAbridge")]]
+List cyclopsFitAbridge(SEXP inRcppCcdInterface, double penalty, SEXP sexpExclude,
+		int maxIterations, double tolerance, double cutoff) {
+	using namespace bsccs;
+
+	XPtr<RcppCcdInterface> interface(inRcppCcdInterface);
+
+	AbridgeArguments& abridge = interface->getArguments().abridge;
+	abridge.penalty = penalty;
+	abridge.maxIterations = maxIterations;
+	abridge.tolerance = tolerance;
+	abridge.cutoff = cutoff;
+	abridge.exclude.clear();
+	if (!Rf_isNull(sexpExclude)) {
+		ProfileVector exclude = as<ProfileVector>(sexpExclude);
+		for (auto it = exclude.begin(); it != exclude.end(); ++it) {
+			abridge.exclude.push_back(interface->getModelData().getColumnIndex(*it));
+		}
+	}
+
+	AbridgeResult result;
+	double timeUpdate = interface->runAbridge(result);
+
+	interface->diagnoseModel(0.0, 0.0);
+
+	List list = List::create(
+			Rcpp::Named("interface")=interface,
+			Rcpp::Named("timeFit")=timeUpdate,
+			Rcpp::Named("abridgeConverged")=result.converged,
+			Rcpp::Named("abridgeIterations")=result.iterations,
+			Rcpp::Named("abridgeFinalPriorVariance")=result.variance
+		);
+	RcppCcdInterface::appendRList(list, interface->getResult());
+	return list;
+}
+
+// [[Rcpp::export(".cyclopsSetKernelProfiling")]]
+void cyclopsSetKernelProfiling(SEXP inRcppCcdInterface, bool enabled) {
+	using namespace bsccs;
+	XPtr<RcppCcdInterface> interface(inRcppCcdInterface);
+	interface->getCcd().getKernelProfile().setEnabled(enabled);
+}
+
+// [[Rcpp::export(".cyclopsSetStratumThreads")]]
+void cyclopsSetStratumThreads(SEXP inRcppCcdInterface, int threads) {
+	using namespace bsccs;
+	XPtr<RcppCcdInterface> interface(inRcppCcdInterface);
+	interface->getCcd().setStratumThreads(threads);
+}
+
+// [[Rcpp::export(".cyclopsSetIncrementalConvergence")]]
+void cyclopsSetIncrementalConvergence(SEXP inRcppCcdInterface, bool incremental) {
+	using namespace bsccs;
+	XPtr<RcppCcdInterface> interface(inRcppCcdInterface);
+	interface->getCcd().setIncrementalConvergence(incremental);
+}
+
+// [[Rcpp::export(".cyclopsGetKernelProfile")]]
+DataFrame cyclopsGetKernelProfile(SEXP inRcppCcdInterface, bool reset) {
+	using namespace bsccs;
+	XPtr<RcppCcdInterface> interface(inRcppCcdInterface);
+	KernelProfile& profile = interface->getCcd().getKernelProfile();
+
+	std::vector<std::string> kernel;
+	std::vector<double> calls;
+	std::vector<double> seconds;
+	std::vector<double> bytes;
+	for (int i = 0; i < KernelProfile::NUMBER_OF_KERNELS; ++i) {
+		const auto id = static_cast<KernelProfile::Kernel>(i);
+		const auto& counter = profile.getCounter(id);
+		kernel.push_back(KernelProfile::getName(id));
+		calls.push_back(static_cast<double>(counter.calls));
+		seconds.push_back(counter.nanoseconds * 1E-9);
+		bytes.push_back(static_cast<double>(counter.bytes));
+	}
+
+	if (reset) {
+		profile.reset();
+	}
+
+	return DataFrame::create(
+			Rcpp::Named("kernel")=kernel,
+			Rcpp::Named("calls")=calls,
+			Rcpp::Named("seconds")=seconds,
+			Rcpp::Named("bytes")=bytes,
+			Rcpp::Named("stringsAsFactors")=false
+		);
+}
+
 // [[Rcpp::export(".cyclopsLogModel")]]
 List cyclopsLogModel(SEXP inRcppCcdInterface) {
 	using namespace bsccs;
@@ -402,7 +630,8 @@ List cyclopsLogModel(SEXP inRcppCcdInterface) {
 }
 
 // [[Rcpp::export(".cyclopsInitializeModel")]]
-List cyclopsInitializeModel(SEXP inModelData, const std::string& modelType, bool computeMLE = false) {
+List cyclopsInitializeModel(SEXP inModelData, const std::string& modelType, bool computeMLE = false,
+		bool singlePrecision = false) {
 	using namespace bsccs;
 
 	XPtr<RcppModelData> rcppModelData(inModelData);
@@ -414,6 +643,7 @@ List cyclopsInitializeModel(SEXP inModelData, const std::string& modelType, bool
 	if (computeMLE) {
 		interface->getArguments().computeMLE = true;
 	}
+	interface->getArguments().useSinglePrecisionStorage = singlePrecision;
 	double timeInit = interface->initializeModel();
 
 //	bsccs::ProfileInformationMap profileMap;
@@ -510,6 +740,21 @@ bsccs::SelectorType RcppCcdInterface::parseSelectorType(const std::string& selec
 	 return selectorType;
 }
 
+bsccs::AlgorithmType RcppCcdInterface::parseAlgorithmType(const std::string& algorithmName) {
+    using namespace bsccs;
+	AlgorithmType algorithmType = AlgorithmType::CCD;
+	if (algorithmName == "auto") {
+		algorithmType = AlgorithmType::AUTO;
+	} else if (algorithmName == "ccd") {
+		algorithmType = AlgorithmType::CCD;
+	} else if (algorithmName == "newton") {
+		algorithmType = AlgorithmType::NEWTON;
+	} else {
+		handleError("Invalid algorithm type.");
+	}
+	return algorithmType;
+}
+
 bsccs::NormalizationType RcppCcdInterface::parseNormalizationType(const std::string& normalizationName) {
     using namespace bsccs;
     NormalizationType normalizationType = NormalizationType::STANDARD_DEVIATION;
@@ -699,7 +944,8 @@ void RcppCcdInterface::initializeModelImpl(
 	// Parse type of model
 	ModelType modelType = parseModelType(arguments.modelName);
 
-	*model = AbstractModelSpecifics::factory(modelType, **modelData);
+	*model = AbstractModelSpecifics::factory(modelType, **modelData,
+			arguments.useSinglePrecisionStorage ? StoragePrecision::SINGLE : StoragePrecision::DOUBLE);
 	if (*model == nullptr) {
 		handleError("Invalid model type.");
 	}
@@ -797,7 +1043,20 @@ void RcppCcdInterface::predictModelImpl(CyclicCoordinateDescent *ccd, ModelData
     //std::vector<double> predictions(ccd->getPredictionSize());
     ccd->getPredictiveEstimates(&predictions[0], NULL);
 
-    if (modelData->getHasRowLabels()) {
+    if (modelData->getIsCompressed()) {
+        // Map predictions for collapsed row patterns back onto the original rows
+        const std::vector<size_t>& pattern = modelData->getRowPattern();
+        NumericVector expanded(pattern.size());
+        CharacterVector labels(pattern.size());
+        for (size_t i = 0; i < pattern.size(); ++i) {
+            expanded[i] = predictions[pattern[i]];
+            labels[i] = modelData->getUncompressedRowLabel(i);
+        }
+        if (modelData->getHasRowLabels()) {
+            expanded.names() = labels;
+        }
+        predictions = expanded;
+    } else if (modelData->getHasRowLabels()) {
         size_t preds = ccd->getPredictionSize();
         CharacterVector labels(preds);
         for (size_t i = 0; i < preds; ++i) {
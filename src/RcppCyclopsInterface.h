@@ -40,6 +40,10 @@ public:
     	return CcdInterface::runFitMLEAtMode(ccd);
     }
 
+    double runAbridge(AbridgeResult& result) {
+    	return CcdInterface::runAbridge(ccd, result);
+    }
+
     double predictModel() {
     	return CcdInterface::predictModel(ccd, modelData);
     }
@@ -51,6 +55,12 @@ public:
     			override, includePenalty);
     }
 
+    double evaluateProfileModel(const IdType covariate, const std::vector<double>& points,
+            std::vector<double>& values, int threads, bool override, bool includePenalty) {
+    	return CcdInterface::evaluateProfileModel(ccd, modelData, covariate, points, values, threads,
+    			override, includePenalty);
+    }
+
     double runCrossValidation() {
     	return CcdInterface::runCrossValidation(ccd, modelData);
     }
@@ -95,6 +105,7 @@ public:
     static ConvergenceType parseConvergenceType(const std::string& convergenceName);
     static NoiseLevels parseNoiseLevel(const std::string& noiseName);
   	static SelectorType parseSelectorType(const std::string& selectorName);
+  	static AlgorithmType parseAlgorithmType(const std::string& algorithmName);
   	static NormalizationType parseNormalizationType(const std::string& normalizationName);
 
 protected:
@@ -58,6 +58,38 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// cyclopsSetMathPrecision
+void cyclopsSetMathPrecision(const std::string& precision, bool validate);
+RcppExport SEXP Cyclops_cyclopsSetMathPrecision(SEXP precisionSEXP, SEXP validateSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const std::string& >::type precision(precisionSEXP);
+    Rcpp::traits::input_parameter< bool >::type validate(validateSEXP);
+    cyclopsSetMathPrecision(precision, validate);
+    return R_NilValue;
+END_RCPP
+}
+// cyclopsSetInstructionSet
+std::string cyclopsSetInstructionSet(const std::string& instructionSet);
+RcppExport SEXP Cyclops_cyclopsSetInstructionSet(SEXP instructionSetSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const std::string& >::type instructionSet(instructionSetSEXP);
+    rcpp_result_gen = Rcpp::wrap(cyclopsSetInstructionSet(instructionSet));
+    return rcpp_result_gen;
+END_RCPP
+}
+// cyclopsGetMathValidation
+List cyclopsGetMathValidation();
+RcppExport SEXP Cyclops_cyclopsGetMathValidation() {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    rcpp_result_gen = Rcpp::wrap(cyclopsGetMathValidation());
+    return rcpp_result_gen;
+END_RCPP
+}
 // cyclopsSetBeta
 void cyclopsSetBeta(SEXP inRcppCcdInterface, const std::vector<double>& beta);
 RcppExport SEXP Cyclops_cyclopsSetBeta(SEXP inRcppCcdInterfaceSEXP, SEXP betaSEXP) {
@@ -127,6 +159,44 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// cyclopsGetLogLikelihoodGradient
+void cyclopsGetLogLikelihoodGradient(SEXP inRcppCcdInterface, NumericVector& gradient, NumericVector& hessian, int threads);
+RcppExport SEXP Cyclops_cyclopsGetLogLikelihoodGradient(SEXP inRcppCcdInterfaceSEXP, SEXP gradientSEXP, SEXP hessianSEXP, SEXP threadsSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type inRcppCcdInterface(inRcppCcdInterfaceSEXP);
+    Rcpp::traits::input_parameter< NumericVector& >::type gradient(gradientSEXP);
+    Rcpp::traits::input_parameter< NumericVector& >::type hessian(hessianSEXP);
+    Rcpp::traits::input_parameter< int >::type threads(threadsSEXP);
+    cyclopsGetLogLikelihoodGradient(inRcppCcdInterface, gradient, hessian, threads);
+    return R_NilValue;
+END_RCPP
+}
+// cyclopsGetLogLikelihoods
+std::vector<double> cyclopsGetLogLikelihoods(SEXP inRcppCcdInterface, const std::vector<double>& betas);
+RcppExport SEXP Cyclops_cyclopsGetLogLikelihoods(SEXP inRcppCcdInterfaceSEXP, SEXP betasSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type inRcppCcdInterface(inRcppCcdInterfaceSEXP);
+    Rcpp::traits::input_parameter< const std::vector<double>& >::type betas(betasSEXP);
+    rcpp_result_gen = Rcpp::wrap(cyclopsGetLogLikelihoods(inRcppCcdInterface, betas));
+    return rcpp_result_gen;
+END_RCPP
+}
+// cyclopsGetLogLikelihoodSweep
+std::vector<double> cyclopsGetLogLikelihoodSweep(SEXP inRcppCcdInterface, const double covariate, const std::vector<double>& values);
+RcppExport SEXP Cyclops_cyclopsGetLogLikelihoodSweep(SEXP inRcppCcdInterfaceSEXP, SEXP covariateSEXP, SEXP valuesSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type inRcppCcdInterface(inRcppCcdInterfaceSEXP);
+    Rcpp::traits::input_parameter< const double >::type covariate(covariateSEXP);
+    Rcpp::traits::input_parameter< const std::vector<double>& >::type values(valuesSEXP);
+    rcpp_result_gen = Rcpp::wrap(cyclopsGetLogLikelihoodSweep(inRcppCcdInterface, covariate, values));
+    return rcpp_result_gen;
+END_RCPP
+}
 // cyclopsGetFisherInformation
 Eigen::MatrixXd cyclopsGetFisherInformation(SEXP inRcppCcdInterface, const SEXP sexpCovariates);
 RcppExport SEXP Cyclops_cyclopsGetFisherInformation(SEXP inRcppCcdInterfaceSEXP, SEXP sexpCovariatesSEXP) {
@@ -170,6 +240,22 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// cyclopsGetProfileLogLikelihood
+std::vector<double> cyclopsGetProfileLogLikelihood(SEXP inRcppCcdInterface, const double covariate, const std::vector<double>& points, int threads, bool override, bool includePenalty);
+RcppExport SEXP Cyclops_cyclopsGetProfileLogLikelihood(SEXP inRcppCcdInterfaceSEXP, SEXP covariateSEXP, SEXP pointsSEXP, SEXP threadsSEXP, SEXP overrideSEXP, SEXP includePenaltySEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type inRcppCcdInterface(inRcppCcdInterfaceSEXP);
+    Rcpp::traits::input_parameter< const double >::type covariate(covariateSEXP);
+    Rcpp::traits::input_parameter< const std::vector<double>& >::type points(pointsSEXP);
+    Rcpp::traits::input_parameter< int >::type threads(threadsSEXP);
+    Rcpp::traits::input_parameter< bool >::type override(overrideSEXP);
+    Rcpp::traits::input_parameter< bool >::type includePenalty(includePenaltySEXP);
+    rcpp_result_gen = Rcpp::wrap(cyclopsGetProfileLogLikelihood(inRcppCcdInterface, covariate, points, threads, override, includePenalty));
+    return rcpp_result_gen;
+END_RCPP
+}
 // cyclopsPredictModel
 List cyclopsPredictModel(SEXP inRcppCcdInterface);
 RcppExport SEXP Cyclops_cyclopsPredictModel(SEXP inRcppCcdInterfaceSEXP) {
@@ -181,9 +267,24 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// cyclopsPredictNewData
+List cyclopsPredictNewData(SEXP inRcppCcdInterface, SEXP inNewData, const std::vector<double>& labels, const std::vector<double>& beta, int threads);
+RcppExport SEXP Cyclops_cyclopsPredictNewData(SEXP inRcppCcdInterfaceSEXP, SEXP inNewDataSEXP, SEXP labelsSEXP, SEXP betaSEXP, SEXP threadsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type inRcppCcdInterface(inRcppCcdInterfaceSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type inNewData(inNewDataSEXP);
+    Rcpp::traits::input_parameter< const std::vector<double>& >::type labels(labelsSEXP);
+    Rcpp::traits::input_parameter< const std::vector<double>& >::type beta(betaSEXP);
+    Rcpp::traits::input_parameter< int >::type threads(threadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(cyclopsPredictNewData(inRcppCcdInterface, inNewData, labels, beta, threads));
+    return rcpp_result_gen;
+END_RCPP
+}
 // cyclopsSetControl
-void cyclopsSetControl(SEXP inRcppCcdInterface, int maxIterations, double tolerance, const std::string& convergenceType, bool useAutoSearch, int fold, int foldToCompute, double lowerLimit, double upperLimit, int gridSteps, const std::string& noiseLevel, int threads, int seed, bool resetCoefficients, double startingVariance, bool useKKTSwindle, int swindleMultipler, const std::string& selectorType, double initialBound, int maxBoundCount);
-RcppExport SEXP Cyclops_cyclopsSetControl(SEXP inRcppCcdInterfaceSEXP, SEXP maxIterationsSEXP, SEXP toleranceSEXP, SEXP convergenceTypeSEXP, SEXP useAutoSearchSEXP, SEXP foldSEXP, SEXP foldToComputeSEXP, SEXP lowerLimitSEXP, SEXP upperLimitSEXP, SEXP gridStepsSEXP, SEXP noiseLevelSEXP, SEXP threadsSEXP, SEXP seedSEXP, SEXP resetCoefficientsSEXP, SEXP startingVarianceSEXP, SEXP useKKTSwindleSEXP, SEXP swindleMultiplerSEXP, SEXP selectorTypeSEXP, SEXP initialBoundSEXP, SEXP maxBoundCountSEXP) {
+void cyclopsSetControl(SEXP inRcppCcdInterface, int maxIterations, double tolerance, const std::string& convergenceType, bool useAutoSearch, int fold, int foldToCompute, double lowerLimit, double upperLimit, int gridSteps, const std::string& noiseLevel, int threads, int seed, bool resetCoefficients, double startingVariance, bool useKKTSwindle, int swindleMultipler, const std::string& selectorType, double initialBound, int maxBoundCount, const std::string& algorithm, int maxNewtonDimension);
+RcppExport SEXP Cyclops_cyclopsSetControl(SEXP inRcppCcdInterfaceSEXP, SEXP maxIterationsSEXP, SEXP toleranceSEXP, SEXP convergenceTypeSEXP, SEXP useAutoSearchSEXP, SEXP foldSEXP, SEXP foldToComputeSEXP, SEXP lowerLimitSEXP, SEXP upperLimitSEXP, SEXP gridStepsSEXP, SEXP noiseLevelSEXP, SEXP threadsSEXP, SEXP seedSEXP, SEXP resetCoefficientsSEXP, SEXP startingVarianceSEXP, SEXP useKKTSwindleSEXP, SEXP swindleMultiplerSEXP, SEXP selectorTypeSEXP, SEXP initialBoundSEXP, SEXP maxBoundCountSEXP, SEXP algorithmSEXP, SEXP maxNewtonDimensionSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
     Rcpp::traits::input_parameter< SEXP >::type inRcppCcdInterface(inRcppCcdInterfaceSEXP);
@@ -206,7 +307,9 @@ BEGIN_RCPP
     Rcpp::traits::input_parameter< const std::string& >::type selectorType(selectorTypeSEXP);
     Rcpp::traits::input_parameter< double >::type initialBound(initialBoundSEXP);
     Rcpp::traits::input_parameter< int >::type maxBoundCount(maxBoundCountSEXP);
-    cyclopsSetControl(inRcppCcdInterface, maxIterations, tolerance, convergenceType, useAutoSearch, fold, foldToCompute, lowerLimit, upperLimit, gridSteps, noiseLevel, threads, seed, resetCoefficients, startingVariance, useKKTSwindle, swindleMultipler, selectorType, initialBound, maxBoundCount);
+    Rcpp::traits::input_parameter< const std::string& >::type algorithm(algorithmSEXP);
+    Rcpp::traits::input_parameter< int >::type maxNewtonDimension(maxNewtonDimensionSEXP);
+    cyclopsSetControl(inRcppCcdInterface, maxIterations, tolerance, convergenceType, useAutoSearch, fold, foldToCompute, lowerLimit, upperLimit, gridSteps, noiseLevel, threads, seed, resetCoefficients, startingVariance, useKKTSwindle, swindleMultipler, selectorType, initialBound, maxBoundCount, algorithm, maxNewtonDimension);
     return R_NilValue;
 END_RCPP
 }
@@ -232,6 +335,67 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// cyclopsFitAbridge
+List cyclopsFitAbridge(SEXP inRcppCcdInterface, double penalty, SEXP sexpExclude, int maxIterations, double tolerance, double cutoff);
+RcppExport SEXP Cyclops_cyclopsFitAbridge(SEXP inRcppCcdInterfaceSEXP, SEXP penaltySEXP, SEXP sexpExcludeSEXP, SEXP maxIterationsSEXP, SEXP toleranceSEXP, SEXP cutoffSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type inRcppCcdInterface(inRcppCcdInterfaceSEXP);
+    Rcpp::traits::input_parameter< double >::type penalty(penaltySEXP);
+    Rcpp::traits::input_parameter< SEXP >::type sexpExclude(sexpExcludeSEXP);
+    Rcpp::traits::input_parameter< int >::type maxIterations(maxIterationsSEXP);
+    Rcpp::traits::input_parameter< double >::type tolerance(toleranceSEXP);
+    Rcpp::traits::input_parameter< double >::type cutoff(cutoffSEXP);
+    rcpp_result_gen = Rcpp::wrap(cyclopsFitAbridge(inRcppCcdInterface, penalty, sexpExclude, maxIterations, tolerance, cutoff));
+    return rcpp_result_gen;
+END_RCPP
+}
+// cyclopsSetKernelProfiling
+void cyclopsSetKernelProfiling(SEXP inRcppCcdInterface, bool enabled);
+RcppExport SEXP Cyclops_cyclopsSetKernelProfiling(SEXP inRcppCcdInterfaceSEXP, SEXP enabledSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type inRcppCcdInterface(inRcppCcdInterfaceSEXP);
+    Rcpp::traits::input_parameter< bool >::type enabled(enabledSEXP);
+    cyclopsSetKernelProfiling(inRcppCcdInterface, enabled);
+    return R_NilValue;
+END_RCPP
+}
+// cyclopsSetStratumThreads
+void cyclopsSetStratumThreads(SEXP inRcppCcdInterface, int threads);
+RcppExport SEXP Cyclops_cyclopsSetStratumThreads(SEXP inRcppCcdInterfaceSEXP, SEXP threadsSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type inRcppCcdInterface(inRcppCcdInterfaceSEXP);
+    Rcpp::traits::input_parameter< int >::type threads(threadsSEXP);
+    cyclopsSetStratumThreads(inRcppCcdInterface, threads);
+    return R_NilValue;
+END_RCPP
+}
+// cyclopsSetIncrementalConvergence
+void cyclopsSetIncrementalConvergence(SEXP inRcppCcdInterface, bool incremental);
+RcppExport SEXP Cyclops_cyclopsSetIncrementalConvergence(SEXP inRcppCcdInterfaceSEXP, SEXP incrementalSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type inRcppCcdInterface(inRcppCcdInterfaceSEXP);
+    Rcpp::traits::input_parameter< bool >::type incremental(incrementalSEXP);
+    cyclopsSetIncrementalConvergence(inRcppCcdInterface, incremental);
+    return R_NilValue;
+END_RCPP
+}
+// cyclopsGetKernelProfile
+DataFrame cyclopsGetKernelProfile(SEXP inRcppCcdInterface, bool reset);
+RcppExport SEXP Cyclops_cyclopsGetKernelProfile(SEXP inRcppCcdInterfaceSEXP, SEXP resetSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type inRcppCcdInterface(inRcppCcdInterfaceSEXP);
+    Rcpp::traits::input_parameter< bool >::type reset(resetSEXP);
+    rcpp_result_gen = Rcpp::wrap(cyclopsGetKernelProfile(inRcppCcdInterface, reset));
+    return rcpp_result_gen;
+END_RCPP
+}
 // cyclopsLogModel
 List cyclopsLogModel(SEXP inRcppCcdInterface);
 RcppExport SEXP Cyclops_cyclopsLogModel(SEXP inRcppCcdInterfaceSEXP) {
@@ -244,15 +408,16 @@ BEGIN_RCPP
 END_RCPP
 }
 // cyclopsInitializeModel
-List cyclopsInitializeModel(SEXP inModelData, const std::string& modelType, bool computeMLE);
-RcppExport SEXP Cyclops_cyclopsInitializeModel(SEXP inModelDataSEXP, SEXP modelTypeSEXP, SEXP computeMLESEXP) {
+List cyclopsInitializeModel(SEXP inModelData, const std::string& modelType, bool computeMLE, bool singlePrecision);
+RcppExport SEXP Cyclops_cyclopsInitializeModel(SEXP inModelDataSEXP, SEXP modelTypeSEXP, SEXP computeMLESEXP, SEXP singlePrecisionSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
     Rcpp::traits::input_parameter< SEXP >::type inModelData(inModelDataSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type modelType(modelTypeSEXP);
     Rcpp::traits::input_parameter< bool >::type computeMLE(computeMLESEXP);
-    rcpp_result_gen = Rcpp::wrap(cyclopsInitializeModel(inModelData, modelType, computeMLE));
+    Rcpp::traits::input_parameter< bool >::type singlePrecision(singlePrecisionSEXP);
+    rcpp_result_gen = Rcpp::wrap(cyclopsInitializeModel(inModelData, modelType, computeMLE, singlePrecision));
     return rcpp_result_gen;
 END_RCPP
 }
@@ -336,6 +501,18 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// cyclopsGetDuplicateCovariates
+DataFrame cyclopsGetDuplicateCovariates(Environment object, int threads);
+RcppExport SEXP Cyclops_cyclopsGetDuplicateCovariates(SEXP objectSEXP, SEXP threadsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Environment >::type object(objectSEXP);
+    Rcpp::traits::input_parameter< int >::type threads(threadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(cyclopsGetDuplicateCovariates(object, threads));
+    return rcpp_result_gen;
+END_RCPP
+}
 // cyclopsGetNumberOfColumns
 int cyclopsGetNumberOfColumns(Environment object);
 RcppExport SEXP Cyclops_cyclopsGetNumberOfColumns(SEXP objectSEXP) {
@@ -490,6 +667,43 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// cyclopsSetRowMajorMirror
+void cyclopsSetRowMajorMirror(Environment x, bool useMirror, int threads);
+RcppExport SEXP Cyclops_cyclopsSetRowMajorMirror(SEXP xSEXP, SEXP useMirrorSEXP, SEXP threadsSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Environment >::type x(xSEXP);
+    Rcpp::traits::input_parameter< bool >::type useMirror(useMirrorSEXP);
+    Rcpp::traits::input_parameter< int >::type threads(threadsSEXP);
+    cyclopsSetRowMajorMirror(x, useMirror, threads);
+    return R_NilValue;
+END_RCPP
+}
+// cyclopsSetColumnEncoding
+int cyclopsSetColumnEncoding(Environment x, bool useEncoding);
+RcppExport SEXP Cyclops_cyclopsSetColumnEncoding(SEXP xSEXP, SEXP useEncodingSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Environment >::type x(xSEXP);
+    Rcpp::traits::input_parameter< bool >::type useEncoding(useEncodingSEXP);
+    rcpp_result_gen = Rcpp::wrap(cyclopsSetColumnEncoding(x, useEncoding));
+    return rcpp_result_gen;
+END_RCPP
+}
+// cyclopsGetColumnRowIndices
+std::vector<int> cyclopsGetColumnRowIndices(Environment x, const double covariateLabel, bool decode);
+RcppExport SEXP Cyclops_cyclopsGetColumnRowIndices(SEXP xSEXP, SEXP covariateLabelSEXP, SEXP decodeSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Environment >::type x(xSEXP);
+    Rcpp::traits::input_parameter< const double >::type covariateLabel(covariateLabelSEXP);
+    Rcpp::traits::input_parameter< bool >::type decode(decodeSEXP);
+    rcpp_result_gen = Rcpp::wrap(cyclopsGetColumnRowIndices(x, covariateLabel, decode));
+    return rcpp_result_gen;
+END_RCPP
+}
 // cyclopsGetHasOffset
 bool cyclopsGetHasOffset(Environment x);
 RcppExport SEXP Cyclops_cyclopsGetHasOffset(SEXP xSEXP) {
@@ -528,6 +742,30 @@ BEGIN_RCPP
     return R_NilValue;
 END_RCPP
 }
+// cyclopsSortRows
+std::vector<double> cyclopsSortRows(Environment x, bool byTime, int threads);
+RcppExport SEXP Cyclops_cyclopsSortRows(SEXP xSEXP, SEXP byTimeSEXP, SEXP threadsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Environment >::type x(xSEXP);
+    Rcpp::traits::input_parameter< bool >::type byTime(byTimeSEXP);
+    Rcpp::traits::input_parameter< int >::type threads(threadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(cyclopsSortRows(x, byTime, threads));
+    return rcpp_result_gen;
+END_RCPP
+}
+// cyclopsCompressRows
+std::vector<double> cyclopsCompressRows(Environment x);
+RcppExport SEXP Cyclops_cyclopsCompressRows(SEXP xSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Environment >::type x(xSEXP);
+    rcpp_result_gen = Rcpp::wrap(cyclopsCompressRows(x));
+    return rcpp_result_gen;
+END_RCPP
+}
 // cyclopsLoadDataY
 void cyclopsLoadDataY(Environment x, const std::vector<int64_t>& stratumId, const std::vector<int64_t>& rowId, const std::vector<double>& y, const std::vector<double>& time);
 RcppExport SEXP Cyclops_cyclopsLoadDataY(SEXP xSEXP, SEXP stratumIdSEXP, SEXP rowIdSEXP, SEXP ySEXP, SEXP timeSEXP) {
@@ -619,8 +857,8 @@ BEGIN_RCPP
 END_RCPP
 }
 // cyclopsModelData
-List cyclopsModelData(SEXP pid, SEXP y, SEXP z, SEXP offs, SEXP dx, SEXP sx, SEXP ix, const std::string& modelTypeName, bool useTimeAsOffset, int numTypes);
-RcppExport SEXP Cyclops_cyclopsModelData(SEXP pidSEXP, SEXP ySEXP, SEXP zSEXP, SEXP offsSEXP, SEXP dxSEXP, SEXP sxSEXP, SEXP ixSEXP, SEXP modelTypeNameSEXP, SEXP useTimeAsOffsetSEXP, SEXP numTypesSEXP) {
+List cyclopsModelData(SEXP pid, SEXP y, SEXP z, SEXP offs, SEXP dx, SEXP sx, SEXP ix, const std::string& modelTypeName, bool useTimeAsOffset, int numTypes, bool hasIntercept);
+RcppExport SEXP Cyclops_cyclopsModelData(SEXP pidSEXP, SEXP ySEXP, SEXP zSEXP, SEXP offsSEXP, SEXP dxSEXP, SEXP sxSEXP, SEXP ixSEXP, SEXP modelTypeNameSEXP, SEXP useTimeAsOffsetSEXP, SEXP numTypesSEXP, SEXP hasInterceptSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
@@ -634,7 +872,8 @@ BEGIN_RCPP
     Rcpp::traits::input_parameter< const std::string& >::type modelTypeName(modelTypeNameSEXP);
     Rcpp::traits::input_parameter< bool >::type useTimeAsOffset(useTimeAsOffsetSEXP);
     Rcpp::traits::input_parameter< int >::type numTypes(numTypesSEXP);
-    rcpp_result_gen = Rcpp::wrap(cyclopsModelData(pid, y, z, offs, dx, sx, ix, modelTypeName, useTimeAsOffset, numTypes));
+    Rcpp::traits::input_parameter< bool >::type hasIntercept(hasInterceptSEXP);
+    rcpp_result_gen = Rcpp::wrap(cyclopsModelData(pid, y, z, offs, dx, sx, ix, modelTypeName, useTimeAsOffset, numTypes, hasIntercept));
     return rcpp_result_gen;
 END_RCPP
 }
@@ -11,6 +11,7 @@
 #include "RcppCyclopsInterface.h"
 #include "io/NewGenericInputReader.h"
 #include "RcppProgressLogger.h"
+#include <thread>
 
 using namespace Rcpp;
 
@@ -175,6 +176,55 @@ CharacterVector cyclopsGetCovariateType(Environment object, const std::vector<in
 	return types;
 }
 
+//' @title Find duplicate covariates
+//'
+//' @description
+//' \code{getDuplicateCovariates} reports covariates whose values equal those of an earlier covariate
+//' in every row, and covariates that are zero in every row
+//'
+//' @details
+//' Identical covariates are not separately identifiable. Under a normal prior with variance v they
+//' share one effect equally, so keeping a single representative with variance k * v for k copies
+//' gives the same fit with fewer columns.
+//'
+//' @param object    A Cyclops data object
+//' @param threads   Number of threads used to hash covariates
+//'
+//' @return A data frame with one row per flagged covariate: \code{covariateId}, \code{duplicateOf}
+//' (identifier of the first identical covariate, or \code{NA}) and \code{allZero}
+//'
+//' @export
+// [[Rcpp::export("getDuplicateCovariates")]]
+DataFrame cyclopsGetDuplicateCovariates(Environment object, int threads = 1) {
+    using namespace bsccs;
+    XPtr<ModelData> data = parseEnvironmentForPtr(object);
+
+    if (threads <= 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    std::vector<int> duplicateOf;
+    std::vector<bool> allZero;
+    data->findDuplicateColumns(duplicateOf, allZero, threads);
+
+    std::vector<double> covariateId;
+    std::vector<double> duplicateId;
+    std::vector<bool> zero;
+    for (size_t j = 0; j < duplicateOf.size(); ++j) {
+        if (duplicateOf[j] != static_cast<int>(j) || allZero[j]) {
+            covariateId.push_back(data->getColumn(j).getNumericalLabel());
+            duplicateId.push_back(allZero[j] ? NA_REAL :
+                data->getColumn(duplicateOf[j]).getNumericalLabel());
+            zero.push_back(allZero[j]);
+        }
+    }
+
+    return DataFrame::create(
+        _["covariateId"] = covariateId,
+        _["duplicateOf"] = duplicateId,
+        _["allZero"] = zero);
+}
+
 //' @title Get total number of covariates
 //'
 //' @description
@@ -366,6 +416,46 @@ bool cyclopsGetHasIntercept(Environment x) {
     return data->getHasInterceptCovariate();
 }
 
+// [[Rcpp::export(".cyclopsSetRowMajorMirror")]]
+void cyclopsSetRowMajorMirror(Environment x, bool useMirror, int threads) {
+    using namespace bsccs;
+    XPtr<ModelData> data = parseEnvironmentForPtr(x);
+    data->setUseRowMajorMirror(useMirror, threads);
+}
+
+// [[Rcpp::export(".cyclopsSetColumnEncoding")]]
+int cyclopsSetColumnEncoding(Environment x, bool useEncoding) {
+    using namespace bsccs;
+    XPtr<ModelData> data = parseEnvironmentForPtr(x);
+    if (useEncoding) {
+        return static_cast<int>(data->encodeColumns());
+    }
+    data->clearColumnEncodings();
+    return 0;
+}
+
+// [[Rcpp::export(".cyclopsGetColumnRowIndices")]]
+std::vector<int> cyclopsGetColumnRowIndices(Environment x, const double covariateLabel, bool decode) {
+    using namespace bsccs;
+    XPtr<ModelData> data = parseEnvironmentForPtr(x);
+    const size_t index = data->getColumnIndex(static_cast<IdType>(covariateLabel));
+    const CompressedDataColumn& column = data->getColumn(index);
+    const RowIndexEncoding* encoding = column.getEncoding();
+
+    if (decode && encoding != nullptr) { // Rows as the gradient kernel streams them
+        std::vector<int> rows(encoding->getNumberOfBlocks() * RowIndexEncoding::BLOCK_SIZE);
+        size_t length = 0;
+        for (size_t block = 0; block < encoding->getNumberOfBlocks(); ++block) {
+            length += encoding->decodeBlock(block, rows.data() + length);
+        }
+        rows.resize(length);
+        return rows;
+    }
+
+    const ColumnView<int> rows = column.getColumnsView();
+    return std::vector<int>(rows.data(), rows.data() + rows.size());
+}
+
 // [[Rcpp::export(".cyclopsGetHasOffset")]]
 bool cyclopsGetHasOffset(Environment x) {
     using namespace bsccs;
@@ -402,14 +492,8 @@ void cyclopsFinalizeData(
         if (data->getHasInterceptCovariate()) {
             ::Rf_error("OHDSI data object already has an intercept");
         }
-        // TODO add intercept as INTERCEPT_TYPE if magicFlag ==  true
-        data->insert(0, DENSE); // add to front, TODO fix if offset
+        data->insert(0, INTERCEPT); // add to front, TODO fix if offset
         data->setHasInterceptCovariate(true);
-       // CompressedDataColumn& intercept = data->getColumn(0);
-        const size_t numRows = data->getNumberOfRows();
-        for (size_t i = 0; i < numRows; ++i) {
-            data->getColumn(0).add_data(i, static_cast<real>(1.0));
-        }
     }
 
     if (!Rf_isNull(sexpOffsetCovariate)) {
@@ -452,10 +536,44 @@ void cyclopsFinalizeData(
         }
     }
 
+    data->packColumns();
     data->setIsFinalized(true);
 }
 
 
+// [[Rcpp::export(".cyclopsSortRows")]]
+std::vector<double> cyclopsSortRows(Environment x, bool byTime, int threads = 1) {
+    using namespace bsccs;
+    XPtr<ModelData> data = parseEnvironmentForPtr(x);
+
+    if (threads <= 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    const std::vector<size_t>& order = data->sortRows(byTime, threads);
+
+    std::vector<double> result(order.size()); // 1-based for R
+    std::transform(order.begin(), order.end(), result.begin(), [](size_t i) {
+        return static_cast<double>(i + 1);
+    });
+    return result;
+}
+
+// [[Rcpp::export(".cyclopsCompressRows")]]
+std::vector<double> cyclopsCompressRows(Environment x) {
+    using namespace bsccs;
+    XPtr<ModelData> data = parseEnvironmentForPtr(x);
+
+    data->compressRowPatterns();
+
+    const std::vector<size_t>& pattern = data->getRowPattern(); // Empty if no rows collapsed
+    std::vector<double> result(pattern.size()); // 1-based for R
+    std::transform(pattern.begin(), pattern.end(), result.begin(), [](size_t i) {
+        return static_cast<double>(i + 1);
+    });
+    return result;
+}
+
 // [[Rcpp::export(".loadCyclopsDataY")]]
 void cyclopsLoadDataY(Environment x,
         const std::vector<int64_t>& stratumId,
@@ -548,6 +666,7 @@ List cyclopsReadFileData(const std::string& fileName, const std::string& modelTy
 		reader->readFile(fileName.c_str()); // TODO Check for error
 
     XPtr<ModelData> ptr(reader->getModelData());
+    ptr->packColumns();
 
 
     const std::vector<double>& y = ptr->getYVectorRef();
@@ -569,7 +688,8 @@ List cyclopsReadFileData(const std::string& fileName, const std::string& modelTy
 List cyclopsModelData(SEXP pid, SEXP y, SEXP z, SEXP offs, SEXP dx, SEXP sx, SEXP ix,
     const std::string& modelTypeName,
     bool useTimeAsOffset = false,
-    int numTypes = 1) {
+    int numTypes = 1,
+    bool hasIntercept = false) {
 
     using namespace bsccs;
     ModelType modelType = RcppCcdInterface::parseModelType(modelTypeName);
@@ -619,6 +739,11 @@ List cyclopsModelData(SEXP pid, SEXP y, SEXP z, SEXP offs, SEXP dx, SEXP sx, SEX
 
     XPtr<RcppModelData> ptr(new RcppModelData(modelType, ipid, iy, iz, ioffs, dxv, siv,
     	spv, sxv, iiv, ipv, useTimeAsOffset, numTypes));
+    if (hasIntercept) { // The model-matrix intercept is a dense column of ones
+        ptr->setHasInterceptCovariate(true);
+        ptr->convertInterceptColumn();
+    }
+    ptr->packColumns();
 
 	double duration = timer();
 
@@ -773,18 +898,13 @@ RcppModelData::RcppModelData(
 	    }
 	    nPatients = nRows;
 	} else {
-    	int currentCase = 0;
-    	int currentPID = cpid[0];
-    	cpid[0] = currentCase;
-    	for (size_t i = 1; i < pid.size(); ++i) {
-    	    int nextPID = cpid[i];
-    	    if (nextPID != currentPID) {
-	            currentCase++;
-	            currentPID = nextPID;
-    	    }
-	        cpid[i] = currentCase;
+        // Number strata by first appearance so interleaved strata still share one index
+        bsccs::unordered_map<int,int> caseMap;
+    	for (size_t i = 0; i < cpid.size(); ++i) {
+    	    auto inserted = caseMap.insert(std::make_pair(cpid[i], static_cast<int>(caseMap.size())));
+	        cpid[i] = inserted.first->second;
     	}
-        nPatients = currentCase + 1;
+        nPatients = caseMap.size();
     }
 }
 
@@ -9,6 +9,7 @@
 #define RCPPOUTPUTHELPER_H_
 
 #include "Rcpp.h"
+#include "io/BinaryOutputStream.h"
 
 namespace bsccs {
 
@@ -50,6 +51,10 @@ public:
 	    allValues.push_back(bsccs::make_shared<Values>());
 	    return *this; 
 	}
+
+    RcppOutputHelper& addHeader(const char* t, ValueType /*type*/) {
+	    return addHeader(t);
+	}
 		
     RcppOutputHelper& addMetaKey(const char* t) {
 	    currentKey = std::string(t);	    
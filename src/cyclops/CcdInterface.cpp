@@ -172,8 +172,10 @@ void CcdInterface::setDefaultArguments(void) {
 	arguments.replicates = 100;
 	arguments.reportRawEstimates = false;
 	arguments.modelName = "sccs";
+	arguments.useSinglePrecisionStorage = false;
 	arguments.fileFormat = "generic";
 	//arguments.outputFormat = "estimates";
+	arguments.binaryOutput = false;
 	arguments.computeMLE = false;
 	arguments.fitMLEAtMode = false;
 	arguments.reportASE = false;
@@ -531,6 +533,124 @@ double CcdInterface::profileModel(CyclicCoordinateDescent *ccd, ModelData *model
 	return calculateSeconds(time1, time2);
 }
 
+double CcdInterface::evaluateProfileModel(CyclicCoordinateDescent *ccd, ModelData *modelData,
+		const IdType covariate, const std::vector<double>& points, std::vector<double>& values,
+		int inThreads, bool overrideNoRegularization, bool includePenalty) {
+
+	struct timeval time1, time2;
+	gettimeofday(&time1, NULL);
+
+	const int index = modelData->getColumnIndexByName(covariate);
+	if (index == -1) {
+	    std::ostringstream stream;
+		stream << "Variable " << covariate << " not found.";
+		error->throwError(stream);
+	}
+	if (!overrideNoRegularization && ccd->getIsRegularized(index)) {
+	    std::ostringstream stream;
+	    stream << "Variable " << covariate << " is regularized.";
+	    error->throwError(stream);
+	}
+
+	const int J = ccd->getBetaSize();
+	std::vector<double> x0s(J);
+	for (int j = 0; j < J; ++j) {
+	    x0s[j] = ccd->getBeta(j);
+	}
+	const double x0 = x0s[index];
+	const bool wasFixed = ccd->getFixedBeta(index); // Restored after each point; clones copy it
+
+	// Walk away from the mode on each side, so consecutive points on a thread are neighbours
+	std::vector<size_t> order(points.size());
+	for (size_t i = 0; i < order.size(); ++i) {
+		order[i] = i;
+	}
+	std::sort(order.begin(), order.end(), [&points](size_t lhs, size_t rhs) {
+		return points[lhs] < points[rhs];
+	});
+	std::vector<size_t> tasks;
+	for (auto it = order.begin(); it != order.end(); ++it) {
+		if (points[*it] >= x0) {
+			tasks.push_back(*it);
+		}
+	}
+	for (auto it = order.rbegin(); it != order.rend(); ++it) {
+		if (points[*it] < x0) {
+			tasks.push_back(*it);
+		}
+	}
+
+	values.assign(points.size(), NAN);
+
+	int nThreads = (inThreads == -1) ?
+	    bsccs::thread::hardware_concurrency() : inThreads;
+	nThreads = std::max(1, std::min(nThreads, static_cast<int>(tasks.size())));
+
+	std::vector<CyclicCoordinateDescent*> ccdPool;
+	ccdPool.push_back(ccd);
+	for (int i = 1; i < nThreads; ++i) {
+	    ccdPool.push_back(ccd->clone());
+	}
+
+	std::vector<int> lastSide(nThreads, 0);
+
+	auto evaluate = [this, &ccdPool, &lastSide, &tasks, &points, &values, &x0s,
+					 x0, index, wasFixed, includePenalty](size_t task, size_t thread) {
+		CyclicCoordinateDescent* local = ccdPool[thread];
+		const double x = points[tasks[task]];
+
+		// Each thread restarts from the mode when it starts on (or turns to) a side
+		const int side = (x >= x0) ? 1 : -1;
+		if (side != lastSide[thread]) {
+			local->setBeta(x0s);
+			lastSide[thread] = side;
+		}
+
+		local->setBeta(index, x);
+		local->setFixedBeta(index, true);
+		local->update(arguments.modeFinding);
+		local->setFixedBeta(index, wasFixed);
+		double value = local->getLogLikelihood();
+		if (includePenalty) {
+			value += local->getLogPrior();
+		}
+		values[tasks[task]] = value;
+	};
+
+	if (nThreads == 1) {
+		for (size_t task = 0; task < tasks.size(); ++task) {
+			evaluate(task, 0);
+		}
+	} else {
+        auto scheduler = TaskScheduler<boost::counting_iterator<int> >(
+            boost::make_counting_iterator(0),
+            boost::make_counting_iterator(static_cast<int>(tasks.size())),
+            nThreads);
+
+        auto oneTask = [&evaluate, &scheduler](unsigned long task) {
+            evaluate(task, scheduler.getThreadIndex(task));
+        };
+
+        ccd->getProgressLogger().setConcurrent(true);
+        ccd->getErrorHandler().setConcurrent(true);
+        scheduler.execute(oneTask);
+        ccd->getProgressLogger().setConcurrent(false);
+        ccd->getErrorHandler().setConcurrent(false);
+        ccd->getProgressLogger().flush();
+        ccd->getErrorHandler().flush();
+	}
+
+	for (int i = 1; i < nThreads; ++i) {
+		delete ccdPool[i];
+	}
+
+	// Reset to mode
+	ccd->setBeta(x0s);
+
+	gettimeofday(&time2, NULL);
+	return calculateSeconds(time1, time2);
+}
+
 double CcdInterface::diagnoseModel(CyclicCoordinateDescent *ccd, ModelData *modelData,
 		double loadTime,
 		double updateTime) {
@@ -638,6 +758,22 @@ double CcdInterface::runFitMLEAtMode(CyclicCoordinateDescent* ccd) {
 	return calculateSeconds(time1, time2);
 }
 
+double CcdInterface::runAbridge(CyclicCoordinateDescent* ccd, AbridgeResult& result) {
+	if (arguments.noiseLevel > SILENT) {
+	    std::ostringstream stream;
+		stream << "Using broken adaptive ridge with penalty " << arguments.abridge.penalty;
+		logger->writeLine(stream);
+	}
+
+	struct timeval time1, time2;
+	gettimeofday(&time1, NULL);
+
+	result = ccd->fitAbridge(arguments.modeFinding, arguments.abridge);
+
+	gettimeofday(&time2, NULL);
+	return calculateSeconds(time1, time2);
+}
+
 double CcdInterface::runCrossValidation(CyclicCoordinateDescent *ccd, ModelData *modelData) {
 	struct timeval time1, time2;
 	gettimeofday(&time1, NULL);
@@ -70,6 +70,8 @@ struct ModeFindingArguments {
 	int swindleMultipler;
 	double initialBound;
 	int maxBoundCount;
+	AlgorithmType algorithmType;
+	int maxNewtonDimension; // AUTO uses Newton steps up to this many free covariates
 
 	ModeFindingArguments() :
 		tolerance(1E-6),
@@ -79,10 +81,37 @@ struct ModeFindingArguments {
 		useKktSwindle(false),
 		swindleMultipler(10),
 		initialBound(2.0),
-		maxBoundCount(5)
+		maxBoundCount(5),
+		algorithmType(AlgorithmType::CCD),
+		maxNewtonDimension(100)
 	    { }
 };
 
+struct AbridgeArguments {
+
+	// All options related to broken adaptive ridge (ABRIDGE) iterations go here
+	double penalty;
+	int maxIterations;
+	double tolerance;
+	double cutoff;
+	std::vector<int> exclude; // Column indices left unpenalized
+
+	AbridgeArguments() :
+		penalty(1.0),
+		maxIterations(100),
+		tolerance(1E-8),
+		cutoff(1E-16)
+		{ }
+};
+
+struct AbridgeResult {
+	bool converged;
+	int iterations;
+	std::vector<double> variance; // Final prior variance by column (Inf when unpenalized)
+
+	AbridgeResult() : converged(false), iterations(0) { }
+};
+
 struct CCDArguments {
 
 	// Needed for fitting
@@ -91,6 +120,7 @@ struct CCDArguments {
 	std::string fileFormat;
 	std::string outDirectoryName;
 	std::vector<std::string> outputFormat;
+	bool binaryOutput;
 	bool useGPU;
 	bool useBetterGPU;
 	int deviceNumber;
@@ -121,6 +151,7 @@ struct CCDArguments {
 	// Needed for model specification
 	int modelType;
 	std::string modelName;
+	bool useSinglePrecisionStorage;
 
 	NoiseLevels noiseLevel;
 
@@ -132,6 +163,7 @@ struct CCDArguments {
 
 	ModeFindingArguments modeFinding;
 	CrossValidationArguments crossValidation;
+	AbridgeArguments abridge;
 };
 
 
@@ -153,6 +185,10 @@ public:
     double runFitMLEAtMode(
             CyclicCoordinateDescent* ccd);
 
+    double runAbridge(
+            CyclicCoordinateDescent* ccd,
+            AbridgeResult& result);
+
     double predictModel(
             CyclicCoordinateDescent *ccd,
             ModelData *modelData);
@@ -167,6 +203,18 @@ public:
             bool overrideNoRegularization = false,
             bool includePenalty = false);
 
+    // Profile log-likelihood of covariate at each of points, refitting all other coefficients;
+    // points are split across cloned CCDs and each warm-starts from its neighbour's mode
+    double evaluateProfileModel(
+            CyclicCoordinateDescent *ccd,
+            ModelData *modelData,
+            const IdType covariate,
+            const std::vector<double>& points,
+            std::vector<double>& values,
+            int threads,
+            bool overrideNoRegularization = false,
+            bool includePenalty = false);
+
     double runCrossValidation(
             CyclicCoordinateDescent *ccd,
             ModelData *modelData);
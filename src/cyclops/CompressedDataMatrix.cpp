@@ -11,12 +11,14 @@
 #include <numeric>
 #include <vector>
 #include <stdexcept>
+#include <cstdint>
 
 #include "CompressedDataMatrix.h"
 
 namespace bsccs {
 
-CompressedDataMatrix::CompressedDataMatrix() : nRows(0), nCols(0), nEntries(0) {
+CompressedDataMatrix::CompressedDataMatrix() : nRows(0), nCols(0), nEntries(0),
+		encodedColumns(false) {
 	// Do nothing
 }
 
@@ -37,6 +39,8 @@ real CompressedDataMatrix::sumColumn(int column) {
 	    throw new std::invalid_argument("DENSE");
 // 		cerr << "Not yet implemented (SPARSE)." << endl;
 // 		exit(-1);
+	} else if (getFormatType(column) == INTERCEPT) {
+		sum = getNumberOfRows();
 	} else { // is indiciator
 		sum = allColumns[column]->getNumberOfEntries();
 	}
@@ -122,16 +126,101 @@ int* CompressedDataMatrix::getCompressedColumnVector(int column) const {
 	return allColumns[column]->getColumns();
 }
 
-std::vector<int>& CompressedDataMatrix::getCompressedColumnVectorSTL(int column) const {
-	return allColumns[column]->getColumnsVector();
+ColumnView<int> CompressedDataMatrix::getCompressedColumnVectorSTL(int column) const {
+	return allColumns[column]->getColumnsView();
 }
 
 real* CompressedDataMatrix::getDataVector(int column) const {
 	return allColumns[column]->getData();
 }
 
-std::vector<real>& CompressedDataMatrix::getDataVectorSTL(int column) const {
-	return allColumns[column]->getDataVector();
+ColumnView<real> CompressedDataMatrix::getDataVectorSTL(int column) const {
+	return allColumns[column]->getDataView();
+}
+
+namespace {
+
+const size_t ARENA_ALIGNMENT = 64; // bytes
+
+// Rounds n up so that the next column also starts on an ARENA_ALIGNMENT boundary
+template <typename T>
+size_t paddedLength(size_t n) {
+	const size_t width = ARENA_ALIGNMENT / sizeof(T);
+	return (n + width - 1) / width * width;
+}
+
+template <typename T>
+T* alignedBegin(std::vector<T>& arena) {
+	const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(arena.data());
+	const std::uintptr_t aligned = (address + ARENA_ALIGNMENT - 1) & ~(ARENA_ALIGNMENT - 1);
+	return reinterpret_cast<T*>(aligned);
+}
+
+} // namespace
+
+void CompressedDataMatrix::packColumns() {
+	size_t indexLength = 0;
+	size_t dataLength = 0;
+	for (const auto& column : allColumns) {
+		if (column->hasColumns()) {
+			indexLength += paddedLength<int>(column->getColumnsView().size());
+		}
+		if (column->hasData()) {
+			dataLength += paddedLength<real>(column->getDataView().size());
+		}
+	}
+
+	// Slack for aligning the first column
+	IntVector newIndexArena(indexLength + ARENA_ALIGNMENT / sizeof(int));
+	RealVector newDataArena(dataLength + ARENA_ALIGNMENT / sizeof(real));
+
+	int* nextIndex = alignedBegin(newIndexArena);
+	real* nextData = alignedBegin(newDataArena);
+	for (auto& column : allColumns) {
+		const bool hasColumns = column->hasColumns();
+		const bool hasData = column->hasData();
+		const size_t nIndices = column->getColumnsView().size();
+		const size_t nData = column->getDataView().size();
+
+		// Copies out of the old arena if already packed
+		column->pack(hasColumns ? nextIndex : nullptr, hasData ? nextData : nullptr);
+
+		if (hasColumns) {
+			nextIndex += paddedLength<int>(nIndices);
+		}
+		if (hasData) {
+			nextData += paddedLength<real>(nData);
+		}
+	}
+
+	indexArena.swap(newIndexArena);
+	dataArena.swap(newDataArena);
+}
+
+bool CompressedDataMatrix::isPacked() const {
+	return !indexArena.empty();
+}
+
+size_t CompressedDataMatrix::encodeColumns() {
+	size_t count = 0;
+	for (auto& column : allColumns) {
+		if (column->encode(nRows)) {
+			++count;
+		}
+	}
+	encodedColumns = true;
+	return count;
+}
+
+void CompressedDataMatrix::clearColumnEncodings() {
+	for (auto& column : allColumns) {
+		column->clearEncoding();
+	}
+	encodedColumns = false;
+}
+
+bool CompressedDataMatrix::hasEncodedColumns() const {
+	return encodedColumns;
 }
 
 
@@ -142,7 +231,10 @@ FormatType CompressedDataMatrix::getFormatType(int column) const {
 void CompressedDataColumn::fill(RealVector& values, int nRows) {
 	values.resize(nRows);
 	if (formatType == DENSE) {
-			values.assign(data->begin(), data->end());
+			const ColumnView<real> view = getDataView();
+			values.assign(view.begin(), view.end());
+		} else if (formatType == INTERCEPT) {
+			values.assign(nRows, static_cast<real>(1.0));
 		} else {
 			bool isSparse = formatType == SPARSE;
 			values.assign(nRows, 0.0);
@@ -151,7 +243,7 @@ void CompressedDataColumn::fill(RealVector& values, int nRows) {
 			for (size_t i = 0; i < n; ++i) {
 				const int k = indicators[i];
 				if (isSparse) {
-					values[k] = data->at(i);
+					values[k] = getData()[i];
 				} else {
 					values[k] = 1.0;
 				}
@@ -202,6 +294,10 @@ CompressedDataMatrix* CompressedDataMatrix::transpose() {
 					matTranspose->allColumns[this->getCompressedColumnVector(i)[j]]->add_data(
 							i, 1.0);
 			}
+		} else if (thisFormatType == INTERCEPT) {
+			for (size_t j = 0; j < nRows; j++) {
+				matTranspose->getColumn(j).add_data(i, 1.0);
+			}
 		} else {
 			for (size_t j = 0; j < nRows; j++) {
 				matTranspose->getColumn(j).add_data(i,
@@ -228,6 +324,8 @@ void CompressedDataMatrix::getDataRow(int row, real* x) const {
 	{
 		if(this->allColumns[j]->getFormatType() == DENSE)
 			x[j] = this->getDataVector(j)[row];
+		else if(this->allColumns[j]->getFormatType() == INTERCEPT)
+			x[j] = 1.0;
 		else{
 			x[j] = 0.0;
 			int* col = this->getCompressedColumnVector(j);
@@ -243,6 +341,44 @@ void CompressedDataMatrix::getDataRow(int row, real* x) const {
 	}
 }
 
+void CompressedDataMatrix::accumulateXBeta(const real* beta, real* xBeta,
+		size_t rowBegin, size_t rowEnd) const {
+	for (size_t j = 0; j < nCols; ++j) {
+		const real b = beta[j];
+		if (b == static_cast<real>(0)) {
+			continue;
+		}
+		const CompressedDataColumn& column = *allColumns[j];
+		const FormatType formatType = column.getFormatType();
+		if (formatType == INTERCEPT) {
+			for (size_t k = rowBegin; k < rowEnd; ++k) {
+				xBeta[k] += b;
+			}
+		} else if (formatType == DENSE) {
+			const ColumnView<real> data = column.getDataView();
+			const size_t end = std::min(rowEnd, data.size());
+			for (size_t k = rowBegin; k < end; ++k) {
+				xBeta[k] += data[k] * b;
+			}
+		} else {
+			// Row indices are sorted, so locate the block by bisection
+			const ColumnView<int> rows = column.getColumnsView();
+			const auto first = std::lower_bound(rows.begin(), rows.end(), static_cast<int>(rowBegin));
+			const auto last = std::lower_bound(first, rows.end(), static_cast<int>(rowEnd));
+			if (formatType == INDICATOR) {
+				for (auto it = first; it != last; ++it) {
+					xBeta[*it] += b;
+				}
+			} else { // SPARSE
+				const real* data = column.getData() + std::distance(rows.begin(), first);
+				for (auto it = first; it != last; ++it, ++data) {
+					xBeta[*it] += *data * b;
+				}
+			}
+		}
+	}
+}
+
 void CompressedDataMatrix::setNumberOfColumns(int nColumns) {
 	nCols = nColumns;
 }
@@ -266,7 +402,8 @@ real CompressedDataColumn::squaredSumColumn(size_t n) const {
 	} else if (formatType == INTERCEPT) {
 	    return static_cast<real>(n);
 	} else {
-		return std::inner_product( data->begin(), data->end(), data->begin(), static_cast<real>(0.0));
+		const ColumnView<real> view = getDataView();
+		return std::inner_product(view.begin(), view.end(), view.begin(), static_cast<real>(0.0));
 	}
 }
 
@@ -280,6 +417,7 @@ void CompressedDataColumn::convertColumnToSparse(void) {
         throw new std::invalid_argument("DENSE");
 	}
 
+	unpack();
 	if (data == NULL) {
 //		data = new real_vector();
         data = make_shared<RealVector>();
@@ -295,11 +433,18 @@ void CompressedDataColumn::convertColumnToDense(int nRows) {
 		return;
 	}
 
+	unpack();
 //	real_vector* oldData = data;
     RealVectorPtr oldData = data;
 //	data = new real_vector();
     data = make_shared<RealVector>();
 
+	if (formatType == INTERCEPT) {
+		data->resize(nRows, static_cast<real>(1));
+		formatType = DENSE;
+		return;
+	}
+
 	data->resize(nRows, static_cast<real>(0));
 
 	int* indicators = getColumns();
@@ -322,8 +467,89 @@ void CompressedDataColumn::convertColumnToDense(int nRows) {
 //	}
 }
 
+bool CompressedDataColumn::isConstantOne(size_t nRows) const {
+	const real one = static_cast<real>(1);
+	if (formatType == INTERCEPT) {
+		return true;
+	}
+	const ColumnView<real> values = getDataView();
+	if (formatType == DENSE) {
+		return values.size() == nRows &&
+			std::all_of(values.begin(), values.end(), [one](real x) { return x == one; });
+	} else if (formatType == INDICATOR) {
+		return getNumberOfEntries() == nRows;
+	} else { // SPARSE
+		return getNumberOfEntries() == nRows &&
+			std::all_of(values.begin(), values.end(), [one](real x) { return x == one; });
+	}
+}
+
+void CompressedDataColumn::convertColumnToIntercept(void) {
+	formatType = INTERCEPT;
+	data = NULL;
+	columns = NULL;
+	packedColumns = nullptr;
+	packedData = nullptr;
+	nPackedColumns = 0;
+	nPackedData = 0;
+	packed = false;
+	encoding.reset();
+}
+
+void CompressedDataColumn::pack(int* arenaColumns, real* arenaData) {
+	const ColumnView<int> indices = getColumnsView();
+	const ColumnView<real> values = getDataView();
+	if (arenaColumns) {
+		std::copy(indices.begin(), indices.end(), arenaColumns);
+	}
+	if (arenaData) {
+		std::copy(values.begin(), values.end(), arenaData);
+	}
+	packedColumns = arenaColumns;
+	packedData = arenaData;
+	nPackedColumns = arenaColumns ? indices.size() : 0;
+	nPackedData = arenaData ? values.size() : 0;
+	packed = true;
+	columns = NULL;
+	data = NULL;
+}
+
+bool CompressedDataColumn::encode(size_t nRows) {
+	encoding.reset();
+	if (formatType != SPARSE && formatType != INDICATOR) {
+		return false;
+	}
+	const ColumnView<int> rows = getColumnsView();
+	auto candidate = make_shared<RowIndexEncoding>();
+	candidate->encode(rows.data(), rows.size(), nRows);
+	if (candidate->getType() == RowIndexEncoding::PLAIN) {
+		return false;
+	}
+	encoding = candidate;
+	return true;
+}
+
+void CompressedDataColumn::unpack() {
+	encoding.reset();
+	if (!packed) {
+		return;
+	}
+	if (packedColumns) {
+		columns = make_shared<IntVector>(packedColumns, packedColumns + nPackedColumns);
+	}
+	if (packedData) {
+		data = make_shared<RealVector>(packedData, packedData + nPackedData);
+	}
+	packedColumns = nullptr;
+	packedData = nullptr;
+	nPackedColumns = 0;
+	nPackedData = 0;
+	packed = false;
+}
+
 // TODO Fix massive copying
 void CompressedDataColumn::addToColumnVector(IntVector addEntries){
+	unpack();
 	int lastit = 0;
 
 	for(int i = 0; i < (int)addEntries.size(); i++)
@@ -340,6 +566,7 @@ void CompressedDataColumn::addToColumnVector(IntVector addEntries){
 }
 
 void CompressedDataColumn::removeFromColumnVector(IntVector removeEntries){
+	unpack();
 	int lastit = 0;
 	IntVector::iterator it1 = removeEntries.begin();
 	IntVector::iterator it2 = columns->begin();
@@ -23,6 +23,7 @@
 //#define DATA_AOS
 
 #include "Types.h"
+#include "RowIndexEncoding.h"
 
 namespace bsccs {
 
@@ -37,6 +38,31 @@ enum FormatType {
 	DENSE, SPARSE, INDICATOR, INTERCEPT
 };
 
+/**
+ * Non-owning [begin, end) view of one column's indices or values.  Column storage may
+ * live either in per-column vectors or in a matrix-wide arena (see packColumns()), so
+ * read-only accessors hand out views rather than std::vector references.
+ */
+template <typename T>
+class ColumnView {
+public:
+	ColumnView(T* begin, size_t size) : first(begin), length(size) { }
+
+	T* begin() const { return first; }
+
+	T* end() const { return first + length; }
+
+	T* data() const { return first; }
+
+	size_t size() const { return length; }
+
+	T& operator[](size_t i) const { return first[i]; }
+
+private:
+	T* first;
+	size_t length;
+};
+
 class CompressedDataColumn {
 public:
 
@@ -46,7 +72,9 @@ public:
 	CompressedDataColumn(IntVectorPtr colIndices, RealVectorPtr colData, FormatType colFormat,
 			std::string colName = "", IdType nName = 0, bool sPtrs = false) :
 		 columns(colIndices), data(colData), formatType(colFormat), stringName(colName),
-		 numericalName(nName), sharedPtrs(sPtrs) {
+		 numericalName(nName), sharedPtrs(sPtrs),
+		 packedColumns(nullptr), packedData(nullptr), nPackedColumns(0), nPackedData(0),
+		 packed(false) {
 		// Do nothing
 	}
 
@@ -61,43 +89,79 @@ public:
 	}
 
 	int* getColumns() const {
-		return static_cast<int*>(columns->data());
+		return packed ? packedColumns : static_cast<int*>(columns->data());
 	}
 
 	real* getData() const {
-		return static_cast<real*>(data->data());
+		return packed ? packedData : static_cast<real*>(data->data());
 	}
 
-	const std::vector<int>& getColumnsVector() const {
-		return *columns;
+	ColumnView<int> getColumnsView() const {
+		if (packed) {
+			return ColumnView<int>(packedColumns, nPackedColumns);
+		}
+		return columns ? ColumnView<int>(columns->data(), columns->size()) :
+				ColumnView<int>(nullptr, 0);
 	}
 
-	const std::vector<real>& getDataVector() const {
-		return *data;
+	ColumnView<real> getDataView() const {
+		if (packed) {
+			return ColumnView<real>(packedData, nPackedData);
+		}
+		return data ? ColumnView<real>(data->data(), data->size()) :
+				ColumnView<real>(nullptr, 0);
 	}
 
+	// Mutable access to owned storage; moves a packed column back out of its arena
 	std::vector<int>& getColumnsVector() {
+		unpack();
 		return *columns;
 	}
 
 	std::vector<real>& getDataVector() {
+		unpack();
 		return *data;
 	}
 
 	std::vector<real> copyData() {
 // 		std::vector copy(std::begin(data), std::end(data));
 // 		return std::move(copy);
-		return std::vector<real>(*data);
+		const ColumnView<real> view = getDataView();
+		return std::vector<real>(view.begin(), view.end());
 	}
 
 	template <typename Function>
 	void transform(Function f) {
-	    std::transform(data->begin(), data->end(), data->begin(), f);
+		const ColumnView<real> view = getDataView();
+	    std::transform(view.begin(), view.end(), view.begin(), f);
 	}
 
 	template <typename Function, typename ValueType>
 	ValueType accumulate(Function f, ValueType x) {
-	    return std::accumulate(data->begin(), data->end(), x, f);
+		const ColumnView<real> view = getDataView();
+	    return std::accumulate(view.begin(), view.end(), x, f);
+	}
+
+	bool isPacked() const {
+		return packed;
+	}
+
+	// Copies indices and values into arena storage and releases the per-column vectors
+	void pack(int* arenaColumns, real* arenaData);
+
+	// Restores per-column vectors and drops any encoding; a no-op otherwise
+	void unpack();
+
+	// Compact copy of the row indices for streaming kernels; null when not encoded
+	const RowIndexEncoding* getEncoding() const {
+		return encoding.get();
+	}
+
+	// Encodes SPARSE or INDICATOR row indices when that at least halves their size
+	bool encode(size_t nRows);
+
+	void clearEncoding() {
+		encoding.reset();
 	}
 
 	FormatType getFormatType() const {
@@ -134,11 +198,19 @@ public:
 	}
 
 	size_t getNumberOfEntries() const {
-		return columns->size();
+		return packed ? nPackedColumns : columns->size();
 	}
 
 	size_t getDataVectorLength() const {
-		return data->size();
+		return packed ? nPackedData : data->size();
+	}
+
+	bool hasColumns() const {
+		return packed ? packedColumns != nullptr : static_cast<bool>(columns);
+	}
+
+	bool hasData() const {
+		return packed ? packedData != nullptr : static_cast<bool>(data);
 	}
 
 	void add_label(std::string label) {
@@ -150,6 +222,7 @@ public:
 	}
 
 	bool add_data(int row, real value) {
+		unpack();
 		if (formatType == DENSE) {
 			//Making sure that we are at the correct row
 			for(int i = data->size(); i < row; i++) {
@@ -185,6 +258,11 @@ public:
 
 	void convertColumnToSparse(void);
 
+	// Releases all storage; only valid when isConstantOne()
+	void convertColumnToIntercept(void);
+
+	bool isConstantOne(size_t nRows) const;
+
 	void fill(RealVector& values, int nRows);
 
 	void printColumn(int nRows);
@@ -226,6 +304,15 @@ private:
 	mutable std::string stringName;
 	IdType numericalName;
 	bool sharedPtrs; // TODO Actually use shared pointers
+
+	// Views into the owning matrix's arena; valid while packed
+	int* packedColumns;
+	real* packedData;
+	size_t nPackedColumns;
+	size_t nPackedData;
+	bool packed;
+
+	bsccs::shared_ptr<RowIndexEncoding> encoding;
 };
 
 class CompressedDataMatrix {
@@ -249,16 +336,50 @@ public:
 	size_t getNumberOfNonZeroEntries(int column) const;
 
 	int* getCompressedColumnVector(int column) const; // TODO depreciate
-	std::vector<int>& getCompressedColumnVectorSTL(int column) const;
+	ColumnView<int> getCompressedColumnVectorSTL(int column) const;
 
 	void removeFromColumnVector(int column, IntVector removeEntries) const;
 	void addToColumnVector(int column, IntVector addEntries) const;
 
  	real* getDataVector(int column) const;  // TODO depreciate
 
-	std::vector<real>& getDataVectorSTL(int column) const;
+	ColumnView<real> getDataVectorSTL(int column) const;
 
 	void getDataRow(int row, real* x) const;
+
+	/**
+	 * Accumulates X * beta into xBeta for rows [rowBegin, rowEnd).  Touches only
+	 * entries inside the row block, so disjoint blocks may run concurrently.
+	 */
+	void accumulateXBeta(const real* beta, real* xBeta, size_t rowBegin, size_t rowEnd) const;
+
+	/**
+	 * Moves all column indices and values into two contiguous, 64-byte aligned arenas
+	 * (one for row indices, one for values) and releases the per-column vectors, so a
+	 * design with many columns no longer holds two small heap blocks per column.
+	 * Columns become views into the arenas; mutating a column afterwards copies it
+	 * back out.  Calling again compacts the arenas.
+	 */
+	void packColumns();
+
+	bool isPacked() const;
+
+	/**
+	 * Adds a compact row-index encoding (bit-packed deltas or a row bitmap) to every
+	 * SPARSE and INDICATOR column where it at least halves the index size.  The plain
+	 * indices are kept for all other consumers (iterators, the row-major mirror, the R
+	 * accessors); only the gathered gradient kernel streams the encoding instead.  This
+	 * cuts that kernel's memory traffic but does not shrink the design, which grows by
+	 * the size of the encodings, so they are opt-in.  Returns the number of encoded
+	 * columns.
+	 */
+	size_t encodeColumns();
+
+	// Drops all encodings; kernels read the plain indices again
+	void clearColumnEncodings();
+
+	bool hasEncodedColumns() const;
+
 	CompressedDataMatrix* transpose();
 
 	FormatType getFormatType(int column) const;
@@ -370,6 +491,8 @@ public:
 //	        real_vector* r = new real_vector();
             RealVectorPtr r = make_shared<RealVector>();
 	        insert(allColumns.begin() + position, NULL, r, DENSE);
+	    } else if (colFormat == INTERCEPT) {
+	        insert(allColumns.begin() + position, NULL, NULL, INTERCEPT);
 	    } else {
             throw new std::invalid_argument("Unknown type");
 	    }
@@ -435,6 +558,10 @@ protected:
 	size_t nEntries;
 	DataColumnVector allColumns;
 
+	IntVector indexArena;
+	RealVector dataArena;
+	bool encodedColumns;
+
 private:
 	// Disable copy-constructors and copy-assignment
 	CompressedDataMatrix(const CompressedDataMatrix&);
@@ -15,10 +15,14 @@
 #include <time.h>
 #include <set>
 #include <list>
+#include <limits>
 
 #include "CyclicCoordinateDescent.h"
 #include "Iterators.h"
 #include "Timing.h"
+#include "Thread.h"
+
+#include "boost/iterator/counting_iterator.hpp"
 
 namespace bsccs {
 
@@ -49,6 +53,7 @@ CyclicCoordinateDescent::CyclicCoordinateDescent(
 	likelihoodCount = 0;
 	noiseLevel = NOISY;
 	initialBound = 2.0;
+	incrementalConvergence = true;
 
 	init(hXI.getHasOffsetCovariate());
 }
@@ -60,6 +65,9 @@ CyclicCoordinateDescent* CyclicCoordinateDescent::clone() {
 //template <typename T>
 //struct GetType<T>;
 
+// Clones share the design (ModelData) and joint prior with the prototype; model specifics
+// are deep copied except for read-only sparse index sets (see ModelSpecifics::clone()), so
+// all row, stratum and coefficient buffers are private to each clone
 CyclicCoordinateDescent::CyclicCoordinateDescent(const CyclicCoordinateDescent& copy)
 	: privateModelSpecifics(
 			bsccs::unique_ptr<AbstractModelSpecifics>(
@@ -84,6 +92,7 @@ CyclicCoordinateDescent::CyclicCoordinateDescent(const CyclicCoordinateDescent&
 	likelihoodCount = 0;
 	noiseLevel = copy.noiseLevel;
 	initialBound = copy.initialBound;
+	incrementalConvergence = copy.incrementalConvergence;
 
 	init(hXI.getHasOffsetCovariate());
 
@@ -178,6 +187,7 @@ void CyclicCoordinateDescent::init(bool offset) {
 
 	useCrossValidation = false;
 	validWeights = false;
+	objectiveCoefficientsKnown = false;
 	sufficientStatisticsKnown = false;
 	fisherInformationKnown = false;
 	varianceKnown = false;
@@ -197,6 +207,10 @@ void CyclicCoordinateDescent::init(bool offset) {
 			NULL,
 			hY
 			);
+
+	if (hXI.getIsCompressed()) {
+		setWeights(NULL); // Row multiplicities
+	}
 }
 
 int CyclicCoordinateDescent::getAlignedLength(int N) {
@@ -276,6 +290,33 @@ void CyclicCoordinateDescent::getPredictiveEstimates(double* y, double* weights)
 	modelSpecifics.getPredictiveEstimates(y, weights);
 }
 
+void CyclicCoordinateDescent::getPredictiveEstimates(const ModelData& X,
+		const std::vector<double>& beta, std::vector<double>& y, int nThreads) const {
+
+	if (beta.size() != X.getNumberOfColumns()) {
+		std::ostringstream stream;
+		stream << "Coefficient vector length (" << beta.size() << ") does not match number of columns ("
+			<< X.getNumberOfColumns() << ")";
+		error->throwError(stream);
+	}
+
+	y.assign(X.getNumberOfRows(), 0.0);
+
+	const bool byRow = X.getUseRowMajorMirror();
+	if (byRow) {
+		X.getRowMajorMirror(); // Build once, before the blocks
+	}
+
+	X.forEachRowBlock([this, &X, &beta, &y, byRow](size_t begin, size_t end) {
+		if (byRow) {
+			X.computeXBetaByRow(beta.data(), y.data(), begin, end);
+		} else {
+			X.accumulateXBeta(beta.data(), y.data(), begin, end);
+		}
+		modelSpecifics.getPredictiveEstimates(y.data(), y.data(), begin, end);
+	}, nThreads);
+}
+
 int CyclicCoordinateDescent::getBetaSize(void) {
 	return J;
 }
@@ -315,6 +356,7 @@ void CyclicCoordinateDescent::checkAllLazyFlags(void) {
 		computeFixedTermsInLogLikelihood();
 		computeFixedTermsInGradientAndHessian();
 		validWeights = true;
+		objectiveCoefficientsKnown = false;
 	}
 
 	if (!sufficientStatisticsKnown) {
@@ -405,7 +447,9 @@ void CyclicCoordinateDescent::setBeta(int i, double beta) {
 
 void CyclicCoordinateDescent::setWeights(double* iWeights) {
 
-	if (iWeights == NULL) {
+	const RealVector& rowCounts = hXI.getRowCountsRef(); // Non-empty for compressed row patterns
+
+	if (iWeights == NULL && rowCounts.empty()) {
 		if (hWeights.size() != 0) {
 			hWeights.resize(0);
 		}
@@ -420,7 +464,12 @@ void CyclicCoordinateDescent::setWeights(double* iWeights) {
 			hWeights.resize(K); // = (double*) malloc(sizeof(double) * K);
 		}
 		for (int i = 0; i < K; ++i) {
-			hWeights[i] = iWeights[i];
+			hWeights[i] = (iWeights == NULL) ? 1.0 : iWeights[i];
+		}
+		if (!rowCounts.empty()) { // Each row stands for rowCounts[i] identical rows
+			for (int i = 0; i < K; ++i) {
+				hWeights[i] *= rowCounts[i];
+			}
 		}
 		useCrossValidation = true;
 		validWeights = false;
@@ -494,6 +543,9 @@ void CyclicCoordinateDescent::update(const ModeFindingArguments& arguments) {
 	while (!done) {
  	    if (arguments.useKktSwindle && jointPrior->getSupportsKktSwindle()) {
 		    kktSwindle(arguments);
+	    } else if (arguments.algorithmType != AlgorithmType::CCD) {
+		    findModeByNewton(maxIterations, convergenceType, epsilon,
+		    		arguments.algorithmType == AlgorithmType::NEWTON ? J : arguments.maxNewtonDimension);
 	    } else {
 		    findMode(maxIterations, convergenceType, epsilon);
 	    }
@@ -509,6 +561,88 @@ void CyclicCoordinateDescent::update(const ModeFindingArguments& arguments) {
 	}
 }
 
+AbridgeResult CyclicCoordinateDescent::fitAbridge(const ModeFindingArguments& modeFinding,
+		const AbridgeArguments& abridge) {
+
+	using namespace bsccs::priors;
+
+	// Columns already fixed (e.g. an offset) or explicitly excluded stay unpenalized
+	std::vector<bool> penalized(J, true);
+	for (auto index : abridge.exclude) {
+		if (index < 0 || index >= J) {
+			std::ostringstream stream;
+			stream << "Unable to exclude column " << index << " from broken adaptive ridge";
+			error->throwError(stream);
+		}
+		penalized[index] = false;
+	}
+	for (int j = 0; j < J; ++j) {
+		if (fixBeta[j]) {
+			penalized[j] = false;
+		}
+	}
+
+	// One normal prior per penalized column; variances are then updated in place between refits
+	auto prior = bsccs::make_shared<MixtureJointPrior>(bsccs::make_shared<NoPrior>(), J);
+	std::vector<VariancePtr> variances(J);
+	for (int j = 0; j < J; ++j) {
+		if (penalized[j]) {
+			variances[j] = bsccs::make_shared<double>(1.0);
+			prior->changePrior(bsccs::make_shared<NormalPrior>(variances[j]), j);
+		}
+	}
+	setPrior(prior);
+
+	AbridgeResult result;
+	result.variance.resize(J, std::numeric_limits<double>::infinity());
+
+	std::vector<double> previous(hBeta.begin(), hBeta.end());
+
+	while (!result.converged && result.iterations < abridge.maxIterations) {
+		++result.iterations;
+
+		for (int j = 0; j < J; ++j) {
+			if (penalized[j]) {
+				if (std::abs(previous[j]) < abridge.cutoff) {
+					// Drop column from all further cycles
+					if (xBetaKnown) {
+						setBeta(j, 0.0); // Incremental, keeps xBeta as a warm start
+					} else {
+						hBeta[j] = 0.0;
+					}
+					fixBeta[j] = true;
+					penalized[j] = false;
+					result.variance[j] = 0.0;
+				} else {
+					*variances[j] = previous[j] * previous[j] / abridge.penalty;
+					result.variance[j] = *variances[j];
+				}
+			}
+		}
+
+		update(modeFinding);
+
+		double maxChange = 0.0;
+		for (int j = 0; j < J; ++j) {
+			maxChange = std::max(maxChange, std::abs(hBeta[j] - previous[j]));
+			previous[j] = hBeta[j];
+		}
+		result.converged = maxChange < abridge.tolerance;
+
+		if (noiseLevel > QUIET) {
+			std::ostringstream stream;
+			stream << "Broken adaptive ridge iteration " << result.iterations
+			       << ", maximum change " << maxChange;
+			logger->writeLine(stream);
+		}
+	}
+
+	fisherInformationKnown = false;
+	varianceKnown = false;
+
+	return result;
+}
+
 typedef std::tuple<
 	int,    // index
 	double, // gradient
@@ -535,7 +669,7 @@ void CyclicCoordinateDescent::kktSwindle(const ModeFindingArguments& arguments)
 
 	// Make sure internal state is up-to-date
 	checkAllLazyFlags();
-
+	priorTable.refresh(*jointPrior, J);
 
 	std::list<ScoreTuple> activeSet;
 	std::list<ScoreTuple> inactiveSet;
@@ -552,7 +686,7 @@ void CyclicCoordinateDescent::kktSwindle(const ModeFindingArguments& arguments)
 			excludeSet.push_back(index);
 		} else {
 			if (index == intercept || // Always place intercept into active set
-                !jointPrior->getSupportsKktSwindle(index)) {
+                !priorTable.getSupportsKktSwindle(index)) {
 // 				activeSet.push_back(index);
 				activeSet.push_back(std::make_tuple(index, 0.0, true));
 			} else {
@@ -618,7 +752,7 @@ void CyclicCoordinateDescent::kktSwindle(const ModeFindingArguments& arguments)
 			} else {
 
 				auto checkConditions = [this] (const ScoreTuple& score) {
-					return (std::get<1>(score) <= jointPrior->getKktBoundary(std::get<0>(score)));
+					return (std::get<1>(score) <= priorTable.getKktBoundary(std::get<0>(score)));
 				};
 
 //				auto checkAlmostConditions = [this] (const ScoreTuple& score) {
@@ -728,11 +862,7 @@ void CyclicCoordinateDescent::computeKktConditions(Container& scoreSet) {
 }
 
 
-void CyclicCoordinateDescent::findMode(
-		int maxIterations,
-		int convergenceType,
-		double epsilon
-		) {
+void CyclicCoordinateDescent::prepareForModeFinding(int convergenceType) {
 
 	if (convergenceType < GRADIENT || convergenceType > ZHANG_OLES) {
 	    std::ostringstream stream;
@@ -740,12 +870,15 @@ void CyclicCoordinateDescent::findMode(
 		error->throwError(stream);
 	}
 
+	priorTable.refresh(*jointPrior, J); // Variances may have changed since the last fit
+
 	if (!validWeights || hXI.getTouchedY() // || hXI.getTouchedX()
 		) {
 		computeNEvents();
 		computeFixedTermsInLogLikelihood();
 		computeFixedTermsInGradientAndHessian();
 		validWeights = true;
+		objectiveCoefficientsKnown = false;
 		hXI.clean();
 	}
 
@@ -761,8 +894,38 @@ void CyclicCoordinateDescent::findMode(
 	}
 
 	resetBounds();
+}
+
+void CyclicCoordinateDescent::findModeByNewton(
+		int maxIterations,
+		int convergenceType,
+		double epsilon,
+		int maxDimension
+		) {
+
+	prepareForModeFinding(convergenceType);
+
+	std::vector<int> indices;
+	bool quadratic = true;
+	for (int index = 0; index < J; ++index) {
+		if (!fixBeta[index]) {
+			indices.push_back(index);
+			quadratic = quadratic && priorTable.getIsQuadratic(index);
+		}
+	}
+
+	// Non-smooth priors and wide designs stay with coordinate descent
+	if (!quadratic || indices.empty() || static_cast<int>(indices.size()) > maxDimension) {
+		findMode(maxIterations, convergenceType, epsilon);
+		return;
+	}
+
+	const int p = static_cast<int>(indices.size());
+	std::vector<double> gradient;
+	std::vector<double> hessian;
 
 	bool done = false;
+	bool fallback = false;
 	int iteration = 0;
 	double lastObjFunc = 0.0;
 
@@ -772,15 +935,188 @@ void CyclicCoordinateDescent::findMode(
 		saveXBeta();
 	}
 
+	while (!done) {
+
+		// One Newton step over all free covariates counts as a complete cycle
+		KernelProfile::Scope cycleProfile(modelSpecifics.getKernelProfile(), KernelProfile::CYCLE);
+
+		if (!modelSpecifics.computeGradientAndHessianMatrix(indices, gradient, hessian,
+				useCrossValidation)) {
+			fallback = true;
+			break;
+		}
+
+		Eigen::Map<Eigen::VectorXd> g(gradient.data(), p);
+		Eigen::Map<Matrix> H(hessian.data(), p, p); // Symmetric, so storage order does not matter
+
+		for (int a = 0; a < p; ++a) {
+			const double precision = priorTable.getPrecision(indices[a]);
+			g(a) += hBeta[indices[a]] * precision;
+			H(a, a) += precision;
+		}
+
+		Eigen::LLT<Matrix> cholesky(H);
+		if (cholesky.info() != Eigen::Success) { // Not positive-definite, e.g. unpenalized separation
+			fallback = true;
+			break;
+		}
+		const Eigen::VectorXd step = -cholesky.solve(g);
+		if (!std::isfinite(step.sum())) {
+			fallback = true;
+			break;
+		}
+
+		// Shorten the whole step to fit the per-coordinate trust region (hDelta), keeping the
+		// Newton direction; this is step control, not a constraint on beta itself
+		double scale = 1.0;
+		for (int a = 0; a < p; ++a) {
+			const double length = std::abs(step(a));
+			const double trustRadius = hDelta[indices[a]];
+			if (length > trustRadius) {
+				scale = std::min(scale, trustRadius / length);
+			}
+		}
+
+		for (int a = 0; a < p; ++a) {
+			const int index = indices[a];
+			const double delta = applyBounds(scale * step(a), index);
+			if (delta != 0.0) {
+				sufficientStatisticsKnown = false;
+				updateSufficientStatistics(delta, index);
+			}
+		}
+
+		iteration++;
+
+		double conv;
+		bool illconditioned = false;
+		if (convergenceType < ZHANG_OLES) {
+			double thisObjFunc = getObjectiveFunction(convergenceType);
+			if (thisObjFunc != thisObjFunc) {
+			    std::ostringstream stream;
+				stream << "\nWarning: problem is ill-conditioned for this choice of\n"
+                       << "\t prior (" << jointPrior->getDescription() << ") or\n"
+                       << "\t initial bounding box (" << initialBound << ")\n"
+                       << "Enforcing convergence!";
+				logger->writeLine(stream);
+				conv = 0.0;
+				illconditioned = true;
+			} else {
+				conv = computeConvergenceCriterion(thisObjFunc, lastObjFunc);
+			}
+			lastObjFunc = thisObjFunc;
+		} else { // ZHANG_OLES
+			conv = computeZhangOlesConvergenceCriterion();
+			saveXBeta();
+		}
+
+        std::ostringstream stream;
+		if (noiseLevel > QUIET) {
+			double thisLogLikelihood = getLogLikelihood();
+			double thisLogPrior = getLogPrior();
+			double thisLogPost = thisLogLikelihood + thisLogPrior;
+
+		    stream << "\n";
+			printVector(&hBeta[0], J, stream);
+			stream << "\n";
+			stream << "log post: " << thisLogPost
+					<< " (" << thisLogLikelihood << " + " << thisLogPrior
+					<< ") (Newton iter:" << iteration << ") ";
+		}
+
+		if (epsilon > 0 && conv < epsilon) {
+			if (illconditioned) {
+				lastReturnFlag = ILLCONDITIONED;
+			} else {
+				if (noiseLevel > SILENT) {
+					stream << "Reached convergence criterion";
+				}
+				lastReturnFlag = SUCCESS;
+			}
+			done = true;
+		} else if (iteration == maxIterations) {
+			if (noiseLevel > SILENT) {
+				stream << "Reached maximum iterations";
+			}
+			done = true;
+			lastReturnFlag = MAX_ITERATIONS;
+		}
+		if (noiseLevel > QUIET) {
+            logger->writeLine(stream);
+		}
+
+		logger->yield();
+	}
+
+	if (fallback) {
+		if (noiseLevel > QUIET) {
+			std::ostringstream stream;
+			stream << "Newton step unavailable after " << iteration
+				   << " iterations; continuing with coordinate descent";
+			logger->writeLine(stream);
+		}
+		findMode(maxIterations, convergenceType, epsilon);
+		return;
+	}
+
+	lastIterationCount = iteration;
+	updateCount += 1;
+
+	fisherInformationKnown = false;
+	varianceKnown = false;
+}
+
+void CyclicCoordinateDescent::findMode(
+		int maxIterations,
+		int convergenceType,
+		double epsilon
+		) {
+
+	prepareForModeFinding(convergenceType);
+
+	bool done = false;
+	int iteration = 0;
+	double lastObjFunc = 0.0;
+
+	// The objective is tracked from per-coordinate changes (see getObjectiveChange()) and recomputed
+	// in full periodically and whenever the tracked change comes within objectiveExactMargin * epsilon
+	// of convergence.  GRADIENT is tracked exactly; MITTAL and LANGE use a second-order expansion of
+	// the log-likelihood, so they only stop once two consecutive objectives are exact.  LANGE needs
+	// a tabulated (separable) prior; otherwise it is evaluated in full every cycle.
+	const bool trackObjective = incrementalConvergence && (convergenceType == GRADIENT ||
+			convergenceType == MITTAL || (convergenceType == LANGE && priorTable.getIsTabulated()));
+	const bool trackExactly = convergenceType == GRADIENT;
+	const int objectiveRefreshInterval = 10;
+	const double objectiveExactMargin = 10.0;
+	double trackedObjFunc = 0.0;
+	double lastConv = 0.0;
+	bool lastExact = true;
+
+	if (trackObjective && trackExactly && !objectiveCoefficientsKnown) {
+		computeObjectiveCoefficients();
+		objectiveCoefficientsKnown = true;
+	}
+
+	if (convergenceType < ZHANG_OLES) {
+		lastObjFunc = getObjectiveFunction(convergenceType);
+		trackedObjFunc = lastObjFunc;
+	} else { // ZHANG_OLES
+		saveXBeta();
+	}
+
 	while (!done) {
 
 		// Do a complete cycle
+		KernelProfile::Scope cycleProfile(modelSpecifics.getKernelProfile(), KernelProfile::CYCLE);
 		for(int index = 0; index < J; index++) {
 
 			if (!fixBeta[index]) {
 				double delta = ccdUpdateBeta(index);
 				delta = applyBounds(delta, index);
 				if (delta != 0.0) {
+					if (trackObjective) {
+						trackedObjFunc += getObjectiveChange(convergenceType, index, hBeta[index], delta);
+					}
 					sufficientStatisticsKnown = false;
 					updateSufficientStatistics(delta, index);
 				}
@@ -803,7 +1139,21 @@ void CyclicCoordinateDescent::findMode(
 			double conv;
 			bool illconditioned = false;
 			if (convergenceType < ZHANG_OLES) {
- 				double thisObjFunc = getObjectiveFunction(convergenceType);
+				bool exact = !trackObjective || (iteration % objectiveRefreshInterval == 0);
+				double thisObjFunc = exact ? getObjectiveFunction(convergenceType) : trackedObjFunc;
+				if (!exact && epsilon > 0) {
+					// Also refresh when the criterion, shrinking at its current rate, would come
+					// within the margin next cycle, so that cycle compares two exact objectives
+					const double trackedConv = computeConvergenceCriterion(thisObjFunc, lastObjFunc);
+					const double nextConv = (lastConv > 0.0) ? trackedConv * trackedConv / lastConv : trackedConv;
+					if (std::min(trackedConv, nextConv) < objectiveExactMargin * epsilon) {
+						thisObjFunc = getObjectiveFunction(convergenceType); // Decide without round-off drift
+						exact = true;
+					}
+				}
+				trackedObjFunc = thisObjFunc;
+				const bool comparable = trackExactly || (exact && lastExact);
+				lastExact = exact;
 				if (thisObjFunc != thisObjFunc) {
 				    std::ostringstream stream;
 					stream << "\nWarning: problem is ill-conditioned for this choice of\n"
@@ -815,6 +1165,10 @@ void CyclicCoordinateDescent::findMode(
 					illconditioned = true;
 				} else {
 					conv = computeConvergenceCriterion(thisObjFunc, lastObjFunc);
+					lastConv = conv;
+					if (!comparable && conv < epsilon) {
+						conv = epsilon; // Expanded previous objective; confirm on the next cycle
+					}
 				}
 				lastObjFunc = thisObjFunc;
 			} else { // ZHANG_OLES
@@ -823,12 +1177,12 @@ void CyclicCoordinateDescent::findMode(
 			} // Necessary to call getObjFxn or computeZO before getLogLikelihood,
 			  // since these copy over XBeta
 
-			double thisLogLikelihood = getLogLikelihood();
-			double thisLogPrior = getLogPrior();
-			double thisLogPost = thisLogLikelihood + thisLogPrior;
-
             std::ostringstream stream;
-			if (noiseLevel > QUIET) {
+			if (noiseLevel > QUIET) { // Full log-likelihood is only needed for reporting
+				double thisLogLikelihood = getLogLikelihood();
+				double thisLogPrior = getLogPrior();
+				double thisLogPost = thisLogLikelihood + thisLogPrior;
+
 			    stream << "\n";
 				printVector(&hBeta[0], J, stream);
 				stream << "\n";
@@ -901,6 +1255,113 @@ double CyclicCoordinateDescent::getHessianDiagonal(int index) {
 	return g_d2;
 }
 
+void CyclicCoordinateDescent::getLogLikelihoodGradient(double* gradient, double* hessianDiagonal,
+		int threads) {
+
+	checkAllLazyFlags();
+
+	if (!modelSpecifics.computeGradientAndHessianDiagonal(gradient, hessianDiagonal,
+			useCrossValidation, threads)) {
+		for (int j = 0; j < J; ++j) {
+			double g_d1, g_d2;
+			computeNumeratorForGradient(j);
+			computeGradientAndHessian(j, &g_d1, &g_d2);
+			gradient[j] = g_d1;
+			if (hessianDiagonal) {
+				hessianDiagonal[j] = g_d2;
+			}
+		}
+	}
+
+	// Kernels return derivatives of the negative log-likelihood
+	for (int j = 0; j < J; ++j) {
+		gradient[j] = -gradient[j];
+		if (hessianDiagonal) {
+			hessianDiagonal[j] = -hessianDiagonal[j];
+		}
+	}
+}
+
+std::vector<double> CyclicCoordinateDescent::getLogLikelihoods(const std::vector<double>& betas) {
+
+	if (J == 0 || betas.size() % J != 0) {
+		std::ostringstream stream;
+		stream << "Coefficient vectors must hold one value per covariate (" << J << "); received "
+			   << betas.size() << " values";
+		error->throwError(stream);
+	}
+
+	const int B = static_cast<int>(betas.size() / J);
+
+	checkAllLazyFlags();
+
+	std::vector<int> indices;
+	std::vector<double> deltas;
+	for (int j = 0; j < J; ++j) {
+		bool changed = false;
+		for (int b = 0; b < B; ++b) {
+			changed |= (betas[b * J + j] != hBeta[j]);
+		}
+		if (changed) {
+			indices.push_back(j);
+			for (int b = 0; b < B; ++b) {
+				deltas.push_back(betas[b * J + j] - hBeta[j]);
+			}
+		}
+	}
+
+	std::vector<double> logLikelihoods(B);
+	if (modelSpecifics.getLogLikelihoods(indices, deltas, B, logLikelihoods.data(), useCrossValidation)) {
+		likelihoodCount += B;
+		return logLikelihoods;
+	}
+
+	// Risk-set models recompute everything per point, then restore the current beta
+	std::vector<double> current(hBeta.begin(), hBeta.end());
+	for (int b = 0; b < B; ++b) {
+		setBeta(std::vector<double>(betas.begin() + b * J, betas.begin() + (b + 1) * J));
+		logLikelihoods[b] = getLogLikelihood();
+	}
+	setBeta(current);
+	return logLikelihoods;
+}
+
+std::vector<double> CyclicCoordinateDescent::getLogLikelihoodSweep(int index,
+		const std::vector<double>& values) {
+
+	if (index < 0 || index >= J) {
+		std::ostringstream stream;
+		stream << "Covariate index " << index << " is out of range for " << J << " covariates";
+		error->throwError(stream);
+	}
+
+	const int B = static_cast<int>(values.size());
+
+	checkAllLazyFlags();
+
+	std::vector<int> indices(1, index);
+	std::vector<double> deltas(B);
+	for (int b = 0; b < B; ++b) {
+		deltas[b] = values[b] - hBeta[index];
+	}
+
+	std::vector<double> logLikelihoods(B);
+	if (modelSpecifics.getLogLikelihoods(indices, deltas, B, logLikelihoods.data(), useCrossValidation)) {
+		likelihoodCount += B;
+		return logLikelihoods;
+	}
+
+	std::vector<double> current(hBeta.begin(), hBeta.end());
+	std::vector<double> beta(current);
+	for (int b = 0; b < B; ++b) {
+		beta[index] = values[b];
+		setBeta(beta);
+		logLikelihoods[b] = getLogLikelihood();
+	}
+	setBeta(current);
+	return logLikelihoods;
+}
+
 double CyclicCoordinateDescent::getAsymptoticVariance(int indexOne, int indexTwo) {
 	checkAllLazyFlags();
 	if (!fisherInformationKnown) {
@@ -1026,8 +1487,9 @@ double CyclicCoordinateDescent::ccdUpdateBeta(int index) {
 	    gh.first = 0.0;
 	    gh.second = 0.0;
 	}
+	lastGradientHessian = gh;
 
-	return jointPrior->getDelta(gh, hBeta, index);
+	return priorTable.getDelta(gh, hBeta, index);
 }
 
 template <class IteratorType>
@@ -1039,6 +1501,63 @@ void CyclicCoordinateDescent::axpy(double* y, const double alpha, const int inde
 	}
 }
 
+template <class IteratorType>
+double CyclicCoordinateDescent::dot(const double* y, const int index) {
+	IteratorType it(hXI, index);
+	double sum = 0.0;
+	for (; it; ++it) {
+		sum += y[it.index()] * it.value();
+	}
+	return sum;
+}
+
+// Change in the convergence objective from moving beta[index] by delta.  GRADIENT is linear in
+// xBeta.  The log-likelihood uses the derivatives of the negative log-likelihood that
+// ccdUpdateBeta() just computed at oldBeta: -(g * delta + h * delta^2 / 2).  The separable
+// log-prior change is exact.
+double CyclicCoordinateDescent::getObjectiveChange(int convergenceType, int index,
+		double oldBeta, double delta) {
+	if (convergenceType == GRADIENT) {
+		return delta * hObjectiveCoefficients[index];
+	}
+	double change = -delta * (lastGradientHessian.first + 0.5 * lastGradientHessian.second * delta);
+	if (convergenceType == LANGE) {
+		change += priorTable.getLogDensityChange(index, oldBeta, oldBeta + delta);
+	}
+	return change;
+}
+
+void CyclicCoordinateDescent::computeObjectiveCoefficients(void) {
+	DoubleVector yw(hY, hY + K);
+	if (useCrossValidation) {
+		for (int i = 0; i < K; ++i) {
+			yw[i] *= hWeights[i];
+		}
+	}
+
+	hObjectiveCoefficients.resize(J);
+	for (int j = 0; j < J; ++j) {
+		switch (hXI.getFormatType(j)) {
+		case INDICATOR:
+			hObjectiveCoefficients[j] = dot < IndicatorIterator > (yw.data(), j);
+			break;
+		case INTERCEPT:
+			hObjectiveCoefficients[j] = dot < InterceptIterator > (yw.data(), j);
+			break;
+		case DENSE:
+			hObjectiveCoefficients[j] = dot < DenseIterator > (yw.data(), j);
+			break;
+		case SPARSE:
+			hObjectiveCoefficients[j] = dot < SparseIterator > (yw.data(), j);
+			break;
+		default:
+			std::ostringstream stream;
+			stream << "Unknown vector type.";
+			error->throwError(stream);
+		}
+	}
+}
+
 void CyclicCoordinateDescent::axpyXBeta(const double beta, const int j) {
 	if (beta != static_cast<double>(0.0)) {
 		switch (hXI.getFormatType(j)) {
@@ -1065,10 +1584,13 @@ void CyclicCoordinateDescent::axpyXBeta(const double beta, const int j) {
 
 void CyclicCoordinateDescent::computeXBeta(void) {
 	// Note: X is current stored in (sparse) column-major format, which is
-	// inefficient for forming X\beta.
-	// TODO Make row-major version of X
+	// inefficient for forming X\beta; use the row-major mirror when enabled.
 
 	if (setBetaList.empty()) { // Update all
+		if (hXI.getUseRowMajorMirror()) {
+			hXI.computeXBetaByRow(hBeta.data(), hXBeta.data());
+			return;
+		}
 		// clear X\beta
 		zeroVector(hXBeta.data(), K);
 		for (int j = 0; j < J; ++j) {
@@ -13,6 +13,7 @@
 #include "ModelData.h"
 #include "engine/AbstractModelSpecifics.h"
 #include "priors/JointPrior.h"
+#include "priors/PriorTable.h"
 #include "io/ProgressLogger.h"
 
 #pragma GCC diagnostic push
@@ -86,6 +87,11 @@ public:
 
 	void getPredictiveEstimates(double* y, double* weights) const;
 
+	// Scores new data: computes X * beta in parallel row blocks (by row when X keeps a row-major
+	// mirror) and maps onto the response scale
+	void getPredictiveEstimates(const ModelData& X, const std::vector<double>& beta,
+			std::vector<double>& y, int nThreads) const;
+
 	double getLogPrior(void);
 
 	virtual double getObjectiveFunction(int convergenceType);
@@ -104,6 +110,23 @@ public:
 
 	double getHessianDiagonal(int index);
 
+	/**
+	 * Gradient of the log-likelihood at the current beta for all J covariates, and its Hessian
+	 * diagonal when hessianDiagonal is non-null, fused into one pass over the data split across
+	 * threads; both buffers hold J values.  Cox and tied conditional models use the per-column kernels.
+	 */
+	void getLogLikelihoodGradient(double* gradient, double* hessianDiagonal, int threads = 1);
+
+	/**
+	 * Log-likelihoods at B coefficient vectors, held back to back in betas (B x J), evaluated in
+	 * one pass over the support of the covariates that differ from the current beta.  The current
+	 * beta and all sufficient statistics are left unchanged.
+	 */
+	std::vector<double> getLogLikelihoods(const std::vector<double>& betas);
+
+	// Log-likelihoods along one coordinate, with beta[index] set to each of values in turn
+	std::vector<double> getLogLikelihoodSweep(int index, const std::vector<double>& values);
+
 	double getAsymptoticVariance(int i, int j);
 
 	double getAsymptoticPrecision(int i, int j);
@@ -112,6 +135,9 @@ public:
 
 	void update(const ModeFindingArguments& arguments);
 
+	AbridgeResult fitAbridge(const ModeFindingArguments& modeFinding,
+			const AbridgeArguments& abridge);
+
 	virtual void resetBeta(void);
 
 	// Setters
@@ -172,6 +198,12 @@ public:
 
 	loggers::ProgressLogger& getProgressLogger() const { return *logger; }
 
+	KernelProfile& getKernelProfile() { return modelSpecifics.getKernelProfile(); }
+
+	void setStratumThreads(int threads) { modelSpecifics.setStratumThreads(threads); }
+
+	void setIncrementalConvergence(bool incremental) { incrementalConvergence = incremental; }
+
 	loggers::ErrorHandler& getErrorHandler() const { return *error; }
 
 protected:
@@ -180,6 +212,7 @@ protected:
 
 	AbstractModelSpecifics& modelSpecifics;
 	priors::JointPriorPtr jointPrior;
+	priors::PriorTable priorTable;
 	const ModelData& hXI;
 
 	CyclicCoordinateDescent(const CyclicCoordinateDescent& copy);
@@ -198,6 +231,10 @@ protected:
 
 	void findMode(int maxIterations, int convergenceType, double epsilon);
 
+	void findModeByNewton(int maxIterations, int convergenceType, double epsilon, int maxDimension);
+
+	void prepareForModeFinding(int convergenceType);
+
 	template <typename Iterator>
 	void findMode(Iterator begin, Iterator end,
 		const int maxIterations, const int convergenceType, const double epsilon);
@@ -252,6 +289,13 @@ protected:
 
 	void axpyXBeta(const double beta, const int index);
 
+	template <class IteratorType>
+	double dot(const double* y, const int index);
+
+	void computeObjectiveCoefficients(void);
+
+	double getObjectiveChange(int convergenceType, int index, double oldBeta, double delta);
+
 	virtual void getDenominators(void);
 
 	double computeLogLikelihood(void);
@@ -334,9 +378,13 @@ protected:
 	bool varianceKnown;
 
 	bool validWeights;
+	bool objectiveCoefficientsKnown;
+	bool incrementalConvergence; // Track the convergence objective between full evaluations
 	bool useCrossValidation;
 	bool doLogisticRegression;
 	DoubleVector hWeights; // Make DoubleVector and delegate to ModelSpecifics
+	DoubleVector hObjectiveCoefficients; // J-vector, x_j' (y * w) for incremental GRADIENT criterion
+	priors::GradientHessian lastGradientHessian; // Log-likelihood derivatives from the latest ccdUpdateBeta()
 
 	int updateCount;
 	int likelihoodCount;
@@ -17,6 +17,7 @@
 #include <list>
 #include <functional>
 
+#include <boost/iterator/counting_iterator.hpp>
 #include <boost/iterator/permutation_iterator.hpp>
 #include <boost/iterator/transform_iterator.hpp>
 
@@ -32,11 +33,21 @@ ModelData::ModelData(
     loggers::ProgressLoggerPtr _log,
     loggers::ErrorHandlerPtr _error
     ) : modelType(_modelType), nPatients(0), nStrata(0), hasOffsetCovariate(false), hasInterceptCovariate(false), isFinalized(false),
-        lastStratumMap(0,0), sparseIndexer(*this), log(_log), error(_error), touchedY(true), touchedX(true) {
+        sparseIndexer(*this), log(_log), error(_error), touchedY(true), touchedX(true),
+        useRowMajor(false), rowMajorThreads(1), rowMajorStale(true) {
 	// Do nothing
 }
 
 
+int ModelData::getStratumIndex(const IdType stratumId) {
+	// Strata are numbered in order of first appearance, so rows need not arrive grouped
+	auto inserted = stratumIndexMap.insert(std::make_pair(stratumId, static_cast<int>(nPatients)));
+	if (inserted.second) {
+		++nPatients;
+	}
+	return inserted.first->second;
+}
+
 size_t ModelData::getColumnIndex(const IdType covariate) const {
     int index = getColumnIndexByName(covariate);
     if (index == -1) {
@@ -91,19 +102,7 @@ void ModelData::loadY(
 
 			// Begin code duplication
 			if (processStrata) {
-				IdType cInStratum = oStratumId[i];
-				if (nRows == 0) {
-					lastStratumMap.first = cInStratum;
-					lastStratumMap.second = 0;
-					nPatients++;
-				} else {
-					if (cInStratum != lastStratumMap.first) {
-						lastStratumMap.first = cInStratum;
-						lastStratumMap.second++;
-						nPatients++;
-					}
-				}
-				pid.push_back(lastStratumMap.second);
+				pid.push_back(getStratumIndex(oStratumId[i]));
 			}
 			++nRows;
 
@@ -226,6 +225,7 @@ int ModelData::loadMultipleX(
 	}
 
 	touchedX = true;
+	rowMajorStale = true;
 	return firstColumnIndex;
 }
 
@@ -352,6 +352,7 @@ int ModelData::loadX(
         }
     }
     touchedX = true;
+    rowMajorStale = true;
     return index;
 }
 
@@ -400,19 +401,7 @@ size_t ModelData::append(
     for (size_t i = 0; i < nOutcomes; ++i) {
 
     	// TODO Begin code duplication with 'loadY'
-        IdType cInStratum = oStratumId[i];
-        if (nRows == 0) {
-        	lastStratumMap.first = cInStratum;
-        	lastStratumMap.second = 0;
-        	nPatients++;
-        } else {
-        	if (cInStratum != lastStratumMap.first) {
-          	    lastStratumMap.first = cInStratum;
-            	lastStratumMap.second++;
-            	nPatients++;
-        	}
-        }
-        pid.push_back(lastStratumMap.second);
+        pid.push_back(getStratumIndex(oStratumId[i]));
         y.push_back(oY[i]);
         if (hasTime) {
             offs.push_back(oTime[i]);
@@ -464,6 +453,8 @@ size_t ModelData::append(
 }
 
 std::vector<double> ModelData::normalizeCovariates(const NormalizationType type) {
+    rowMajorStale = true;
+
     std::vector<double> normalizations;
     normalizations.reserve(getNumberOfColumns());
 
@@ -530,6 +521,20 @@ std::vector<double> ModelData::normalizeCovariates(const NormalizationType type)
     return std::move(normalizations);
 }
 
+bool ModelData::convertInterceptColumn() {
+    const size_t index = hasOffsetCovariate ? 1 : 0;
+    if (!hasInterceptCovariate || index >= getNumberOfColumns()) {
+        return false;
+    }
+    CompressedDataColumn& column = getColumn(index);
+    if (column.getFormatType() == INTERCEPT || !column.isConstantOne(nRows)) {
+        return false;
+    }
+    column.convertColumnToIntercept();
+    rowMajorStale = true;
+    return true;
+}
+
 int ModelData::getNumberOfPatients() const {
     if (nPatients == 0) {
         nPatients = getNumberOfStrata();
@@ -587,9 +592,14 @@ real* ModelData::getOffsetVector() { // TODO deprecated
 	return &offs[0];
 }
 
-// void ModelData::sortDataColumns(vector<int> sortedInds){
-// 	reindexVector(allColumns,sortedInds);
-// }
+void ModelData::sortDataColumns(vector<int> sortedInds){
+	DataColumnVector sorted;
+	sorted.reserve(allColumns.size());
+	for (size_t i = 0; i < allColumns.size(); ++i) {
+		sorted.push_back(std::move(allColumns[sortedInds[i]]));
+	}
+	allColumns.swap(sorted);
+}
 
 double ModelData::getSquaredNorm() const {
 
@@ -636,6 +646,532 @@ int ModelData::getNumberOfVariableColumns() const {
 	return dim;
 }
 
+void ModelData::setUseRowMajorMirror(bool use, int nThreads) {
+	useRowMajor = use;
+	rowMajorThreads = (nThreads == -1) ?
+		bsccs::thread::hardware_concurrency() : std::max(nThreads, 1);
+	if (!use) { // Release memory
+		std::lock_guard<mutex> lock(rowMajorMutex);
+		rowMajor = RowMajorMirror();
+		rowMajorStale = true;
+	}
+}
+
+const ModelData::RowMajorMirror& ModelData::getRowMajorMirror() const {
+	std::lock_guard<mutex> lock(rowMajorMutex);
+	// Columns may also be added through CompressedDataMatrix, so check the shape too
+	if (rowMajorStale
+			|| rowMajor.offsets.size() != getNumberOfRows() + 1
+			|| rowMajor.nColumns != getNumberOfColumns()) {
+		buildRowMajorMirror();
+		rowMajorStale = false;
+	}
+	return rowMajor;
+}
+
+namespace {
+
+// Visits (row, value) entries of column with row in [begin, end)
+template <typename Function>
+void forEachEntryInRows(const CompressedDataColumn& column, size_t begin, size_t end,
+		Function function) {
+	const FormatType formatType = column.getFormatType();
+	if (formatType == DENSE) {
+		const ColumnView<real> data = column.getDataView();
+		const size_t last = std::min(end, data.size());
+		for (size_t k = begin; k < last; ++k) {
+			if (data[k] != static_cast<real>(0)) {
+				function(k, data[k]);
+			}
+		}
+	} else if (formatType == SPARSE || formatType == INDICATOR) {
+		const ColumnView<int> rows = column.getColumnsView();
+		const auto first = std::lower_bound(rows.begin(), rows.end(), static_cast<int>(begin));
+		const auto last = std::lower_bound(first, rows.end(), static_cast<int>(end));
+		if (formatType == INDICATOR) {
+			for (auto it = first; it != last; ++it) {
+				function(*it, static_cast<real>(1));
+			}
+		} else {
+			const real* data = column.getData() + std::distance(rows.begin(), first);
+			for (auto it = first; it != last; ++it, ++data) {
+				function(*it, *data);
+			}
+		}
+	}
+}
+
+} // namespace
+
+void ModelData::buildRowMajorMirror() const {
+	const size_t nRows = getNumberOfRows();
+	const size_t nCols = getNumberOfColumns();
+
+	rowMajor.nColumns = nCols;
+	rowMajor.interceptColumns.clear();
+	for (size_t j = 0; j < nCols; ++j) {
+		if (getFormatType(j) == INTERCEPT) {
+			rowMajor.interceptColumns.push_back(j);
+		}
+	}
+
+	// Pass 1: count entries per row; row blocks are disjoint, so no synchronization is needed
+	std::vector<size_t>& offsets = rowMajor.offsets;
+	offsets.assign(nRows + 1, 0);
+	forEachRowBlock([this, nCols, &offsets](size_t begin, size_t end) {
+		for (size_t j = 0; j < nCols; ++j) {
+			forEachEntryInRows(getColumn(j), begin, end, [&offsets](size_t k, real /*value*/) {
+				++offsets[k + 1];
+			});
+		}
+	}, rowMajorThreads);
+	std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+	// Pass 2: fill in column order, so column indices are sorted within each row
+	rowMajor.columns.resize(offsets.back());
+	rowMajor.values.resize(offsets.back());
+	std::vector<size_t> position(offsets.begin(), offsets.end() - 1);
+	forEachRowBlock([this, nCols, &position](size_t begin, size_t end) {
+		for (size_t j = 0; j < nCols; ++j) {
+			forEachEntryInRows(getColumn(j), begin, end, [this, j, &position](size_t k, real value) {
+				const size_t i = position[k]++;
+				rowMajor.columns[i] = static_cast<int>(j);
+				rowMajor.values[i] = value;
+			});
+		}
+	}, rowMajorThreads);
+}
+
+void ModelData::computeXBetaByRow(const real* beta, real* xBeta) const {
+	getRowMajorMirror(); // Build outside the blocks
+	forEachRowBlock([this, beta, xBeta](size_t begin, size_t end) {
+		computeXBetaByRow(beta, xBeta, begin, end);
+	}, rowMajorThreads);
+}
+
+void ModelData::computeXBetaByRow(const real* beta, real* xBeta, size_t begin, size_t end) const {
+	const RowMajorMirror& mirror = getRowMajorMirror();
+
+	real intercept = static_cast<real>(0);
+	for (int j : mirror.interceptColumns) {
+		intercept += beta[j];
+	}
+
+	for (size_t k = begin; k < end; ++k) {
+		real sum = intercept;
+		for (size_t i = mirror.offsets[k]; i < mirror.offsets[k + 1]; ++i) {
+			sum += mirror.values[i] * beta[mirror.columns[i]];
+		}
+		xBeta[k] = sum;
+	}
+}
+
+namespace {
+
+template <typename Function>
+void forEachTask(size_t nTasks, size_t nThreads, Function function) {
+	if (nThreads <= 1 || nTasks <= 1) {
+		for (size_t task = 0; task < nTasks; ++task) {
+			function(static_cast<int>(task));
+		}
+	} else {
+		auto scheduler = TaskScheduler<boost::counting_iterator<int> >(
+			boost::make_counting_iterator(0),
+			boost::make_counting_iterator(static_cast<int>(nTasks)),
+			nThreads);
+		scheduler.execute(function);
+	}
+}
+
+// Stable merge sort: blocks are sorted concurrently, then neighbouring runs are merged
+// pairwise (left run first, so ties keep their original order)
+template <typename Compare>
+void parallelStableSort(std::vector<size_t>& order, Compare compare, size_t nThreads) {
+	const size_t n = order.size();
+	const size_t minPerBlock = 100000;
+	const size_t nBlocks = std::max(static_cast<size_t>(1),
+		std::min(nThreads, n / minPerBlock));
+
+	if (nBlocks == 1) {
+		std::stable_sort(order.begin(), order.end(), compare);
+		return;
+	}
+
+	std::vector<size_t> bounds(nBlocks + 1);
+	for (size_t b = 0; b <= nBlocks; ++b) {
+		bounds[b] = b * n / nBlocks;
+	}
+
+	forEachTask(nBlocks, nThreads, [&order, &bounds, &compare](int b) {
+		std::stable_sort(order.begin() + bounds[b], order.begin() + bounds[b + 1], compare);
+	});
+
+	std::vector<size_t> buffer(n);
+	for (size_t width = 1; width < nBlocks; width *= 2) {
+		const size_t nPairs = (nBlocks + 2 * width - 1) / (2 * width);
+		forEachTask(nPairs, nThreads, [&order, &buffer, &bounds, &compare, width, nBlocks](int pair) {
+			const size_t first = pair * 2 * width;
+			const size_t left = bounds[first];
+			const size_t middle = bounds[std::min(first + width, nBlocks)];
+			const size_t right = bounds[std::min(first + 2 * width, nBlocks)];
+			std::merge(order.begin() + left, order.begin() + middle,
+				order.begin() + middle, order.begin() + right,
+				buffer.begin() + left, compare);
+		});
+		order.swap(buffer);
+	}
+}
+
+template <typename T>
+void permuteVector(std::vector<T>& values, const std::vector<size_t>& order) {
+	if (values.size() != order.size()) {
+		return;
+	}
+	std::vector<T> permuted(values.size());
+	for (size_t i = 0; i < order.size(); ++i) {
+		permuted[i] = values[order[i]];
+	}
+	values.swap(permuted);
+}
+
+} // namespace
+
+const std::vector<size_t>& ModelData::sortRows(bool byTime, int nThreads) {
+	const size_t n = getNumberOfRows();
+	const size_t threads = std::max(1, nThreads);
+
+	const bool hasStrata = pid.size() == n;
+	const bool hasTime = byTime && offs.size() == n;
+
+	std::vector<size_t> order(n);
+	std::iota(order.begin(), order.end(), static_cast<size_t>(0));
+
+	parallelStableSort(order, [this, hasStrata, hasTime](size_t lhs, size_t rhs) {
+		if (hasStrata && pid[lhs] != pid[rhs]) {
+			return pid[lhs] < pid[rhs];
+		}
+		if (hasTime) {
+			if (offs[lhs] != offs[rhs]) {
+				return offs[lhs] > offs[rhs];
+			}
+			return y[lhs] < y[rhs];
+		}
+		return false;
+	}, threads);
+
+	std::vector<size_t> inverse(n);
+	for (size_t i = 0; i < n; ++i) {
+		inverse[order[i]] = i;
+	}
+
+	permuteVector(pid, order);
+	permuteVector(y, order);
+	permuteVector(z, order);
+	permuteVector(offs, order);
+	permuteVector(labels, order);
+	for (auto& entry : rowIdMap) {
+		entry.second = inverse[entry.second];
+	}
+
+	// Dense columns gather through order; sparse columns relabel rows through the inverse
+	forEachTask(getNumberOfColumns(), threads, [this, &order, &inverse](int j) {
+		CompressedDataColumn& column = getColumn(j);
+		const FormatType formatType = column.getFormatType();
+		if (formatType == DENSE) {
+			permuteVector(column.getDataVector(), order);
+		} else if (formatType == SPARSE || formatType == INDICATOR) {
+			std::vector<int>& rows = column.getColumnsVector();
+			const size_t nEntries = rows.size();
+			std::vector<size_t> entries(nEntries);
+			std::iota(entries.begin(), entries.end(), static_cast<size_t>(0));
+			std::sort(entries.begin(), entries.end(), [&rows, &inverse](size_t lhs, size_t rhs) {
+				return inverse[rows[lhs]] < inverse[rows[rhs]];
+			});
+			std::vector<int> newRows(nEntries);
+			for (size_t i = 0; i < nEntries; ++i) {
+				newRows[i] = static_cast<int>(inverse[rows[entries[i]]]);
+			}
+			rows.swap(newRows);
+			if (formatType == SPARSE) {
+				permuteVector(column.getDataVector(), entries);
+			}
+		}
+	});
+
+	// Compose with any earlier ordering so rowOrder always refers to the originally loaded rows
+	if (rowOrder.size() == n) {
+		permuteVector(rowOrder, order);
+	} else {
+		rowOrder.swap(order);
+	}
+
+	if (isPacked()) {
+		packColumns(); // Columns were copied out of the arena above
+	}
+	if (hasEncodedColumns()) {
+		encodeColumns(); // Row indices changed
+	}
+
+	touchedY = true;
+	touchedX = true;
+	rowMajorStale = true;
+	return rowOrder;
+}
+
+namespace {
+
+inline void hashCombine(size_t& seed, size_t value) {
+	seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+template <typename T>
+void gatherVector(std::vector<T>& values, const std::vector<size_t>& rows, size_t nRows) {
+	if (values.size() != nRows) {
+		return;
+	}
+	std::vector<T> gathered(rows.size());
+	for (size_t i = 0; i < rows.size(); ++i) {
+		gathered[i] = values[rows[i]];
+	}
+	values.swap(gathered);
+}
+
+} // namespace
+
+size_t ModelData::compressRowPatterns() {
+	if (modelType != ModelType::LOGISTIC && modelType != ModelType::POISSON &&
+			modelType != ModelType::CONDITIONAL_POISSON) {
+		std::ostringstream stream;
+		stream << "Row-pattern compression is only supported for logistic, Poisson and conditional Poisson models";
+		error->throwError(stream);
+	}
+	if (getIsCompressed()) {
+		std::ostringstream stream;
+		stream << "Rows are already compressed";
+		error->throwError(stream);
+	}
+
+	const size_t n = getNumberOfRows();
+	const bool byStratum = modelType == ModelType::CONDITIONAL_POISSON && pid.size() == n;
+	const bool hasTime = offs.size() == n;
+	const RowMajorMirror& mirror = getRowMajorMirror(); // Covariate values by row; offset column included
+
+	// Rows merge when their linear predictors (and strata) agree; outcomes and exposure times are summed
+	auto hashRow = [&](size_t k) {
+		size_t seed = 0;
+		if (byStratum) hashCombine(seed, std::hash<int>()(pid[k]));
+		for (size_t i = mirror.offsets[k]; i < mirror.offsets[k + 1]; ++i) {
+			hashCombine(seed, std::hash<int>()(mirror.columns[i]));
+			hashCombine(seed, std::hash<real>()(mirror.values[i]));
+		}
+		return seed;
+	};
+
+	auto sameRow = [&](size_t lhs, size_t rhs) {
+		if (byStratum && pid[lhs] != pid[rhs]) return false;
+		const size_t length = mirror.offsets[lhs + 1] - mirror.offsets[lhs];
+		if (length != mirror.offsets[rhs + 1] - mirror.offsets[rhs]) return false;
+		return std::equal(mirror.columns.begin() + mirror.offsets[lhs],
+				mirror.columns.begin() + mirror.offsets[lhs + 1],
+				mirror.columns.begin() + mirror.offsets[rhs]) &&
+			std::equal(mirror.values.begin() + mirror.offsets[lhs],
+				mirror.values.begin() + mirror.offsets[lhs + 1],
+				mirror.values.begin() + mirror.offsets[rhs]);
+	};
+
+	// Patterns are numbered by first occurrence, so stratum order is preserved
+	const size_t none = static_cast<size_t>(-1);
+	std::vector<size_t> pattern(n);
+	std::vector<size_t> representative;
+	std::vector<size_t> nextInBucket; // Chains patterns whose hashes collide
+	RealVector counts;
+	RealVector outcomeSums;
+	RealVector timeSums;
+	bsccs::unordered_map<size_t, size_t> buckets;
+
+	for (size_t k = 0; k < n; ++k) {
+		auto inserted = buckets.insert(std::make_pair(hashRow(k), representative.size()));
+		size_t p = inserted.first->second;
+		if (!inserted.second) {
+			size_t last = p;
+			while (p != none && !sameRow(representative[p], k)) {
+				last = p;
+				p = nextInBucket[p];
+			}
+			if (p == none) {
+				p = representative.size();
+				nextInBucket[last] = p;
+			}
+		}
+		if (p == representative.size()) {
+			representative.push_back(k);
+			nextInBucket.push_back(none);
+			counts.push_back(static_cast<real>(0));
+			outcomeSums.push_back(static_cast<real>(0));
+			timeSums.push_back(static_cast<real>(0));
+		}
+		counts[p] += static_cast<real>(1);
+		outcomeSums[p] += y[k];
+		if (hasTime) timeSums[p] += offs[k];
+		pattern[k] = p;
+	}
+
+	const size_t nPatterns = representative.size();
+	if (nPatterns == n) {
+		return n; // Nothing to collapse; leave the data untouched
+	}
+
+	if (pid.size() == n) {
+		if (byStratum) {
+			gatherVector(pid, representative, n);
+		} else {
+			pid.resize(nPatterns);
+			std::iota(pid.begin(), pid.end(), 0);
+		}
+	}
+	// Sums are stored as per-row means, so multiplicities act as exact frequency weights
+	uncompressedY.swap(y);
+	y.resize(nPatterns);
+	for (size_t p = 0; p < nPatterns; ++p) {
+		y[p] = outcomeSums[p] / counts[p];
+	}
+	if (hasTime) {
+		offs.resize(nPatterns);
+		for (size_t p = 0; p < nPatterns; ++p) {
+			offs[p] = timeSums[p] / counts[p];
+		}
+	}
+	gatherVector(z, representative, n);
+	if (labels.size() == n) {
+		uncompressedLabels.swap(labels);
+		labels.resize(nPatterns);
+		for (size_t p = 0; p < nPatterns; ++p) {
+			labels[p] = uncompressedLabels[representative[p]];
+		}
+	}
+	for (auto& entry : rowIdMap) {
+		entry.second = pattern[entry.second];
+	}
+
+	// Dense columns keep representative rows; sparse columns keep the entries of representative rows
+	for (size_t j = 0; j < getNumberOfColumns(); ++j) {
+		CompressedDataColumn& column = getColumn(j);
+		const FormatType formatType = column.getFormatType();
+		if (formatType == DENSE) {
+			gatherVector(column.getDataVector(), representative, n);
+		} else if (formatType == SPARSE || formatType == INDICATOR) {
+			std::vector<int>& rows = column.getColumnsVector();
+			size_t kept = 0;
+			for (size_t i = 0; i < rows.size(); ++i) {
+				const size_t k = rows[i];
+				if (representative[pattern[k]] == k) {
+					rows[kept] = static_cast<int>(pattern[k]);
+					if (formatType == SPARSE) {
+						column.getDataVector()[kept] = column.getDataVector()[i];
+					}
+					++kept;
+				}
+			}
+			rows.resize(kept);
+			if (formatType == SPARSE) {
+				column.getDataVector().resize(kept);
+			}
+		}
+	}
+
+	nRows = nPatterns;
+	nPatients = 0;
+	stratumIndexMap.clear();
+	nStrata = 0;
+	rowPattern.swap(pattern);
+	rowCounts.swap(counts);
+
+	if (isPacked()) {
+		packColumns(); // Columns were copied out of the arena above
+	}
+	if (hasEncodedColumns()) {
+		encodeColumns(); // Row indices changed
+	}
+
+	touchedY = true;
+	touchedX = true;
+	rowMajorStale = true;
+	return nPatterns;
+}
+
+namespace {
+
+// Visits the non-zero (row, value) entries of column in row order, including implicit intercept ones
+template <typename Function>
+void forEachNonZero(const CompressedDataColumn& column, size_t nRows, Function function) {
+	if (column.getFormatType() == INTERCEPT) {
+		for (size_t k = 0; k < nRows; ++k) {
+			function(k, static_cast<real>(1));
+		}
+	} else {
+		forEachEntryInRows(column, 0, nRows, [&function](size_t k, real value) {
+			if (value != static_cast<real>(0)) {
+				function(k, value);
+			}
+		});
+	}
+}
+
+} // namespace
+
+void ModelData::findDuplicateColumns(std::vector<int>& duplicateOf, std::vector<bool>& allZero,
+		int nThreads) const {
+	const size_t nCols = getNumberOfColumns();
+	const size_t nRows = getNumberOfRows();
+	const size_t first = hasOffsetCovariate ? 1 : 0;
+
+	std::vector<size_t> hashes(nCols, 0);
+	std::vector<size_t> entries(nCols, 0);
+	forEachTask(nCols - first, std::max(1, nThreads), [this, first, nRows, &hashes, &entries](int task) {
+		const size_t j = first + task;
+		size_t seed = 0;
+		size_t count = 0;
+		forEachNonZero(getColumn(j), nRows, [&seed, &count](size_t k, real value) {
+			hashCombine(seed, std::hash<size_t>()(k));
+			hashCombine(seed, std::hash<real>()(value));
+			++count;
+		});
+		hashes[j] = seed;
+		entries[j] = count;
+	});
+
+	auto collect = [this, nRows](size_t j) {
+		std::vector<std::pair<size_t, real> > values;
+		forEachNonZero(getColumn(j), nRows, [&values](size_t k, real value) {
+			values.push_back(std::make_pair(k, value));
+		});
+		return values;
+	};
+
+	duplicateOf.resize(nCols);
+	std::iota(duplicateOf.begin(), duplicateOf.end(), 0);
+	allZero.assign(nCols, false);
+
+	// Only columns with equal hashes and entry counts are compared entry-by-entry
+	bsccs::unordered_map<size_t, std::vector<int> > buckets;
+	for (size_t j = first; j < nCols; ++j) {
+		if (entries[j] == 0) {
+			allZero[j] = true;
+			continue;
+		}
+		std::vector<int>& bucket = buckets[hashes[j]];
+		for (int candidate : bucket) {
+			if (entries[candidate] == entries[j] && collect(candidate) == collect(j)) {
+				duplicateOf[j] = candidate;
+				break;
+			}
+		}
+		if (duplicateOf[j] == static_cast<int>(j)) {
+			bucket.push_back(static_cast<int>(j));
+		}
+	}
+}
+
 const string ModelData::missing = "NA";
 
 } // namespace
@@ -22,7 +22,10 @@
 // using std::vector;
 // using std::stringstream;
 
+#include <boost/iterator/counting_iterator.hpp>
+
 #include "CompressedDataMatrix.h"
+#include "Thread.h"
 #include "io/ProgressLogger.h"
 #include "io/SparseIndexer.h"
 
@@ -72,6 +75,7 @@ public:
 		, sparseIndexer(*this)
 		, log(_log), error(_error)
 		, touchedY(true), touchedX(true)
+		, useRowMajor(false), rowMajorThreads(1), rowMajorStale(true)
 		{
 
 	}
@@ -154,9 +158,9 @@ public:
 		return pid;
 	}
 
-//	const std::vector<int>& getNEventsVectorRef() const {
-//		return nevents;
-//	}
+	const std::vector<int>& getNEventsVectorRef() const {
+		return nevents;
+	}
 
 	bool getHasOffsetCovariate() const {
 		return hasOffsetCovariate;
@@ -206,6 +210,43 @@ public:
 
     std::vector<double> normalizeCovariates(const NormalizationType type);
 
+    // Switches the column flagged as the intercept to zero-storage INTERCEPT format if it is
+    // identically one; other constant columns are user covariates and keep their format.
+    // Returns true if the column was converted
+    bool convertInterceptColumn();
+
+    // Stably reorders rows by (stratum, -time, y) when byTime, else by stratum alone, permuting
+    // outcomes and all columns in place; new row i is original row getRowOrder()[i]
+    const std::vector<size_t>& sortRows(bool byTime, int nThreads = 1);
+
+    const std::vector<size_t>& getRowOrder() const { return rowOrder; }
+
+    // Collapses rows that share covariates (including any offset covariate) and, for conditional models,
+    // stratum into one row carrying the number of rows it stands for and the mean of their outcomes and
+    // times; original row i becomes row getRowPattern()[i].
+    // Supported for logistic, Poisson and conditional Poisson models; returns the number of rows kept
+    size_t compressRowPatterns();
+
+    bool getIsCompressed() const { return !rowCounts.empty(); }
+
+    const std::vector<size_t>& getRowPattern() const { return rowPattern; }
+
+    // Multiplicity of each row; empty unless compressRowPatterns() collapsed at least two rows
+    const RealVector& getRowCountsRef() const { return rowCounts; }
+
+    // Outcomes of the original rows, for likelihood terms that are not linear in y; empty unless compressed
+    const RealVector& getUncompressedYVectorRef() const { return uncompressedY; }
+
+    const std::string& getUncompressedRowLabel(size_t i) const {
+        return (i < uncompressedLabels.size()) ? uncompressedLabels[i] : missing;
+    }
+
+    // Hashes columns concurrently to find exact duplicates, whatever their storage format;
+    // duplicateOf[j] is the first column with identical entries (j itself if none) and allZero[j]
+    // flags columns without non-zero entries.  An offset column is never matched
+    void findDuplicateColumns(std::vector<int>& duplicateOf, std::vector<bool>& allZero,
+            int nThreads = 1) const;
+
 	const std::string& getRowLabel(size_t i) const {
 		if (i >= labels.size()) {
 			return missing;
@@ -216,6 +257,39 @@ public:
 
 	void clean() const { touchedY = false; touchedX = false; }
 
+	/**
+	 * Compressed sparse row (CSR) mirror of X for row-oriented kernels.  INTERCEPT columns are
+	 * not stored per-row; they are listed once in interceptColumns.
+	 */
+	struct RowMajorMirror {
+		std::vector<size_t> offsets; // nRows + 1
+		std::vector<int> columns;
+		std::vector<real> values;
+		std::vector<int> interceptColumns;
+		size_t nColumns = 0;
+	};
+
+	void setUseRowMajorMirror(bool use, int nThreads = 1);
+
+	bool getUseRowMajorMirror() const { return useRowMajor; }
+
+	// Lazily (re-)builds the mirror if X changed since the last request
+	const RowMajorMirror& getRowMajorMirror() const;
+
+	// Computes xBeta = X * beta by row from the mirror
+	void computeXBetaByRow(const real* beta, real* xBeta) const;
+
+	// Computes xBeta = X * beta by row from the mirror for rows in [begin, end)
+	void computeXBetaByRow(const real* beta, real* xBeta, size_t begin, size_t end) const;
+
+	/**
+	 * Calls function(begin, end) once per contiguous block of rows, concurrently over up to
+	 * nThreads threads (-1 for all cores).  Blocks are disjoint and hold at least 10000 rows,
+	 * so small data runs in the calling thread.
+	 */
+	template <typename Function>
+	void forEachRowBlock(Function function, int nThreads) const;
+
 	const bool getTouchedY() const { return touchedY; }
 
 	const bool getTouchedX() const { return touchedX; }
@@ -231,6 +305,7 @@ public:
 	template <class FormatType, class MissingPolicy> friend class BaseInputReader;
 	template <class ImputationPolicy> friend class BBRInputReader;
 	template <class ImputationPolicy> friend class CSVInputReader;
+	friend class ImputeVariables;
 
 protected:
     ModelType modelType;
@@ -259,7 +334,10 @@ private:
 
 	static const std::string missing;
 
-    std::pair<IdType,int> lastStratumMap;
+    int getStratumIndex(const IdType stratumId);
+
+    typedef bsccs::unordered_map<IdType,int> StratumIndexMap;
+    StratumIndexMap stratumIndexMap;
 
     SparseIndexer sparseIndexer;
 
@@ -273,9 +351,55 @@ protected:
 
     mutable bool touchedY;
     mutable bool touchedX;
+
+private:
+    void buildRowMajorMirror() const;
+
+    bool useRowMajor;
+    int rowMajorThreads;
+    mutable bool rowMajorStale;
+    mutable RowMajorMirror rowMajor;
+    mutable mutex rowMajorMutex;
+
+    std::vector<size_t> rowOrder; // Empty until sortRows()
+
+    std::vector<size_t> rowPattern; // Empty until compressRowPatterns()
+    RealVector rowCounts;
+    RealVector uncompressedY;
+    std::vector<std::string> uncompressedLabels;
 };
 
 
+template <typename Function>
+void ModelData::forEachRowBlock(Function function, int nThreads) const {
+	if (nThreads == -1) {
+		nThreads = bsccs::thread::hardware_concurrency();
+	}
+	const size_t nRows = getNumberOfRows();
+	const size_t minRowsPerBlock = 10000;
+	const size_t nBlocks = std::max(static_cast<size_t>(1),
+		std::min(static_cast<size_t>(std::max(nThreads, 1)), nRows / minRowsPerBlock));
+	const size_t blockSize = nRows / nBlocks + (nRows % nBlocks != 0);
+
+	auto oneBlock = [&function, nRows, blockSize](int block) {
+		const size_t begin = block * blockSize;
+		const size_t end = std::min(begin + blockSize, nRows);
+		if (begin < end) {
+			function(begin, end);
+		}
+	};
+
+	if (nBlocks == 1) {
+		oneBlock(0);
+	} else {
+		auto scheduler = TaskScheduler<boost::counting_iterator<int> >(
+			boost::make_counting_iterator(0),
+			boost::make_counting_iterator(static_cast<int>(nBlocks)),
+			nBlocks);
+		scheduler.execute(oneBlock);
+	}
+}
+
 template <typename Itr>
 auto median(Itr begin, Itr end) -> typename Itr::value_type {
     const auto size = std::distance(begin, end);
@@ -0,0 +1,141 @@
+/*
+ * RowIndexEncoding.cpp
+ */
+
+#include "RowIndexEncoding.h"
+
+namespace bsccs {
+
+namespace {
+
+unsigned int bitWidth(uint32_t value) {
+	unsigned int width = 0;
+	while (value != 0) {
+		value >>= 1;
+		++width;
+	}
+	return width;
+}
+
+// Bit width of the (delta - 1) values in rows[first, first + length)
+unsigned int blockWidth(const int* rows, size_t first, size_t length) {
+	uint32_t maxGap = 0;
+	for (size_t i = first + 1; i < first + length; ++i) {
+		const uint32_t gap = static_cast<uint32_t>(rows[i] - rows[i - 1] - 1);
+		if (gap > maxGap) {
+			maxGap = gap;
+		}
+	}
+	return bitWidth(maxGap);
+}
+
+size_t wordsFor(size_t bits) {
+	return (bits + 63) / 64;
+}
+
+} // namespace
+
+void RowIndexEncoding::encode(const int* rows, size_t n, size_t nRows) {
+	type = PLAIN;
+	nEntries = 0;
+	words.clear();
+	blockFirst.clear();
+	blockWord.clear();
+	blockShift.clear();
+
+	if (n == 0) {
+		return;
+	}
+
+	const size_t nBlocks = (n + BLOCK_SIZE - 1) / BLOCK_SIZE;
+
+	size_t packedWords = 0;
+	for (size_t block = 0; block < nBlocks; ++block) {
+		const size_t first = block * BLOCK_SIZE;
+		const size_t length = (n - first < BLOCK_SIZE) ? n - first : BLOCK_SIZE;
+		packedWords += wordsFor((length - 1) * blockWidth(rows, first, length));
+	}
+
+	const size_t plainBytes = n * sizeof(int);
+	const size_t packedBytes = packedWords * sizeof(uint64_t)
+		+ nBlocks * (sizeof(int) + sizeof(uint32_t) + sizeof(uint8_t));
+	const bool bitmapFits = static_cast<size_t>(rows[n - 1]) < nRows;
+	const size_t bitmapBytes = bitmapFits ?
+		wordsFor(nRows) * sizeof(uint64_t) + nBlocks * (sizeof(uint32_t) + sizeof(uint8_t)) :
+		plainBytes;
+
+	const size_t bestBytes = (packedBytes < bitmapBytes) ? packedBytes : bitmapBytes;
+	if (2 * bestBytes > plainBytes) {
+		return;
+	}
+
+	nEntries = n;
+	if (packedBytes <= bitmapBytes) {
+		encodePacked(rows, n);
+	} else {
+		encodeBitmap(rows, n, nRows);
+	}
+}
+
+void RowIndexEncoding::encodePacked(const int* rows, size_t n) {
+	type = PACKED;
+	const size_t nBlocks = getNumberOfBlocks();
+	blockFirst.resize(nBlocks);
+	blockWord.resize(nBlocks);
+	blockShift.resize(nBlocks);
+
+	for (size_t block = 0; block < nBlocks; ++block) {
+		const size_t first = block * BLOCK_SIZE;
+		const size_t length = (n - first < BLOCK_SIZE) ? n - first : BLOCK_SIZE;
+		const unsigned int width = blockWidth(rows, first, length);
+
+		blockFirst[block] = rows[first];
+		blockWord[block] = static_cast<uint32_t>(words.size());
+		blockShift[block] = static_cast<uint8_t>(width);
+
+		const size_t offset = words.size();
+		words.resize(offset + wordsFor((length - 1) * width), 0);
+		for (size_t i = 1; i < length; ++i) {
+			const uint64_t gap = static_cast<uint32_t>(rows[first + i] - rows[first + i - 1] - 1);
+			const size_t position = (i - 1) * width;
+			const size_t word = offset + (position >> 6);
+			const unsigned int shift = position & 63;
+			words[word] |= gap << shift;
+			if (shift + width > 64) {
+				words[word + 1] |= gap >> (64 - shift);
+			}
+		}
+	}
+}
+
+void RowIndexEncoding::encodeBitmap(const int* rows, size_t n, size_t nRows) {
+	type = BITMAP;
+	const size_t nBlocks = getNumberOfBlocks();
+	blockWord.resize(nBlocks);
+	blockShift.resize(nBlocks);
+
+	words.assign(wordsFor(nRows), 0);
+	for (size_t i = 0; i < n; ++i) {
+		const size_t row = static_cast<size_t>(rows[i]);
+		words[row >> 6] |= static_cast<uint64_t>(1) << (row & 63);
+		if (i % BLOCK_SIZE == 0) {
+			blockWord[i / BLOCK_SIZE] = static_cast<uint32_t>(row >> 6);
+			blockShift[i / BLOCK_SIZE] = static_cast<uint8_t>(row & 63);
+		}
+	}
+}
+
+size_t RowIndexEncoding::getBytes() const {
+	return words.size() * sizeof(uint64_t) + blockFirst.size() * sizeof(int)
+		+ blockWord.size() * sizeof(uint32_t) + blockShift.size() * sizeof(uint8_t);
+}
+
+const char* RowIndexEncoding::getTypeString() const {
+	switch (type) {
+		case PACKED : return "packed";
+		case BITMAP : return "bitmap";
+		default : return "plain";
+	}
+}
+
+} // namespace bsccs
@@ -0,0 +1,126 @@
+/*
+ * RowIndexEncoding.h
+ *
+ * Compact encodings of the sorted row indices of a SPARSE or INDICATOR column.  Indices
+ * are split into blocks of BLOCK_SIZE entries that decode independently into a plain
+ * int buffer, so kernels can stream a column block-by-block through their gathers.
+ *
+ *   PACKED: first row of each block, then (delta - 1) bit-packed at the block's width
+ *   BITMAP: one bit per row of the matrix, for high-density indicator columns
+ */
+
+#ifndef ROWINDEXENCODING_H_
+#define ROWINDEXENCODING_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace bsccs {
+
+class RowIndexEncoding {
+public:
+
+	enum Type {
+		PLAIN, PACKED, BITMAP
+	};
+
+	static const size_t BLOCK_SIZE = 128;
+
+	RowIndexEncoding() : type(PLAIN), nEntries(0) { }
+
+	/**
+	 * Chooses the smallest encoding for rows[0, n); stays PLAIN (and holds nothing)
+	 * unless the encoding is at most half the size of the plain indices.
+	 */
+	void encode(const int* rows, size_t n, size_t nRows);
+
+	Type getType() const {
+		return type;
+	}
+
+	size_t getNumberOfEntries() const {
+		return nEntries;
+	}
+
+	size_t getNumberOfBlocks() const {
+		return (nEntries + BLOCK_SIZE - 1) / BLOCK_SIZE;
+	}
+
+	size_t getBytes() const;
+
+	const char* getTypeString() const;
+
+	// Decodes block into rows (at least BLOCK_SIZE long) and returns its length
+	size_t decodeBlock(size_t block, int* rows) const {
+		const size_t first = block * BLOCK_SIZE;
+		const size_t length = (nEntries - first < BLOCK_SIZE) ? nEntries - first : BLOCK_SIZE;
+		if (type == PACKED) {
+			decodePacked(block, length, rows);
+		} else {
+			decodeBitmap(block, length, rows);
+		}
+		return length;
+	}
+
+private:
+
+	void decodePacked(size_t block, size_t length, int* rows) const {
+		const uint64_t* w = words.data() + blockWord[block];
+		const unsigned int width = blockShift[block];
+		const uint64_t mask = (static_cast<uint64_t>(1) << width) - 1;
+		int row = blockFirst[block];
+		rows[0] = row;
+		for (size_t i = 1; i < length; ++i) {
+			const size_t position = (i - 1) * width;
+			const size_t word = position >> 6;
+			const unsigned int shift = position & 63;
+			uint64_t value = w[word] >> shift;
+			if (shift + width > 64) {
+				value |= w[word + 1] << (64 - shift);
+			}
+			row += static_cast<int>(value & mask) + 1;
+			rows[i] = row;
+		}
+	}
+
+	void decodeBitmap(size_t block, size_t length, int* rows) const {
+		size_t word = blockWord[block];
+		uint64_t bits = words[word] & (~static_cast<uint64_t>(0) << blockShift[block]);
+		for (size_t i = 0; i < length; ++i) {
+			while (bits == 0) {
+				bits = words[++word];
+			}
+			rows[i] = static_cast<int>(word * 64 + countTrailingZeros(bits));
+			bits &= bits - 1;
+		}
+	}
+
+	static unsigned int countTrailingZeros(uint64_t x) {
+#if defined(__GNUC__)
+		return __builtin_ctzll(x);
+#else
+		unsigned int count = 0;
+		while ((x & 1) == 0) {
+			x >>= 1;
+			++count;
+		}
+		return count;
+#endif
+	}
+
+	void encodePacked(const int* rows, size_t n);
+
+	void encodeBitmap(const int* rows, size_t n, size_t nRows);
+
+	Type type;
+	size_t nEntries;
+	std::vector<uint64_t> words;
+	std::vector<int> blockFirst;       // PACKED only
+	std::vector<uint32_t> blockWord;   // Offset into words of each block
+	std::vector<uint8_t> blockShift;   // PACKED: bit width; BITMAP: first bit in blockWord
+};
+
+} // namespace bsccs
+
+#endif /* ROWINDEXENCODING_H_ */
@@ -146,6 +146,13 @@ enum class SelectorType {
 	SIZE_OF_ENUM // Keep at end
 };
 
+enum class AlgorithmType {
+	AUTO,
+	CCD,
+	NEWTON,
+	SIZE_OF_ENUM // Keep at end
+};
+
 enum class NormalizationType {
     STANDARD_DEVIATION,
     MAX,
@@ -99,6 +99,7 @@ void AbstractCrossValidationDriver::drive(
 
 	// Clean up
 	for (int i = 1; i < nThreads; ++i) {
+		ccd.getKernelProfile().merge(ccdPool[i]->getKernelProfile());
 		delete ccdPool[i];
 		delete selectorPool[i];
 	}
@@ -158,6 +159,8 @@ double AbstractCrossValidationDriver::doCrossValidationStep(
 				auto ccdTask = ccdPool[uniqueId];
 				auto selectorTask = selectorPool[uniqueId];
 
+				KernelProfile::Scope profile(ccdTask->getKernelProfile(), KernelProfile::CROSS_VALIDATION_FOLD);
+
 				// Bring selector up-to-date
 				if (task == 0 || nThreads > 1) {
     				selectorTask->reseed();
@@ -15,6 +15,7 @@
 
 #include "BootstrapDriver.h"
 #include "AbstractSelector.h"
+#include "io/BinaryOutputStream.h"
 
 namespace bsccs {
 
@@ -78,6 +79,11 @@ void BootstrapDriver::logResults(const CCDArguments& arguments) {
 
 void BootstrapDriver::logResults(const CCDArguments& arguments, std::vector<double>& savedBeta, std::string conditionId) {
 
+	if (arguments.binaryOutput) {
+		logBinaryResults(arguments, savedBeta, conditionId);
+		return;
+	}
+
 	ofstream outLog(arguments.outFileName.c_str());
 	if (!outLog) {
         std::ostringstream stream;        
@@ -101,28 +107,8 @@ void BootstrapDriver::logResults(const CCDArguments& arguments, std::vector<doub
 			copy(estimates[j]->begin(), estimates[j]->end(), output);
 			outLog << endl;
 		} else {
-			real mean = 0.0;
-			real var = 0.0;
-			real prob0 = 0.0;
-			for (rvector::iterator it = estimates[j]->begin(); it != estimates[j]->end(); ++it) {
-				mean += *it;
-				var += *it * *it;
-				if (*it == 0.0) {
-					prob0 += 1.0;
-				}
-			}
-
-			real size = static_cast<real>(estimates[j]->size());
-			mean /= size;
-			var = (var / size) - (mean * mean);
-			prob0 /= size;
-
-			sort(estimates[j]->begin(), estimates[j]->end());
-			int offsetLower = static_cast<int>(size * 0.025);
-			int offsetUpper = static_cast<int>(size * 0.975);
-
-			real lower = *(estimates[j]->begin() + offsetLower);
-			real upper = *(estimates[j]->begin() + offsetUpper);
+			real mean, var, lower, upper, prob0;
+			summarize(j, mean, var, lower, upper, prob0);
 
 			outLog << savedBeta[j] << sep;
 			outLog << std::sqrt(var) << sep << mean << sep << lower << sep << upper << sep << prob0 << endl;
@@ -131,4 +117,69 @@ void BootstrapDriver::logResults(const CCDArguments& arguments, std::vector<doub
 	outLog.close();
 }
 
+void BootstrapDriver::logBinaryResults(const CCDArguments& arguments, std::vector<double>& savedBeta, std::string conditionId) {
+
+	OutputHelper::BinaryStream out;
+	out.open(arguments.outFileName.c_str());
+	if (!out.is_open()) {
+        std::ostringstream stream;
+		stream << "Unable to open log file: " << arguments.outFileName;
+		error->throwError(stream);
+	}
+
+	out.addMetaKey("condition_concept_id").addMetaValue(conditionId);
+
+	if (arguments.reportRawEstimates) {
+		// Long format: one row per covariate and replicate
+		out.addHeader("drug_concept_id", OutputHelper::INT64)
+			.addHeader("replicate", OutputHelper::INT64)
+			.addHeader("estimate", OutputHelper::FLOAT64).addEndl();
+		for (int j = 0; j < J; ++j) {
+			const IdType label = modelData->getColumn(j).getNumericalLabel();
+			for (size_t r = 0; r < estimates[j]->size(); ++r) {
+				out.addValue(label).addValue(r).addValue((*estimates[j])[r]).addEndl();
+			}
+		}
+		out.endTable("bootstrap_estimates");
+	} else {
+		out.addHeader("drug_concept_id", OutputHelper::INT64).addHeader("score")
+			.addHeader("standard_error").addHeader("bs_mean").addHeader("bs_lower")
+			.addHeader("bs_upper").addHeader("bs_prob0").addEndl();
+		for (int j = 0; j < J; ++j) {
+			real mean, var, lower, upper, prob0;
+			summarize(j, mean, var, lower, upper, prob0);
+
+			out.addValue(modelData->getColumn(j).getNumericalLabel()).addValue(savedBeta[j])
+				.addValue(std::sqrt(var)).addValue(mean).addValue(lower).addValue(upper)
+				.addValue(prob0).addEndl();
+		}
+		out.endTable("bootstrap");
+	}
+}
+
+void BootstrapDriver::summarize(int j, real& mean, real& var, real& lower, real& upper, real& prob0) {
+	mean = 0.0;
+	var = 0.0;
+	prob0 = 0.0;
+	for (rvector::iterator it = estimates[j]->begin(); it != estimates[j]->end(); ++it) {
+		mean += *it;
+		var += *it * *it;
+		if (*it == 0.0) {
+			prob0 += 1.0;
+		}
+	}
+
+	real size = static_cast<real>(estimates[j]->size());
+	mean /= size;
+	var = (var / size) - (mean * mean);
+	prob0 /= size;
+
+	sort(estimates[j]->begin(), estimates[j]->end());
+	int offsetLower = static_cast<int>(size * 0.025);
+	int offsetUpper = static_cast<int>(size * 0.975);
+
+	lower = *(estimates[j]->begin() + offsetLower);
+	upper = *(estimates[j]->begin() + offsetUpper);
+}
+
 } // namespace
@@ -40,6 +40,10 @@ public:
 	void logResults(const CCDArguments& arguments, std::vector<double>& savedBeta, std::string conditionId);
 
 private:
+	void logBinaryResults(const CCDArguments& arguments, std::vector<double>& savedBeta, std::string conditionId);
+
+	void summarize(int j, real& mean, real& var, real& lower, real& upper, real& prob0);
+
 	const int replicates;
 	ModelData* modelData;
 	const int J;
@@ -51,35 +51,36 @@ namespace bsccs {
 //	return model;
 //}
 
-AbstractModelSpecifics* AbstractModelSpecifics::factory(const ModelType modelType, const ModelData& modelData) {
+template <typename StorageType>
+AbstractModelSpecifics* makeModelSpecifics(const ModelType modelType, const ModelData& modelData) {
 	AbstractModelSpecifics* model = nullptr;
  	switch (modelType) {
  		case ModelType::SELF_CONTROLLED_MODEL :
- 			model =  new ModelSpecifics<SelfControlledCaseSeries<real>,real>(modelData);
+ 			model =  new ModelSpecifics<SelfControlledCaseSeries<StorageType>,StorageType>(modelData);
  			break;
  		case ModelType::CONDITIONAL_LOGISTIC :
- 			model =  new ModelSpecifics<ConditionalLogisticRegression<real>,real>(modelData);
+ 			model =  new ModelSpecifics<ConditionalLogisticRegression<StorageType>,StorageType>(modelData);
  			break;
  		case ModelType::TIED_CONDITIONAL_LOGISTIC :
- 			model =  new ModelSpecifics<TiedConditionalLogisticRegression<real>,real>(modelData);
+ 			model =  new ModelSpecifics<TiedConditionalLogisticRegression<StorageType>,StorageType>(modelData);
  			break;
  		case ModelType::LOGISTIC :
- 			model = new ModelSpecifics<LogisticRegression<real>,real>(modelData);
+ 			model = new ModelSpecifics<LogisticRegression<StorageType>,StorageType>(modelData);
  			break;
  		case ModelType::NORMAL :
- 			model = new ModelSpecifics<LeastSquares<real>,real>(modelData);
+ 			model = new ModelSpecifics<LeastSquares<StorageType>,StorageType>(modelData);
  			break;
  		case ModelType::POISSON :
- 			model = new ModelSpecifics<PoissonRegression<real>,real>(modelData);
+ 			model = new ModelSpecifics<PoissonRegression<StorageType>,StorageType>(modelData);
  			break;
 		case ModelType::CONDITIONAL_POISSON :
- 			model = new ModelSpecifics<ConditionalPoissonRegression<real>,real>(modelData);
+ 			model = new ModelSpecifics<ConditionalPoissonRegression<StorageType>,StorageType>(modelData);
  			break;
  		case ModelType::COX_RAW :
- 			model = new ModelSpecifics<CoxProportionalHazards<real>,real>(modelData);
+ 			model = new ModelSpecifics<CoxProportionalHazards<StorageType>,StorageType>(modelData);
  			break;
  		case ModelType::COX :
- 			model = new ModelSpecifics<BreslowTiedCoxProportionalHazards<real>,real>(modelData);
+ 			model = new ModelSpecifics<BreslowTiedCoxProportionalHazards<StorageType>,StorageType>(modelData);
  			break;
  		default:
  			break;
@@ -87,6 +88,14 @@ AbstractModelSpecifics* AbstractModelSpecifics::factory(const ModelType modelTyp
 	return model;
 }
 
+AbstractModelSpecifics* AbstractModelSpecifics::factory(const ModelType modelType, const ModelData& modelData,
+		const StoragePrecision precision) {
+	if (precision == StoragePrecision::SINGLE) {
+		return makeModelSpecifics<float>(modelType, modelData);
+	}
+	return makeModelSpecifics<real>(modelType, modelData);
+}
+
 //AbstractModelSpecifics::AbstractModelSpecifics(
 //		const std::vector<real>& y,
 //		const std::vector<real>& z) : hY(y), hZ(z) {
@@ -102,9 +111,11 @@ AbstractModelSpecifics::AbstractModelSpecifics(const ModelData& input)
 	  hY(input.getYVectorRef()),
 // 	  hOffs(const_cast<real*>(input.getTimeVectorRef().data())),
 	  hOffs(input.getTimeVectorRef()),
+	  hRowCounts(input.getRowCountsRef()),
 // 	  hPid(const_cast<int*>(input.getPidVectorRef().data()))
 // 	  hPid(input.getPidVectorRef())
-      hPidOriginal(input.getPidVectorRef()), hPid(const_cast<int*>(hPidOriginal.data()))
+      hPidOriginal(input.getPidVectorRef()), hPid(const_cast<int*>(hPidOriginal.data())),
+	  sparseIndicesShared(false)
 	  {
 	// Do nothing
 }
@@ -229,7 +240,6 @@ void AbstractModelSpecifics::initialize(
 	N = iN;
 	K = iK;
 	J = iJ;
-	offsExpXBeta.resize(K);
 	hXBeta.resize(K); // PT OF DIFFERENCE
 
 	if (allocateXjY()) {
@@ -242,11 +252,12 @@ void AbstractModelSpecifics::initialize(
 
 	if (initializeAccumulationVectors()) {
 		setPidForAccumulation(nullptr); // calls setupSparseIndices() before returning
- 	} else {
+ 	} else if (!sparseIndicesShared) {
 		// TODO Suspect below is not necessary for non-grouped data.
 		// If true, then fill with pointers to CompressedDataColumn and do not delete in destructor
 		setupSparseIndices(N); // Need to be recomputed when hPid change!
 	}
+	sparseIndicesShared = false; // Any later initialize() rebuilds
 
 
 
@@ -255,9 +266,7 @@ void AbstractModelSpecifics::initialize(
 // 	numerPid = numerDenomPidCache.data();
 // 	denomPid = numerPid + alignedLength; // Nested in denomPid allocation
 // 	numerPid2 = numerPid + 2 * alignedLength;
-	denomPid.resize(alignedLength);
-	numerPid.resize(alignedLength);
-	numerPid2.resize(alignedLength);
+	allocateRowStatistics(alignedLength);
 
 }
 
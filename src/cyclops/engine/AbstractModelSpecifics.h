@@ -14,6 +14,7 @@
 #include <cstddef>
 
 #include "Types.h"
+#include "engine/KernelProfile.h"
 
 namespace bsccs {
 
@@ -28,6 +29,12 @@ enum class ModelType; // forward declaration
 	typedef float real;
 #endif
 
+// Storage precision for per-row and per-stratum statistics; reductions always accumulate in real
+enum class StoragePrecision {
+	DOUBLE,
+	SINGLE
+};
+
 // #define DEBUG_COX // Uncomment to get output for Cox model
 // #define DEBUG_COX_MIN
 // #define DEBUG_POISSON
@@ -69,6 +76,22 @@ public:
 	virtual void computeFisherInformation(int indexOne, int indexTwo,
 			double *oinfo, bool useWeights) = 0; // pure virtual
 
+	// Gradient and row-major Hessian over columns indices, fused into one pass over the rows;
+	// returns false for models without a per-row (or per-stratum) rank-one Hessian form
+	virtual bool computeGradientAndHessianMatrix(const std::vector<int>& indices,
+			std::vector<double>& gradient, std::vector<double>& hessian, bool useWeights) = 0; // pure virtual
+
+	// Gradient and Hessian diagonal (when hessian is non-null) of every column from one set of
+	// row weights, with columns split over threads; returns false where the per-column kernels apply
+	virtual bool computeGradientAndHessianDiagonal(double* gradient, double* hessian,
+			bool useWeights, int threads) = 0; // pure virtual
+
+	// Log-likelihoods after shifting beta[indices[a]] by deltas[a * B + b], for b = 0, ..., B - 1,
+	// from one pass over the support of indices; the current state is left unchanged.
+	// Returns false for risk-set and exact-tie models, which need a full recomputation
+	virtual bool getLogLikelihoods(const std::vector<int>& indices, const std::vector<double>& deltas,
+			int B, double* logLikelihoods, bool useWeights) = 0; // pure virtual
+
 	virtual void updateXBeta(real realDelta, int index, bool useWeights) = 0; // pure virtual
 
 	virtual void computeRemainingStatistics(bool useWeights) = 0; // pure virtual
@@ -83,6 +106,9 @@ public:
 
     virtual void getPredictiveEstimates(real* y, real* weights) = 0; // pure virtual
 
+    // Maps linear predictors xBeta[begin, end) onto the response scale in y; safe on disjoint blocks
+    virtual void getPredictiveEstimates(real* y, const real* xBeta, size_t begin, size_t end) = 0; // pure virtual
+
     virtual void makeDirty();
     
     virtual void printTiming() = 0; // pure virtual
@@ -92,14 +118,20 @@ public:
 //	static bsccs::shared_ptr<AbstractModelSpecifics> factory(const ModelType modelType, const ModelData& modelData);
 
 	virtual AbstractModelSpecifics* clone() const = 0; // pure virtual
+
+	// Threads for stratum-partitioned kernels in grouped models; clones start serial
+	virtual void setStratumThreads(int threads) = 0; // pure virtual
 	
-	static AbstractModelSpecifics* factory(const ModelType modelType, const ModelData& modelData);
+	static AbstractModelSpecifics* factory(const ModelType modelType, const ModelData& modelData,
+			const StoragePrecision precision = StoragePrecision::DOUBLE);
 	
 	// TODO Remove the following
 	RealVector& getXBeta() { return hXBeta; }
 	
 	RealVector& getXBetaSave() {  return hXBetaSave; }
 
+	KernelProfile& getKernelProfile() { return kernelProfile; }
+
 protected:
 
 	int getAlignedLength(int N);
@@ -116,6 +148,8 @@ protected:
 
 	virtual bool hasResetableAccumulators(void) = 0; // pure virtual
 
+	virtual void allocateRowStatistics(size_t alignedLength) = 0; // pure virtual
+
 	template <class T>
 	void fillVector(T* vector, const int length, const T& value) {
 		for (int i = 0; i < length; i++) {
@@ -130,6 +164,8 @@ protected:
 	
 protected:
 	const ModelData& modelData;	
+
+	KernelProfile kernelProfile;
 		
 // 	const std::vector<real>& oY;
 // 	const std::vector<real>& oZ;
@@ -146,6 +182,7 @@ protected:
 	
 	const std::vector<real>& hY;
 	const std::vector<real>& hOffs;
+	const std::vector<real>& hRowCounts; // Row multiplicities after row-pattern compression, else empty
 // 	const std::vector<int>& hPid;
 
 // 	real* hY; // K-vector
@@ -173,16 +210,13 @@ protected:
 
 //	real* expXBeta;
 //	real* offsExpXBeta;
-	RealVector offsExpXBeta;
 	
 // 	RealVector numerDenomPidCache;
 // 	real* denomPid; // all nested with a single cache
 // 	real* numerPid;
 // 	real* numerPid2;
 
-	RealVector denomPid;
-	RealVector numerPid;
-	RealVector numerPid2;
+	// denomPid, numerPid, numerPid2 and offsExpXBeta are held in storage precision by ModelSpecifics
 			
 	
 //	real* xOffsExpXBeta;
@@ -192,9 +226,10 @@ protected:
 	real logLikelihoodFixedTerm;
 	
 	typedef std::vector<int> IndexVector;
-	typedef bsccs::shared_ptr<IndexVector> IndexVectorPtr;
+	typedef bsccs::shared_ptr<const IndexVector> IndexVectorPtr; // Read-only once built, so clones may share them
 
 	std::vector<IndexVectorPtr> sparseIndices; // TODO in c++11, are pointers necessary?
+	bool sparseIndicesShared; // Set by clone() when index sets are borrowed from the prototype
 
 	typedef std::map<int, std::vector<real> > HessianMap;
 	HessianMap hessianCrossTerms;
@@ -0,0 +1,439 @@
+/*
+ * FastMath.h
+ *
+ * Accuracy-bounded exp/log for the xBeta transforms and likelihood denominators in
+ * ModelSpecifics.  Precision is selected at run-time:
+ *
+ *   LIBM     -- std::exp / std::log (default; bitwise identical to earlier releases)
+ *   ACCURATE -- polynomial kernels, relative error < 1e-15
+ *   FAST     -- shorter polynomials, relative error < 1e-9
+ *
+ * Bulk entry points use the AVX-512/AVX2 instruction set selected in Simd.h.  In validation
+ * mode every evaluation is also computed with libm and the largest relative error is recorded.
+ */
+
+#ifndef FASTMATH_H_
+#define FASTMATH_H_
+
+#include <cmath>
+#include <cstring>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+
+#include "Simd.h"
+
+namespace bsccs {
+
+namespace fastmath {
+
+enum class Precision {
+	LIBM = 0,
+	ACCURATE = 1,
+	FAST = 2
+};
+
+struct ValidationStatistics {
+	double maxRelativeErrorExp;
+	double maxRelativeErrorLog;
+	size_t evaluations;
+
+	ValidationStatistics() : maxRelativeErrorExp(0.0), maxRelativeErrorLog(0.0), evaluations(0) { }
+};
+
+namespace detail {
+
+	struct Settings {
+		Precision precision;
+		bool validate;
+		ValidationStatistics statistics;
+		std::mutex mutex;
+
+		Settings() : precision(Precision::LIBM), validate(false) { }
+	};
+
+	inline Settings& settings() {
+		static Settings instance;
+		return instance;
+	}
+
+	// Range where 2^n stays a normal number; outside it (and for NaN) fall back to libm
+	const double expLower = -708.0;
+	const double expUpper = 709.0;
+
+	const double log2e = 1.4426950408889634074;
+	const double ln2hi = 6.93147180369123816490e-01;
+	const double ln2lo = 1.90821492927058770002e-10;
+	const double roundMagic = 6755399441055744.0; // 1.5 * 2^52
+	const double sqrt2 = 1.41421356237309504880;
+
+	// Taylor coefficients 1/k!
+	const double expCoefficients[] = {
+		1.0, 1.0, 1.0 / 2, 1.0 / 6, 1.0 / 24, 1.0 / 120, 1.0 / 720, 1.0 / 5040,
+		1.0 / 40320, 1.0 / 362880, 1.0 / 3628800, 1.0 / 39916800, 1.0 / 479001600,
+		1.0 / 6227020800.0
+	};
+
+	// log(m) = s * sum_k 2 / (2k + 1) * s^(2k), s = (m - 1) / (m + 1)
+	const double logCoefficients[] = {
+		2.0, 2.0 / 3, 2.0 / 5, 2.0 / 7, 2.0 / 9, 2.0 / 11, 2.0 / 13, 2.0 / 15,
+		2.0 / 17, 2.0 / 19, 2.0 / 21
+	};
+
+	// |r| <= ln(2) / 2 after reduction: degree 13 -> 4e-18, degree 8 -> 2e-10
+	inline int expDegree(Precision precision) {
+		return precision == Precision::FAST ? 8 : 13;
+	}
+
+	// |s| <= 0.1716 after reduction: 11 terms -> 1e-17, 7 terms -> 2e-11
+	inline int logTerms(Precision precision) {
+		return precision == Precision::FAST ? 7 : 11;
+	}
+
+	inline double exp(double x, int degree) {
+		if (!(x >= expLower && x <= expUpper)) {
+			return std::exp(x);
+		}
+		const double t = x * log2e + roundMagic;
+		const double n = t - roundMagic;
+		double r = x - n * ln2hi;
+		r -= n * ln2lo;
+
+		double p = expCoefficients[degree];
+		for (int i = degree - 1; i >= 0; --i) {
+			p = p * r + expCoefficients[i];
+		}
+
+		const int64_t bits = (static_cast<int64_t>(n) + 1023) << 52;
+		double scale;
+		std::memcpy(&scale, &bits, sizeof(double));
+		return p * scale;
+	}
+
+	inline double log(double x, int terms) {
+		if (!(x >= std::numeric_limits<double>::min() && x <= std::numeric_limits<double>::max())) {
+			return std::log(x);
+		}
+		int64_t bits;
+		std::memcpy(&bits, &x, sizeof(double));
+		int64_t e = (bits >> 52) - 1023;
+		bits = (bits & 0x000FFFFFFFFFFFFFLL) | 0x3FF0000000000000LL;
+		double m;
+		std::memcpy(&m, &bits, sizeof(double));
+		if (m > sqrt2) {
+			m *= 0.5;
+			++e;
+		}
+
+		const double s = (m - 1.0) / (m + 1.0);
+		const double z = s * s;
+		double p = logCoefficients[terms - 1];
+		for (int i = terms - 2; i >= 0; --i) {
+			p = p * z + logCoefficients[i];
+		}
+		const double ed = static_cast<double>(e);
+		return ed * ln2hi + (s * p + ed * ln2lo);
+	}
+
+	inline double relativeError(double approximate, double exact) {
+		if (approximate == exact) {
+			return 0.0;
+		}
+		const double denominator = std::abs(exact);
+		return denominator > 0.0 ? std::abs(approximate - exact) / denominator : std::abs(approximate);
+	}
+
+	inline void recordExp(const double* x, const double* y, size_t n) {
+		double maxError = 0.0;
+		for (size_t i = 0; i < n; ++i) {
+			const double error = relativeError(y[i], std::exp(x[i]));
+			if (error > maxError) maxError = error;
+		}
+		Settings& s = settings();
+		std::lock_guard<std::mutex> lock(s.mutex);
+		if (maxError > s.statistics.maxRelativeErrorExp) s.statistics.maxRelativeErrorExp = maxError;
+		s.statistics.evaluations += n;
+	}
+
+	inline void recordLog(const double* x, const double* y, size_t n) {
+		double maxError = 0.0;
+		for (size_t i = 0; i < n; ++i) {
+			const double error = relativeError(y[i], std::log(x[i]));
+			if (error > maxError) maxError = error;
+		}
+		Settings& s = settings();
+		std::lock_guard<std::mutex> lock(s.mutex);
+		if (maxError > s.statistics.maxRelativeErrorLog) s.statistics.maxRelativeErrorLog = maxError;
+		s.statistics.evaluations += n;
+	}
+
+#ifdef CYCLOPS_SIMD_X86
+
+	__attribute__((target("avx2,fma")))
+	inline void expAvx2(size_t n, const double* x, double* y, int degree) {
+		const __m256d lower = _mm256_set1_pd(expLower);
+		const __m256d upper = _mm256_set1_pd(expUpper);
+		const __m256d magic = _mm256_set1_pd(roundMagic);
+		const __m256i bias = _mm256_set1_epi64x(1023);
+		size_t i = 0;
+		for (; i + 4 <= n; i += 4) {
+			const __m256d vx = _mm256_loadu_pd(x + i);
+			const __m256d inRange = _mm256_and_pd(
+					_mm256_cmp_pd(vx, lower, _CMP_GE_OQ), _mm256_cmp_pd(vx, upper, _CMP_LE_OQ));
+			if (_mm256_movemask_pd(inRange) != 0xF) {
+				for (size_t j = i; j < i + 4; ++j) y[j] = exp(x[j], degree);
+				continue;
+			}
+			const __m256d t = _mm256_fmadd_pd(vx, _mm256_set1_pd(log2e), magic);
+			const __m256d vn = _mm256_sub_pd(t, magic);
+			__m256d r = _mm256_fnmadd_pd(vn, _mm256_set1_pd(ln2hi), vx);
+			r = _mm256_fnmadd_pd(vn, _mm256_set1_pd(ln2lo), r);
+
+			__m256d p = _mm256_set1_pd(expCoefficients[degree]);
+			for (int k = degree - 1; k >= 0; --k) {
+				p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(expCoefficients[k]));
+			}
+
+			const __m256i ni = _mm256_sub_epi64(_mm256_castpd_si256(t), _mm256_castpd_si256(magic));
+			const __m256i scale = _mm256_slli_epi64(_mm256_add_epi64(ni, bias), 52);
+			_mm256_storeu_pd(y + i, _mm256_mul_pd(p, _mm256_castsi256_pd(scale)));
+		}
+		for (; i < n; ++i) y[i] = exp(x[i], degree);
+	}
+
+	__attribute__((target("avx2,fma")))
+	inline void logAvx2(size_t n, const double* x, double* y, int terms) {
+		const __m256d lower = _mm256_set1_pd(std::numeric_limits<double>::min());
+		const __m256d upper = _mm256_set1_pd(std::numeric_limits<double>::max());
+		const __m256d one = _mm256_set1_pd(1.0);
+		const __m256d two52 = _mm256_set1_pd(4503599627370496.0); // 2^52, integer-to-double trick
+		const __m256i mantissaMask = _mm256_set1_epi64x(0x000FFFFFFFFFFFFFLL);
+		const __m256i oneBits = _mm256_set1_epi64x(0x3FF0000000000000LL);
+		size_t i = 0;
+		for (; i + 4 <= n; i += 4) {
+			const __m256d vx = _mm256_loadu_pd(x + i);
+			const __m256d inRange = _mm256_and_pd(
+					_mm256_cmp_pd(vx, lower, _CMP_GE_OQ), _mm256_cmp_pd(vx, upper, _CMP_LE_OQ));
+			if (_mm256_movemask_pd(inRange) != 0xF) {
+				for (size_t j = i; j < i + 4; ++j) y[j] = log(x[j], terms);
+				continue;
+			}
+			const __m256i bits = _mm256_castpd_si256(vx);
+			__m256i biased = _mm256_srli_epi64(bits, 52); // Sign bit is zero in range
+			__m256d m = _mm256_castsi256_pd(_mm256_or_si256(_mm256_and_si256(bits, mantissaMask), oneBits));
+			const __m256d large = _mm256_cmp_pd(m, _mm256_set1_pd(sqrt2), _CMP_GT_OQ);
+			m = _mm256_blendv_pd(m, _mm256_mul_pd(m, _mm256_set1_pd(0.5)), large);
+			biased = _mm256_sub_epi64(biased, _mm256_castpd_si256(large)); // true lanes are -1
+			const __m256d ed = _mm256_sub_pd(
+					_mm256_sub_pd(_mm256_castsi256_pd(_mm256_add_epi64(biased, _mm256_castpd_si256(two52))), two52),
+					_mm256_set1_pd(1023.0));
+
+			const __m256d s = _mm256_div_pd(_mm256_sub_pd(m, one), _mm256_add_pd(m, one));
+			const __m256d z = _mm256_mul_pd(s, s);
+			__m256d p = _mm256_set1_pd(logCoefficients[terms - 1]);
+			for (int k = terms - 2; k >= 0; --k) {
+				p = _mm256_fmadd_pd(p, z, _mm256_set1_pd(logCoefficients[k]));
+			}
+			const __m256d low = _mm256_fmadd_pd(s, p, _mm256_mul_pd(ed, _mm256_set1_pd(ln2lo)));
+			_mm256_storeu_pd(y + i, _mm256_fmadd_pd(ed, _mm256_set1_pd(ln2hi), low));
+		}
+		for (; i < n; ++i) y[i] = log(x[i], terms);
+	}
+
+	__attribute__((target("avx512f")))
+	inline void expAvx512(size_t n, const double* x, double* y, int degree) {
+		const __m512d lower = _mm512_set1_pd(expLower);
+		const __m512d upper = _mm512_set1_pd(expUpper);
+		const __m512d magic = _mm512_set1_pd(roundMagic);
+		const __m512i bias = _mm512_set1_epi64(1023);
+		size_t i = 0;
+		for (; i + 8 <= n; i += 8) {
+			const __m512d vx = _mm512_loadu_pd(x + i);
+			const __mmask8 inRange = _mm512_cmp_pd_mask(vx, lower, _CMP_GE_OQ)
+					& _mm512_cmp_pd_mask(vx, upper, _CMP_LE_OQ);
+			if (inRange != 0xFF) {
+				for (size_t j = i; j < i + 8; ++j) y[j] = exp(x[j], degree);
+				continue;
+			}
+			const __m512d t = _mm512_fmadd_pd(vx, _mm512_set1_pd(log2e), magic);
+			const __m512d vn = _mm512_sub_pd(t, magic);
+			__m512d r = _mm512_fnmadd_pd(vn, _mm512_set1_pd(ln2hi), vx);
+			r = _mm512_fnmadd_pd(vn, _mm512_set1_pd(ln2lo), r);
+
+			__m512d p = _mm512_set1_pd(expCoefficients[degree]);
+			for (int k = degree - 1; k >= 0; --k) {
+				p = _mm512_fmadd_pd(p, r, _mm512_set1_pd(expCoefficients[k]));
+			}
+
+			const __m512i ni = _mm512_sub_epi64(_mm512_castpd_si512(t), _mm512_castpd_si512(magic));
+			const __m512i scale = _mm512_slli_epi64(_mm512_add_epi64(ni, bias), 52);
+			_mm512_storeu_pd(y + i, _mm512_mul_pd(p, _mm512_castsi512_pd(scale)));
+		}
+		for (; i < n; ++i) y[i] = exp(x[i], degree);
+	}
+
+	__attribute__((target("avx512f")))
+	inline void logAvx512(size_t n, const double* x, double* y, int terms) {
+		const __m512d lower = _mm512_set1_pd(std::numeric_limits<double>::min());
+		const __m512d upper = _mm512_set1_pd(std::numeric_limits<double>::max());
+		const __m512d one = _mm512_set1_pd(1.0);
+		const __m512d two52 = _mm512_set1_pd(4503599627370496.0);
+		const __m512i mantissaMask = _mm512_set1_epi64(0x000FFFFFFFFFFFFFLL);
+		const __m512i oneBits = _mm512_set1_epi64(0x3FF0000000000000LL);
+		size_t i = 0;
+		for (; i + 8 <= n; i += 8) {
+			const __m512d vx = _mm512_loadu_pd(x + i);
+			const __mmask8 inRange = _mm512_cmp_pd_mask(vx, lower, _CMP_GE_OQ)
+					& _mm512_cmp_pd_mask(vx, upper, _CMP_LE_OQ);
+			if (inRange != 0xFF) {
+				for (size_t j = i; j < i + 8; ++j) y[j] = log(x[j], terms);
+				continue;
+			}
+			const __m512i bits = _mm512_castpd_si512(vx);
+			__m512i biased = _mm512_srli_epi64(bits, 52);
+			__m512d m = _mm512_castsi512_pd(_mm512_or_si512(_mm512_and_si512(bits, mantissaMask), oneBits));
+			const __mmask8 large = _mm512_cmp_pd_mask(m, _mm512_set1_pd(sqrt2), _CMP_GT_OQ);
+			m = _mm512_mask_mul_pd(m, large, m, _mm512_set1_pd(0.5));
+			biased = _mm512_mask_add_epi64(biased, large, biased, _mm512_set1_epi64(1));
+			const __m512d ed = _mm512_sub_pd(
+					_mm512_sub_pd(_mm512_castsi512_pd(_mm512_add_epi64(biased, _mm512_castpd_si512(two52))), two52),
+					_mm512_set1_pd(1023.0));
+
+			const __m512d s = _mm512_div_pd(_mm512_sub_pd(m, one), _mm512_add_pd(m, one));
+			const __m512d z = _mm512_mul_pd(s, s);
+			__m512d p = _mm512_set1_pd(logCoefficients[terms - 1]);
+			for (int k = terms - 2; k >= 0; --k) {
+				p = _mm512_fmadd_pd(p, z, _mm512_set1_pd(logCoefficients[k]));
+			}
+			const __m512d low = _mm512_fmadd_pd(s, p, _mm512_mul_pd(ed, _mm512_set1_pd(ln2lo)));
+			_mm512_storeu_pd(y + i, _mm512_fmadd_pd(ed, _mm512_set1_pd(ln2hi), low));
+		}
+		for (; i < n; ++i) y[i] = log(x[i], terms);
+	}
+
+#endif // CYCLOPS_SIMD_X86
+
+} // namespace detail
+
+inline Precision getPrecision() {
+	return detail::settings().precision;
+}
+
+inline void setPrecision(Precision precision) {
+	detail::settings().precision = precision;
+}
+
+inline bool getValidation() {
+	return detail::settings().validate;
+}
+
+inline void setValidation(bool validate) {
+	detail::settings().validate = validate;
+}
+
+inline ValidationStatistics getValidationStatistics() {
+	detail::Settings& s = detail::settings();
+	std::lock_guard<std::mutex> lock(s.mutex);
+	return s.statistics;
+}
+
+inline void resetValidationStatistics() {
+	detail::Settings& s = detail::settings();
+	std::lock_guard<std::mutex> lock(s.mutex);
+	s.statistics = ValidationStatistics();
+}
+
+inline double exp(double x) {
+	const Precision precision = getPrecision();
+	const double y = (precision == Precision::LIBM) ? std::exp(x) :
+			detail::exp(x, detail::expDegree(precision));
+	if (getValidation()) {
+		detail::recordExp(&x, &y, 1);
+	}
+	return y;
+}
+
+inline double log(double x) {
+	const Precision precision = getPrecision();
+	const double y = (precision == Precision::LIBM) ? std::log(x) :
+			detail::log(x, detail::logTerms(precision));
+	if (getValidation()) {
+		detail::recordLog(&x, &y, 1);
+	}
+	return y;
+}
+
+// y = exp(x), vectorized
+inline void exp(size_t n, const double* x, double* y) {
+	const Precision precision = getPrecision();
+	if (precision == Precision::LIBM) {
+		for (size_t i = 0; i < n; ++i) {
+			y[i] = std::exp(x[i]);
+		}
+	} else {
+		const int degree = detail::expDegree(precision);
+#ifdef CYCLOPS_SIMD_X86
+		switch (simd::getInstructionSet()) {
+			case simd::InstructionSet::AVX512 : detail::expAvx512(n, x, y, degree); break;
+			case simd::InstructionSet::AVX2 : detail::expAvx2(n, x, y, degree); break;
+			default :
+				for (size_t i = 0; i < n; ++i) y[i] = detail::exp(x[i], degree);
+		}
+#else
+		for (size_t i = 0; i < n; ++i) y[i] = detail::exp(x[i], degree);
+#endif
+	}
+	if (getValidation()) {
+		detail::recordExp(x, y, n);
+	}
+}
+
+// y = log(x), vectorized
+inline void log(size_t n, const double* x, double* y) {
+	const Precision precision = getPrecision();
+	if (precision == Precision::LIBM) {
+		for (size_t i = 0; i < n; ++i) {
+			y[i] = std::log(x[i]);
+		}
+	} else {
+		const int terms = detail::logTerms(precision);
+#ifdef CYCLOPS_SIMD_X86
+		switch (simd::getInstructionSet()) {
+			case simd::InstructionSet::AVX512 : detail::logAvx512(n, x, y, terms); break;
+			case simd::InstructionSet::AVX2 : detail::logAvx2(n, x, y, terms); break;
+			default :
+				for (size_t i = 0; i < n; ++i) y[i] = detail::log(x[i], terms);
+		}
+#else
+		for (size_t i = 0; i < n; ++i) y[i] = detail::log(x[i], terms);
+#endif
+	}
+	if (getValidation()) {
+		detail::recordLog(x, y, n);
+	}
+}
+
+// y = exp(x) into reduced-precision storage
+template <typename OutType>
+inline void exp(size_t n, const double* x, OutType* y) {
+	for (size_t i = 0; i < n; ++i) {
+		y[i] = static_cast<OutType>(exp(x[i]));
+	}
+}
+
+// Non-double types are evaluated through double
+template <typename RealType>
+inline RealType exp(RealType x) {
+	return static_cast<RealType>(exp(static_cast<double>(x)));
+}
+
+template <typename RealType>
+inline RealType log(RealType x) {
+	return static_cast<RealType>(log(static_cast<double>(x)));
+}
+
+} // namespace fastmath
+
+} // namespace bsccs
+
+#endif /* FASTMATH_H_ */
@@ -0,0 +1,121 @@
+/*
+ * KernelProfile.h
+ *
+ *  Run-time per-kernel timing and counters.  Unlike CYCLOPS_DEBUG_TIMING, this is
+ *  always compiled in; when disabled each instrumented call costs one branch.
+ */
+
+#ifndef KERNELPROFILE_H_
+#define KERNELPROFILE_H_
+
+#include <array>
+
+#include "Timing.h"
+
+namespace bsccs {
+
+class KernelProfile {
+public:
+
+	enum Kernel {
+		GRADIENT_HESSIAN = 0,
+		NUMERATOR_FOR_GRADIENT,
+		UPDATE_XBETA,
+		REMAINING_STATISTICS,
+		ACCUMULATION,
+		LOG_LIKELIHOOD,
+		PREDICTIVE_LOG_LIKELIHOOD,
+		FISHER_INFORMATION,
+		CYCLE,
+		CROSS_VALIDATION_FOLD,
+		NUMBER_OF_KERNELS
+	};
+
+	struct Counter {
+		long long calls;
+		long long nanoseconds;
+		long long bytes;
+	};
+
+	class Scope {
+	public:
+		Scope(KernelProfile& profile, const Kernel kernel, const long long bytes = 0)
+			: profile(profile.enabled ? &profile : nullptr), kernel(kernel), bytes(bytes) {
+			if (this->profile) {
+				start = chrono::steady_clock::now();
+			}
+		}
+
+		~Scope() {
+			if (profile) {
+				auto end = chrono::steady_clock::now();
+				profile->add(kernel,
+					chrono::duration_cast<chrono::TimingUnits>(end - start).count(), bytes);
+			}
+		}
+
+	private:
+		KernelProfile* profile;
+		const Kernel kernel;
+		const long long bytes;
+		chrono::steady_clock::time_point start;
+	};
+
+	KernelProfile() : enabled(false) {
+		reset();
+	}
+
+	bool getEnabled() const { return enabled; }
+
+	void setEnabled(const bool value) { enabled = value; }
+
+	void reset() {
+		for (auto& counter : counters) {
+			counter = Counter{0, 0, 0};
+		}
+	}
+
+	void add(const Kernel kernel, const long long nanoseconds, const long long bytes) {
+		Counter& counter = counters[kernel];
+		++counter.calls;
+		counter.nanoseconds += nanoseconds;
+		counter.bytes += bytes;
+	}
+
+	// Folds in counters from a clone (e.g. a cross-validation worker)
+	void merge(const KernelProfile& other) {
+		for (int i = 0; i < NUMBER_OF_KERNELS; ++i) {
+			counters[i].calls += other.counters[i].calls;
+			counters[i].nanoseconds += other.counters[i].nanoseconds;
+			counters[i].bytes += other.counters[i].bytes;
+		}
+	}
+
+	const Counter& getCounter(const Kernel kernel) const {
+		return counters[kernel];
+	}
+
+	static const char* getName(const Kernel kernel) {
+		switch (kernel) {
+			case GRADIENT_HESSIAN : return "gradientHessian";
+			case NUMERATOR_FOR_GRADIENT : return "numeratorForGradient";
+			case UPDATE_XBETA : return "updateXBeta";
+			case REMAINING_STATISTICS : return "remainingStatistics";
+			case ACCUMULATION : return "accumulation";
+			case LOG_LIKELIHOOD : return "logLikelihood";
+			case PREDICTIVE_LOG_LIKELIHOOD : return "predictiveLogLikelihood";
+			case FISHER_INFORMATION : return "fisherInformation";
+			case CYCLE : return "cycle";
+			case CROSS_VALIDATION_FOLD : return "crossValidationFold";
+			default : return "unknown";
+		}
+	}
+
+private:
+	bool enabled;
+	std::array<Counter, NUMBER_OF_KERNELS> counters;
+};
+
+} /* namespace bsccs */
+
+#endif /* KERNELPROFILE_H_ */
@@ -35,6 +35,9 @@
 #include "AbstractModelSpecifics.h"
 #include "Iterators.h"
 #include "ParallelLoops.h"
+#include "ThreadPool.h"
+#include "Simd.h"
+#include "FastMath.h"
 
 namespace bsccs {
 
@@ -186,11 +189,22 @@ public:
 
 	AbstractModelSpecifics* clone() const;
 
+	void setStratumThreads(int threads);
+
 protected:
 	void computeNumeratorForGradient(int index);
 
 	void computeFisherInformation(int indexOne, int indexTwo, double *oinfo, bool useWeights);
 
+	bool computeGradientAndHessianMatrix(const std::vector<int>& indices,
+			std::vector<double>& gradient, std::vector<double>& hessian, bool useWeights);
+
+	bool computeGradientAndHessianDiagonal(double* gradient, double* hessian,
+			bool useWeights, int threads);
+
+	bool getLogLikelihoods(const std::vector<int>& indices, const std::vector<double>& deltas,
+			int B, double* logLikelihoods, bool useWeights);
+
 	void updateXBeta(real realDelta, int index, bool useWeights);
 
 	void computeRemainingStatistics(bool useWeights);
@@ -209,6 +223,8 @@ protected:
 
 	void getPredictiveEstimates(real* y, real* weights);
 
+	void getPredictiveEstimates(real* y, const real* xBeta, size_t begin, size_t end);
+
 	bool allocateXjY(void);
 
 	bool allocateXjX(void);
@@ -225,9 +241,54 @@ protected:
 
 	bool hasResetableAccumulators(void);
 
+	void allocateRowStatistics(size_t alignedLength);
+
 	void printTiming(void);
 
 private:
+	// Approximate bytes streamed by a column kernel that reads/writes rowStatistics per-row vectors
+	long long getColumnBytes(int index, int rowStatistics) const;
+
+	// Contiguous rows [rowBegin, rowEnd) holding exactly strata [stratumBegin, stratumEnd)
+	struct StratumBlock {
+		size_t rowBegin;
+		size_t rowEnd;
+		int stratumBegin;
+		int stratumEnd;
+	};
+
+	// Splits grouped-model strata into row-balanced blocks, one per stratum thread
+	void partitionStrata();
+
+	bool useStratumBlocks(size_t work) const {
+		return stratumBlocks.size() > 1 && work >= 16384;
+	}
+
+	// Runs function(block) for every stratum block; blocks write disjoint strata
+	template <typename Function>
+	void forEachStratumBlock(Function function);
+
+	// First column entry (or stratum in the column's index set) at or after row (stratum)
+	template <class IteratorType>
+	size_t getEntryOffset(int index, size_t row) const;
+
+	template <class IteratorType>
+	size_t getStratumOffset(int index, int stratum) const;
+
+	void computeRemainingStatistics(size_t rowBegin, size_t rowEnd,
+			int stratumBegin, int stratumEnd);
+
+	// Row multiplicities enter stratum denominators directly; independent rows take them as weights
+	const real* getRowCountsForDenominator() const {
+		return (!BaseModel::hasIndependentRows && !hRowCounts.empty()) ? hRowCounts.data() : nullptr;
+	}
+
+	// Log-likelihood denominator term; a compressed independent row stands for ni identical rows
+	real logLikeDenominatorTerm(WeightType ni, real denominator) {
+		const real term = BaseModel::logLikeDenominatorContrib(ni, denominator);
+		return (BaseModel::hasIndependentRows && !hRowCounts.empty()) ? ni * term : term;
+	}
+
 	template <class IteratorType, class Weights>
 	void computeGradientAndHessianImpl(
 			int index,
@@ -240,6 +301,32 @@ private:
 	template <class IteratorType>
 	void updateXBetaImpl(real delta, int index, bool useWeights);
 
+	template <class IteratorType>
+	void updateXBetaVectorized(real delta, int index);
+
+	template <class IteratorType, class Weights>
+	void computeGradientAndHessianGathered(int index, real* gradient, real* hessian, Weights w);
+
+	// True when a DENSE/INTERCEPT column uses the explicitly vectorized kernels in Simd.h
+	template <class IteratorType>
+	bool useDenseKernels() const;
+
+	template <class IteratorType, class Weights>
+	void computeGradientAndHessianDense(int index, real* gradient, real* hessian, Weights w);
+
+	template <class IteratorType>
+	void updateXBetaDense(real delta, int index);
+
+	template <class DenominatorVector>
+	real accumulateLogLikelihoodDenominator(const DenominatorVector& denominator,
+			size_t begin, size_t end);
+
+	template <bool useWeights>
+	real accumulateLogLikelihoodNumerator(size_t begin, size_t end);
+
+	template <class DenominatorVector>
+	real accumulatePredictiveLogLikelihood(const DenominatorVector& denominator, real* weights);
+
 	template <class OutType, class InType>
 	void incrementByGroup(OutType* values, int* groups, int k, InType inc) {
 		values[BaseModel::getGroup(groups, k)] += inc; // TODO delegate to BaseModel (different in tied-models)
@@ -254,6 +341,33 @@ private:
 	template<class IteratorType>
 	SparseIterator getSubjectSpecificHessianIterator(int index);
 
+	// Row-major copy of columns indices into fusedRowStart / fusedColumn / fusedValue
+	void transposeColumns(const std::vector<int>& indices);
+
+	// Whether the fused kernels apply: no risk sets or exact ties, and strata in contiguous rows
+	bool hasFusedRowWeights() const;
+
+	// Per-row gradient and Hessian weights (x = 1) into fusedRowGradient / fusedRowHessian / fusedRowMean
+	template <class Weights>
+	void computeFusedRowWeights(Weights w);
+
+	template <class Weights>
+	void computeGradientAndHessianMatrixImpl(size_t p, double* gradient, double* hessian, Weights w);
+
+	template <class IteratorType>
+	void computeColumnGradientAndHessian(int index, double* gradient, double* hessian);
+
+	void computeColumnGradientAndHessian(int begin, int end, double* gradient, double* hessian);
+
+	// Adds x * deltas[b] into shift[slot(k) * C + b] over the entries of column index
+	template <class IteratorType>
+	void accumulateLinearPredictorShift(int index, const double* deltas, size_t C,
+			const std::vector<int>& slot, real* shift);
+
+	template <bool useWeights>
+	void accumulateLogLikelihoodChanges(const std::vector<int>& rows, const real* shift, size_t C,
+			double* logLikelihoods);
+
 	void computeXjY(bool useCrossValidation);
 
 	void computeXjX(bool useCrossValidation);
@@ -263,6 +377,30 @@ private:
 	std::vector<WeightType> hNWeight;
 	std::vector<WeightType> hKWeight;
 
+	// Row and stratum statistics are stored as WeightType (float for single-precision storage);
+	// gradient, Hessian and likelihood sums over them accumulate in real
+	std::vector<WeightType> offsExpXBeta;
+	std::vector<WeightType> denomPid;
+	std::vector<WeightType> numerPid;
+	std::vector<WeightType> numerPid2;
+
+	// Contiguous copies of row statistics gathered for sparse columns
+	std::vector<WeightType> gatherExpXBeta;
+	RealVector gatherXBeta;
+	RealVector gatherY;
+	std::vector<WeightType> gatherDenominator;
+	std::vector<WeightType> gatherWeight;
+
+	// Row-major entries of the columns in the fused gradient and Hessian kernel
+	std::vector<size_t> fusedRowStart;
+	std::vector<size_t> fusedCursor;
+	std::vector<int> fusedColumn;
+	RealVector fusedValue;
+	RealVector fusedRowGradient;
+	RealVector fusedRowHessian;
+	RealVector fusedRowMean; // Grouped models: x = 1 share of the stratum numerator
+	RealVector fusedStratumScale; // Grouped models: n / denominator per stratum
+
 //	std::vector<int> nPid;
 //	std::vector<real> nY;
 	std::vector<int> hNtoK;
@@ -277,6 +415,13 @@ private:
 
 	ParallelInfo info;
 
+	int stratumThreads;
+	std::vector<StratumBlock> stratumBlocks; // Empty unless stratum-parallel
+	bsccs::shared_ptr<ThreadPool> stratumPool;
+
+	int gradientThreads;
+	bsccs::shared_ptr<ThreadPool> gradientPool; // Column-parallel full gradient
+
 //	C11ThreadPool threadPool;
 
 #ifdef CYCLOPS_DEBUG_TIMING
@@ -902,7 +1047,7 @@ struct TestUpdateXBetaKernel : private BaseModel {
         xBeta += delta * x;
 
         if (BaseModel::likelihoodHasDenominator) {
-            expXBeta = std::exp(xBeta);
+            expXBeta = fastmath::exp(xBeta);
             denominator = BaseModel::getDenomNullValue() + expXBeta;
         }
     }
@@ -917,17 +1062,17 @@ private:	 // TODO Code duplication; remove
 	}
 };
 
-template <class BaseModel, class IteratorType, class RealType, class IntType>
+template <class BaseModel, class IteratorType, class RealType, class IntType, class StorageType = RealType>
 struct UpdateXBetaKernel : private BaseModel {
 
 // 	using XTuple = typename IteratorType::XTuple;
     typedef typename IteratorType::XTuple XTuple;
 
 	UpdateXBetaKernel(RealType _delta,
-			RealType* _expXBeta, RealType* _xBeta, const RealType* _y, IntType* _pid,
-			RealType* _denominator, const RealType* _offs)
+			StorageType* _expXBeta, RealType* _xBeta, const RealType* _y, IntType* _pid,
+			StorageType* _denominator, const RealType* _offs, const RealType* _counts = nullptr)
 			: delta(_delta), expXBeta(_expXBeta), xBeta(_xBeta), y(_y), pid(_pid),
-			  denominator(_denominator), offs(_offs) { }
+			  denominator(_denominator), offs(_offs), counts(_counts) { }
 
 	void operator()(XTuple tuple) {
 
@@ -940,7 +1085,7 @@ struct UpdateXBetaKernel : private BaseModel {
 		if (BaseModel::likelihoodHasDenominator) { // Compile-time switch
 			if (true) {	// Old method
 				real oldEntry = expXBeta[k];
-				real newEntry = expXBeta[k] = BaseModel::getOffsExpXBeta(offs, xBeta[k], y[k], k);
+				real newEntry = expXBeta[k] = scale(BaseModel::getOffsExpXBeta(offs, xBeta[k], y[k], k), k);
 				denominator[BaseModel::getGroup(pid, k)] += (newEntry - oldEntry);
 			} else {
 			#if 0  // logistic
@@ -964,13 +1109,18 @@ private:
 		return boost::get<0>(tuple);
 	}
 
+	inline real scale(real value, IntType k) const { // Compressed rows stand for counts[k] rows
+		return counts ? value * counts[k] : value;
+	}
+
 	RealType delta;
-	RealType* expXBeta;
+	StorageType* expXBeta;
 	RealType* xBeta;
 	const RealType* y;
 	IntType* pid;
-	RealType* denominator;
+	StorageType* denominator;
 	const RealType* offs;
+	const RealType* counts;
 };
 
 struct GLMProjection {
@@ -981,6 +1131,10 @@ public:
 
 	const static bool hasTwoNumeratorTerms = true;
 
+	const static bool offsetScalesExpXBeta = false; // getOffsExpXBeta == exp(xBeta)
+
+	const static simd::DenseKernel denseKernel = simd::DenseKernel::NONE;
+
 	template <class XType>
 	real gradientNumeratorContrib(XType x, real predictor, real xBeta, real y) {
 //		using namespace indicator_sugar;
@@ -988,7 +1142,7 @@ public:
 	}
 
 
-	real logLikeNumeratorContrib(int yi, real xBetai) {
+	real logLikeNumeratorContrib(real yi, real xBetai) {
 		return yi * xBetai;
 	}
 
@@ -1093,6 +1247,8 @@ struct SelfControlledCaseSeries : public GroupedData, GLMProjection, FixedPid, S
 public:
 	const static bool precomputeHessian = false; // XjX
 
+	const static bool offsetScalesExpXBeta = true; // getOffsExpXBeta == offs * exp(xBeta)
+
 #define TEST_CONSTANT_SCCS
 #ifdef TEST_CONSTANT_SCCS
 	const static bool likelihoodHasFixedTerms = true;
@@ -1153,24 +1309,24 @@ public:
     }
 
     real getOffsExpXBeta(const real offs, const real xBeta) {
-        return offs * std::exp(xBeta);
+        return offs * fastmath::exp(xBeta);
     }
 
 	real getOffsExpXBeta(const real* offs, real xBeta, real y, int k) {
-		return offs[k] * std::exp(xBeta);
+		return offs[k] * fastmath::exp(xBeta);
 	}
 
 	real logLikeDenominatorContrib(WeightType ni, real denom) {
-		return ni * std::log(denom);
+		return ni * fastmath::log(denom);
 	}
 
 	real logPredLikeContrib(real y, real weight, real xBeta, real denominator) {
-	    return y * weight * (xBeta - std::log(denominator));
+	    return y * weight * (xBeta - fastmath::log(denominator));
 	}
 
 	real logPredLikeContrib(int ji, real weighti, real xBetai, const real* denoms,
 			const int* groups, int i) {
-		return ji * weighti * (xBetai - std::log(denoms[getGroup(groups, i)]));
+		return ji * weighti * (xBetai - fastmath::log(denoms[getGroup(groups, i)]));
 	}
 
 	void predictEstimate(real& yi, real xBeta){
@@ -1187,7 +1343,7 @@ public:
 	const static bool likelihoodHasFixedTerms = true;
 
 // 	real logLikeFixedTermsContrib(real yi, real offseti, real logoffseti) {
-// 		return yi * std::log(offseti);
+// 		return yi * fastmath::log(offseti);
 // 	}
 
 	real logLikeFixedTermsContrib(real yi, real offseti, real logoffseti) {
@@ -1241,24 +1397,24 @@ public:
     }
 
     real getOffsExpXBeta(const real offs, const real xBeta) {
-        return std::exp(xBeta);
+        return fastmath::exp(xBeta);
     }
 
 	real getOffsExpXBeta(const real* offs, real xBeta, real y, int k) {
-		return std::exp(xBeta);
+		return fastmath::exp(xBeta);
 	}
 
 	real logLikeDenominatorContrib(WeightType ni, real denom) {
-		return ni * std::log(denom);
+		return ni * fastmath::log(denom);
 	}
 
 	real logPredLikeContrib(real y, real weight, real xBeta, real denominator) {
-	    return y * weight * (xBeta - std::log(denominator));
+	    return y * weight * (xBeta - fastmath::log(denominator));
 	}
 
 	real logPredLikeContrib(int ji, real weighti, real xBetai, const real* denoms,
 			const int* groups, int i) {
-		return ji * weighti * (xBetai - std::log(denoms[getGroup(groups, i)]));
+		return ji * weighti * (xBetai - fastmath::log(denoms[getGroup(groups, i)]));
 	}
 
 	void predictEstimate(real& yi, real xBeta){
@@ -1320,24 +1476,24 @@ public:
     }
 
     real getOffsExpXBeta(const real offs, const real xBeta) {
-        return std::exp(xBeta);
+        return fastmath::exp(xBeta);
     }
 
 	real getOffsExpXBeta(const real* offs, real xBeta, real y, int k) {
-		return std::exp(xBeta);
+		return fastmath::exp(xBeta);
 	}
 
 	real logLikeDenominatorContrib(WeightType ni, real denom) {
-		return ni * std::log(denom);
+		return ni * fastmath::log(denom);
 	}
 
 	real logPredLikeContrib(real y, real weight, real xBeta, real denominator) {
-	    return y * weight * (xBeta - std::log(denominator));
+	    return y * weight * (xBeta - fastmath::log(denominator));
 	}
 
 	real logPredLikeContrib(int ji, real weighti, real xBetai, const real* denoms,
 			const int* groups, int i) {
-		return ji * weighti * (xBetai - std::log(denoms[getGroup(groups, i)]));
+		return ji * weighti * (xBetai - fastmath::log(denoms[getGroup(groups, i)]));
 	}
 
 	void predictEstimate(real& yi, real xBeta){
@@ -1404,24 +1560,24 @@ public:
     }
 
     real getOffsExpXBeta(const real offs, const real xBeta) {
-        return std::exp(xBeta);
+        return fastmath::exp(xBeta);
     }
 
 	real getOffsExpXBeta(const real* offs, real xBeta, real y, int k) {
-		return std::exp(xBeta);
+		return fastmath::exp(xBeta);
 	}
 
 	real logLikeDenominatorContrib(WeightType ni, real denom) {
-		return ni * std::log(denom);
+		return ni * fastmath::log(denom);
 	}
 
 	real logPredLikeContrib(real y, real weight, real xBeta, real denominator) {
-	    return y * weight * (xBeta - std::log(denominator));
+	    return y * weight * (xBeta - fastmath::log(denominator));
 	}
 
 	real logPredLikeContrib(int ji, real weighti, real xBetai, const real* denoms,
 			const int* groups, int i) {
-		return ji * weighti * (xBetai - std::log(denoms[getGroup(groups, i)]));
+		return ji * weighti * (xBetai - fastmath::log(denoms[getGroup(groups, i)]));
 	}
 
 	void predictEstimate(real& yi, real xBeta){
@@ -1437,6 +1593,8 @@ struct LogisticRegression : public IndependentData, GLMProjection, Logistic<Weig
 public:
 	const static bool precomputeHessian = false;
 
+	const static simd::DenseKernel denseKernel = simd::DenseKernel::LOGISTIC;
+
 // 	const static bool
 
 	static real getDenomNullValue () { return static_cast<real>(1.0); }
@@ -1450,24 +1608,24 @@ public:
 	}
 
     real getOffsExpXBeta(const real offs, const real xBeta) {
-        return std::exp(xBeta);
+        return fastmath::exp(xBeta);
     }
 
 	real getOffsExpXBeta(const real* offs, real xBeta, real y, int k) {
-		return std::exp(xBeta);
+		return fastmath::exp(xBeta);
 	}
 
 	real logLikeDenominatorContrib(WeightType ni, real denom) {
-		return std::log(denom);
+		return fastmath::log(denom);
 	}
 
 	real logPredLikeContrib(real y, real weight, real xBeta, real denominator) {
-	    return y * weight * (xBeta - std::log(denominator));
+	    return y * weight * (xBeta - fastmath::log(denominator));
 	}
 
 	real logPredLikeContrib(int ji, real weighti, real xBetai, const real* denoms,
 			const int* groups, int i) {
-		return ji * weighti * (xBetai - std::log(denoms[getGroup(groups, i)]));
+		return ji * weighti * (xBetai - fastmath::log(denoms[getGroup(groups, i)]));
 	}
 
 	void predictEstimate(real& yi, real xBeta){
@@ -1541,26 +1699,26 @@ public:
     }
 
     real getOffsExpXBeta(const real offs, const real xBeta) {
-        return std::exp(xBeta);
+        return fastmath::exp(xBeta);
     }
 
 	real getOffsExpXBeta(const real* offs, real xBeta, real y, int k) {
-		return std::exp(xBeta);
+		return fastmath::exp(xBeta);
 	}
 
 	real logLikeDenominatorContrib(WeightType ni, real accDenom) {
-		return ni*std::log(accDenom);
+		return ni*fastmath::log(accDenom);
 	}
 
 	real logPredLikeContrib(real y, real weight, real xBeta, real denominator) {
 	    return weight == 0.0 ? 0.0 :
-	        y * weight * (xBeta - std::log(denominator));
+	        y * weight * (xBeta - fastmath::log(denominator));
 	}
 
 	real logPredLikeContrib(int ji, real weighti, real xBetai, const real* denoms,
 			const int* groups, int i) {
 		return weighti == 0.0 ? 0.0 :
-		    ji * weighti * (xBetai - std::log(denoms[getGroup(groups, i)]));
+		    ji * weighti * (xBetai - fastmath::log(denoms[getGroup(groups, i)]));
 	}
 
 	void predictEstimate(real& yi, real xBeta){
@@ -1639,26 +1797,26 @@ public:
     }
 
     real getOffsExpXBeta(const real offs, const real xBeta) {
-        return std::exp(xBeta);
+        return fastmath::exp(xBeta);
     }
 
 	real getOffsExpXBeta(const real* offs, real xBeta, real y, int k) {
-		return std::exp(xBeta);
+		return fastmath::exp(xBeta);
 	}
 
 	real logLikeDenominatorContrib(WeightType ni, real accDenom) {
-		return ni*std::log(accDenom);
+		return ni*fastmath::log(accDenom);
 	}
 
 	real logPredLikeContrib(real y, real weight, real xBeta, real denominator) {
 	    return weight == 0.0 ? 0.0 :
-	        y * weight * (xBeta - std::log(denominator));
+	        y * weight * (xBeta - fastmath::log(denominator));
 	}
 
 	real logPredLikeContrib(int ji, real weighti, real xBetai, const real* denoms,
 			const int* groups, int i) {
 		return weighti == 0.0 ? 0.0 :
-		    ji * weighti * (xBetai - std::log(denoms[getGroup(groups, i)]));
+		    ji * weighti * (xBetai - fastmath::log(denoms[getGroup(groups, i)]));
 	}
 
 	void predictEstimate(real& yi, real xBeta){
@@ -1675,6 +1833,10 @@ public:
 
 	const static bool likelihoodHasDenominator = false;
 
+	const static bool offsetScalesExpXBeta = false;
+
+	const static simd::DenseKernel denseKernel = simd::DenseKernel::NONE; // X beta uses updateXBetaVectorized
+
 	const static bool hasTwoNumeratorTerms = false;
 
 	static real getDenomNullValue () { return static_cast<real>(0.0); }
@@ -1769,7 +1931,7 @@ public:
 	}
 
 	real logLikeDenominatorContrib(int ni, real denom) {
-		return std::log(denom);
+		return fastmath::log(denom);
 	}
 
 	real logPredLikeContrib(real y, real weight, real xBeta, real denominator) {
@@ -1794,6 +1956,8 @@ public:
 
 	const static bool precomputeHessian = false; // XjX
 
+	const static simd::DenseKernel denseKernel = simd::DenseKernel::POISSON;
+
 	const static bool likelihoodHasFixedTerms = true;
 
 	static real getDenomNullValue () { return static_cast<real>(0.0); }
@@ -1867,19 +2031,19 @@ public:
 
 
 	real getOffsExpXBeta(const real offs, const real xBeta) {
-		return std::exp(xBeta);
+		return fastmath::exp(xBeta);
 	}
 
 	real getOffsExpXBeta(const real* offs, real xBeta, real y, int k) {
-		return std::exp(xBeta);
+		return fastmath::exp(xBeta);
 	}
 
-	real logLikeDenominatorContrib(int ni, real denom) {
+	real logLikeDenominatorContrib(int /*ni*/, real denom) {
 		return denom;
 	}
 
 	real logPredLikeContrib(real y, real weight, real xBeta, real denominator) {
-	    return (y *  xBeta - std::exp(xBeta)) * weight;
+	    return (y *  xBeta - fastmath::exp(xBeta)) * weight;
 	}
 
 	real logPredLikeContrib(int ji, real weighti, real xBetai, const real* denoms,
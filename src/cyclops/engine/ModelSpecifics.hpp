@@ -269,7 +269,7 @@ namespace helper {
 
 template <class BaseModel,typename WeightType>
 ModelSpecifics<BaseModel,WeightType>::ModelSpecifics(const ModelData& input)
-	: AbstractModelSpecifics(input), BaseModel()//,
+	: AbstractModelSpecifics(input), BaseModel(), stratumThreads(1), gradientThreads(1)//,
 //  	threadPool(4,4,1000)
 // threadPool(0,0,10)
 	{
@@ -286,7 +286,118 @@ ModelSpecifics<BaseModel,WeightType>::ModelSpecifics(const ModelData& input)
 
 template <class BaseModel, typename WeightType>
 AbstractModelSpecifics* ModelSpecifics<BaseModel,WeightType>::clone() const {
-	return new ModelSpecifics<BaseModel,WeightType>(modelData);
+	auto copy = new ModelSpecifics<BaseModel,WeightType>(modelData);
+	copy->kernelProfile.setEnabled(kernelProfile.getEnabled());
+	if (!BaseModel::cumulativeGradientAndHessian && sparseIndices.size() == J) {
+		// Without accumulation, index sets depend only on the (shared) design and stratum ids,
+		// so clones borrow them read-only instead of rebuilding J sets per thread
+		copy->sparseIndices = sparseIndices;
+		copy->sparseIndicesShared = true;
+	}
+	return copy;
+}
+
+template <class BaseModel, typename WeightType>
+void ModelSpecifics<BaseModel,WeightType>::setStratumThreads(int threads) {
+	stratumThreads = std::max(threads, 1);
+	partitionStrata();
+}
+
+template <class BaseModel, typename WeightType>
+void ModelSpecifics<BaseModel,WeightType>::partitionStrata() {
+	stratumBlocks.clear();
+
+	// Only models whose rows interact solely within a stratum (SCCS, CLR, CPR, tied CLR)
+	if (BaseModel::hasIndependentRows || BaseModel::cumulativeGradientAndHessian
+			|| stratumThreads <= 1 || K == 0) {
+		return;
+	}
+
+	// Blocks require rows grouped by stratum, with strata numbered 0, 1, ... in row order
+	if (hPid[0] != 0 || hPid[K - 1] != static_cast<int>(N) - 1) {
+		return;
+	}
+	for (size_t k = 1; k < K; ++k) {
+		const int step = hPid[k] - hPid[k - 1];
+		if (step != 0 && step != 1) {
+			return;
+		}
+	}
+
+	const size_t minRowsPerBlock = 10000;
+	const size_t nBlocks = std::min(static_cast<size_t>(stratumThreads), K / minRowsPerBlock);
+	if (nBlocks <= 1) {
+		return;
+	}
+
+	// Cut at the first stratum boundary after each equal share of rows
+	size_t rowBegin = 0;
+	for (size_t b = 0; b < nBlocks && rowBegin < K; ++b) {
+		size_t rowEnd = (b == nBlocks - 1) ? K : std::max(rowBegin + 1, (b + 1) * K / nBlocks);
+		while (rowEnd < K && hPid[rowEnd] == hPid[rowEnd - 1]) {
+			++rowEnd;
+		}
+		stratumBlocks.push_back(StratumBlock{rowBegin, rowEnd, hPid[rowBegin], hPid[rowEnd - 1] + 1});
+		rowBegin = rowEnd;
+	}
+
+	if (stratumBlocks.size() <= 1) {
+		stratumBlocks.clear();
+		return;
+	}
+	stratumPool = bsccs::make_shared<ThreadPool>(stratumBlocks.size() - 1);
+}
+
+template <class BaseModel, typename WeightType> template <typename Function>
+void ModelSpecifics<BaseModel,WeightType>::forEachStratumBlock(Function function) {
+	std::vector<std::future<void> > results;
+	results.reserve(stratumBlocks.size() - 1);
+	for (size_t b = 1; b < stratumBlocks.size(); ++b) {
+		results.push_back(stratumPool->enqueue(function, b));
+	}
+	function(0);
+	for (auto& result : results) {
+		result.get();
+	}
+}
+
+template <class BaseModel, typename WeightType> template <class IteratorType>
+size_t ModelSpecifics<BaseModel,WeightType>::getEntryOffset(int index, size_t row) const {
+	if (IteratorType::isSparse) {
+		const int* rows = modelData.getCompressedColumnVector(index);
+		const size_t n = modelData.getNumberOfEntries(index);
+		return std::lower_bound(rows, rows + n, static_cast<int>(row)) - rows;
+	}
+	return row;
+}
+
+template <class BaseModel, typename WeightType> template <class IteratorType>
+size_t ModelSpecifics<BaseModel,WeightType>::getStratumOffset(int index, int stratum) const {
+	if (IteratorType::isSparse) {
+		const IndexVector& strata = *sparseIndices[index];
+		return std::lower_bound(strata.begin(), strata.end(), stratum) - strata.begin();
+	}
+	return static_cast<size_t>(stratum);
+}
+
+template <class BaseModel, typename WeightType>
+long long ModelSpecifics<BaseModel,WeightType>::getColumnBytes(int index, int rowStatistics) const {
+	const auto entries = static_cast<long long>(modelData.getNumberOfNonZeroEntries(index));
+	long long perEntry = rowStatistics * sizeof(WeightType);
+	switch (modelData.getFormatType(index)) {
+		case SPARSE :
+			perEntry += sizeof(int) + sizeof(real);
+			break;
+		case INDICATOR :
+			perEntry += sizeof(int);
+			break;
+		case DENSE :
+			perEntry += sizeof(real);
+			break;
+		default :
+			break;
+	}
+	return entries * perEntry;
 }
 
 template <class BaseModel, typename WeightType>
@@ -336,6 +447,15 @@ bool ModelSpecifics<BaseModel,WeightType>::allocateNtoKIndices(void) { return Ba
 template <class BaseModel,typename WeightType>
 bool ModelSpecifics<BaseModel,WeightType>::hasResetableAccumulators(void) { return BaseModel::hasResetableAccumulators; }
 
+template <class BaseModel,typename WeightType>
+void ModelSpecifics<BaseModel,WeightType>::allocateRowStatistics(size_t alignedLength) {
+	offsExpXBeta.resize(K);
+	denomPid.resize(alignedLength);
+	numerPid.resize(alignedLength);
+	numerPid2.resize(alignedLength);
+	partitionStrata(); // Called last in initialize(), once hPid, K and N are set
+}
+
 template <class BaseModel,typename WeightType>
 void ModelSpecifics<BaseModel,WeightType>::setWeights(real* inWeights, bool useCrossValidation) {
 	// Set K weights
@@ -452,7 +572,12 @@ void ModelSpecifics<BaseModel,WeightType>::computeFixedTermsInLogLikelihood(bool
 	if(BaseModel::likelihoodHasFixedTerms) {
 		logLikelihoodFixedTerm = 0.0;
 	    bool hasOffs = hOffs.size() > 0;
-		if(useCrossValidation) {
+		const RealVector& uncompressedY = modelData.getUncompressedYVectorRef();
+		if (!uncompressedY.empty()) { // Compressed rows carry mean outcomes; fixed terms need the originals
+			for (auto yi : uncompressedY) {
+				logLikelihoodFixedTerm += BaseModel::logLikeFixedTermsContrib(yi, 0.0, 0.0);
+			}
+		} else if(useCrossValidation) {
 			for(size_t i = 0; i < K; i++) {
 			    auto offs = hasOffs ? hOffs[i] : 0.0;
 				logLikelihoodFixedTerm += BaseModel::logLikeFixedTermsContrib(hY[i], offs, offs) * hKWeight[i];
@@ -485,6 +610,9 @@ void ModelSpecifics<BaseModel,WeightType>::computeFixedTermsInGradientAndHessian
 template <class BaseModel,typename WeightType>
 double ModelSpecifics<BaseModel,WeightType>::getLogLikelihood(bool useCrossValidation) {
 
+	KernelProfile::Scope profile(kernelProfile, KernelProfile::LOG_LIKELIHOOD,
+		K * (sizeof(real) + sizeof(WeightType)) + N * sizeof(WeightType));
+
 #ifdef CYCLOPS_DEBUG_TIMING
 	auto start = bsccs::chrono::steady_clock::now();
 #endif
@@ -503,19 +631,30 @@ double ModelSpecifics<BaseModel,WeightType>::getLogLikelihood(bool useCrossValid
 //                 SerialOnly()
 //     		);
 
-    auto rangeNumerator = helper::getRangeAllNumerators(K, hY, hXBeta, hKWeight);
+    real logLikelihood;
+
+    if (!BaseModel::cumulativeGradientAndHessian && useStratumBlocks(K)) {
+
+		// Partial sums per stratum block, combined in block order
+		std::vector<real> partial(stratumBlocks.size());
+		forEachStratumBlock([this, useCrossValidation, &partial](size_t b) {
+			const StratumBlock& block = stratumBlocks[b];
+			real sum = useCrossValidation ?
+					accumulateLogLikelihoodNumerator<true>(block.rowBegin, block.rowEnd) :
+					accumulateLogLikelihoodNumerator<false>(block.rowBegin, block.rowEnd);
+			if (BaseModel::likelihoodHasDenominator) {
+				sum -= accumulateLogLikelihoodDenominator(denomPid, block.stratumBegin, block.stratumEnd);
+			}
+			partial[b] = sum;
+		});
+
+		logLikelihood = std::accumulate(partial.begin(), partial.end(), static_cast<real>(0));
+
+    } else {
 
-    real logLikelihood = useCrossValidation ?
-    		variants::reduce(
-                rangeNumerator.begin(), rangeNumerator.end(), static_cast<real>(0.0),
-                TestAccumulateLikeNumeratorKernel<BaseModel,real,true>(),
-                SerialOnly()
-    		) :
-    		variants::reduce(
-                rangeNumerator.begin(), rangeNumerator.end(), static_cast<real>(0.0),
-                TestAccumulateLikeNumeratorKernel<BaseModel,real,false>(),
-                SerialOnly()
-    		);
+    logLikelihood = useCrossValidation ?
+    		accumulateLogLikelihoodNumerator<true>(0, K) :
+    		accumulateLogLikelihoodNumerator<false>(0, K);
 
 //     std::cerr << logLikelihood << " == " << logLikelihood2 << std::endl;
 
@@ -534,18 +673,13 @@ double ModelSpecifics<BaseModel,WeightType>::getLogLikelihood(bool useCrossValid
 //                 SerialOnly()
 //         );
 
-		auto rangeDenominator = (BaseModel::cumulativeGradientAndHessian) ?
-				helper::getRangeAllDenominators(N, accDenomPid, hNWeight) :
-				helper::getRangeAllDenominators(N, denomPid, hNWeight);
-
-		logLikelihood -= variants::reduce(
-				rangeDenominator.begin(), rangeDenominator.end(),
-				static_cast<real>(0.0),
-				TestAccumulateLikeDenominatorKernel<BaseModel,real>(),
-				SerialOnly()
-		);
+		logLikelihood -= (BaseModel::cumulativeGradientAndHessian) ?
+				accumulateLogLikelihoodDenominator(accDenomPid, 0, N) :
+				accumulateLogLikelihoodDenominator(denomPid, 0, N);
 
 //         std::cerr << logLikelihood << " == " << logLikelihood2 << std::endl;
+    }
+
     }
 
 	if (BaseModel::likelihoodHasFixedTerms) {
@@ -564,10 +698,13 @@ double ModelSpecifics<BaseModel,WeightType>::getLogLikelihood(bool useCrossValid
 template <class BaseModel,typename WeightType>
 double ModelSpecifics<BaseModel,WeightType>::getPredictiveLogLikelihood(real* weights) {
 
+	KernelProfile::Scope profile(kernelProfile, KernelProfile::PREDICTIVE_LOG_LIKELIHOOD,
+		K * sizeof(real) + N * (sizeof(real) + sizeof(WeightType)));
+
     std::vector<real> saveKWeight;
 	if(BaseModel::cumulativeGradientAndHessian)	{
 
- 		saveKWeight = hKWeight; // make copy
+ 		saveKWeight.assign(hKWeight.begin(), hKWeight.end()); // make copy
 
 // 		std::vector<int> savedPid = hPidInternal; // make copy
 // 		std::vector<int> saveAccReset = accReset; // make copy
@@ -576,18 +713,9 @@ double ModelSpecifics<BaseModel,WeightType>::getPredictiveLogLikelihood(real* we
 
     }
 
-	// Compile-time switch for models with / with-out PID (hasIndependentRows)
-	auto range = helper::getRangeAllPredictiveLikelihood(K, hY, hXBeta,
-		(BaseModel::cumulativeGradientAndHessian) ? accDenomPid : denomPid,
-		weights, hPid, std::integral_constant<bool, BaseModel::hasIndependentRows>());
-
-	auto kernel = TestPredLikeKernel<BaseModel,real>();
-
-	real logLikelihood = variants::reduce(
-			range.begin(), range.end(), static_cast<real>(0.0),
-			kernel,
-			SerialOnly()
-		);
+	real logLikelihood = (BaseModel::cumulativeGradientAndHessian) ?
+			accumulatePredictiveLogLikelihood(accDenomPid, weights) :
+			accumulatePredictiveLogLikelihood(denomPid, weights);
 
 	if (BaseModel::cumulativeGradientAndHessian) {
 
@@ -600,6 +728,58 @@ double ModelSpecifics<BaseModel,WeightType>::getPredictiveLogLikelihood(real* we
 	return static_cast<double>(logLikelihood);
 }   // END OF DIFF
 
+template <class BaseModel,typename WeightType> template <bool useWeights>
+real ModelSpecifics<BaseModel,WeightType>::accumulateLogLikelihoodNumerator(size_t begin, size_t end) {
+
+	auto rangeNumerator = helper::getRangeAllNumerators(K, hY, hXBeta, hKWeight);
+
+	return variants::reduce(
+			rangeNumerator.begin() + begin, rangeNumerator.begin() + end,
+			static_cast<real>(0.0),
+			TestAccumulateLikeNumeratorKernel<BaseModel,real,useWeights>(),
+			SerialOnly()
+	);
+}
+
+template <class BaseModel,typename WeightType> template <class DenominatorVector>
+real ModelSpecifics<BaseModel,WeightType>::accumulateLogLikelihoodDenominator(
+		const DenominatorVector& denominator, size_t begin, size_t end) {
+
+	if (BaseModel::hasIndependentRows && !hRowCounts.empty()) {
+		real sum = static_cast<real>(0);
+		for (size_t i = begin; i < end; ++i) {
+			sum += logLikeDenominatorTerm(hNWeight[i], denominator[i]);
+		}
+		return sum;
+	}
+
+	auto rangeDenominator = helper::getRangeAllDenominators(N, denominator, hNWeight);
+
+	return variants::reduce(
+			rangeDenominator.begin() + begin, rangeDenominator.begin() + end,
+			static_cast<real>(0.0),
+			TestAccumulateLikeDenominatorKernel<BaseModel,real>(),
+			SerialOnly()
+	);
+}
+
+template <class BaseModel,typename WeightType> template <class DenominatorVector>
+real ModelSpecifics<BaseModel,WeightType>::accumulatePredictiveLogLikelihood(
+		const DenominatorVector& denominator, real* weights) {
+
+	// Compile-time switch for models with / with-out PID (hasIndependentRows)
+	auto range = helper::getRangeAllPredictiveLikelihood(K, hY, hXBeta, denominator,
+		weights, hPid, std::integral_constant<bool, BaseModel::hasIndependentRows>());
+
+	auto kernel = TestPredLikeKernel<BaseModel,real>();
+
+	return variants::reduce(
+			range.begin(), range.end(), static_cast<real>(0.0),
+			kernel,
+			SerialOnly()
+		);
+}
+
 template <class BaseModel,typename WeightType>
 void ModelSpecifics<BaseModel,WeightType>::getPredictiveEstimates(real* y, real* weights){
 
@@ -626,11 +806,25 @@ void ModelSpecifics<BaseModel,WeightType>::getPredictiveEstimates(real* y, real*
 	// TODO How to remove code duplication above?
 }
 
+template <class BaseModel,typename WeightType>
+void ModelSpecifics<BaseModel,WeightType>::getPredictiveEstimates(real* y, const real* xBeta,
+		size_t begin, size_t end) {
+	// Models without a response-scale estimate leave the linear predictor in place
+	for (size_t k = begin; k < end; ++k) {
+		const real linearPredictor = xBeta[k];
+		y[k] = linearPredictor;
+		BaseModel::predictEstimate(y[k], linearPredictor);
+	}
+}
+
 // TODO The following function is an example of a double-dispatch, rewrite without need for virtual function
 template <class BaseModel,typename WeightType>
 void ModelSpecifics<BaseModel,WeightType>::computeGradientAndHessian(int index, double *ogradient,
 		double *ohessian, bool useWeights) {
 
+	KernelProfile::Scope profile(kernelProfile, KernelProfile::GRADIENT_HESSIAN,
+		kernelProfile.getEnabled() ? getColumnBytes(index, 2) : 0);
+
 #ifdef CYCLOPS_DEBUG_TIMING
 #ifndef CYCLOPS_DEBUG_TIMING_LOW
 	auto start = bsccs::chrono::steady_clock::now();
@@ -820,6 +1014,15 @@ void ModelSpecifics<BaseModel,WeightType>::computeGradientAndHessianImpl(int ind
     Rcpp::stop("out");
 #endif
 
+	} else if (BaseModel::hasIndependentRows && IteratorType::isSparse
+			&& simd::getInstructionSet() >= simd::InstructionSet::AVX2) {
+
+		computeGradientAndHessianGathered<IteratorType>(index, &gradient, &hessian, w);
+
+	} else if (useDenseKernels<IteratorType>()) {
+
+		computeGradientAndHessianDense<IteratorType>(index, &gradient, &hessian, w);
+
 	} else if (BaseModel::hasIndependentRows) {
 
 		auto range = helper::independent::getRangeX(modelData, index,
@@ -878,12 +1081,37 @@ void ModelSpecifics<BaseModel,WeightType>::computeGradientAndHessianImpl(int ind
                 denomPid, hNWeight,
                 typename IteratorType::tag());
 
-		const auto result = variants::trial::nested_reduce(
+		Fraction<real> result{0,0};
+
+		if (useStratumBlocks(modelData.getNumberOfNonZeroEntries(index))) {
+			// Each block reduces over its own strata; partials are combined in block order
+			std::vector<Fraction<real> > partial(stratumBlocks.size(), Fraction<real>{0,0});
+			forEachStratumBlock([&](size_t b) {
+				const StratumBlock& block = stratumBlocks[b];
+				const size_t first = getEntryOffset<IteratorType>(index, block.rowBegin);
+				const size_t last = getEntryOffset<IteratorType>(index, block.rowEnd);
+				if (first == last) {
+					return;
+				}
+				const size_t stratum = getStratumOffset<IteratorType>(index, block.stratumBegin);
+				partial[b] = variants::trial::nested_reduce(
+						rangeKey.begin() + first, rangeKey.begin() + last,
+						rangeXNumerator.begin() + first, rangeGradient.begin() + stratum,
+						std::pair<real,real>{0,0}, Fraction<real>{0,0},
+						TestNumeratorKernel<BaseModel,IteratorType,real>(),
+						TestGradientKernel<BaseModel,IteratorType,Weights,real>());
+			});
+			for (const auto& p : partial) {
+				result += p;
+			}
+		} else {
+			result = variants::trial::nested_reduce(
 		        rangeKey.begin(), rangeKey.end(),
 		        rangeXNumerator.begin(), rangeGradient.begin(),
 		        std::pair<real,real>{0,0}, Fraction<real>{0,0},
                 TestNumeratorKernel<BaseModel,IteratorType,real>(), // Inner transform-reduce
 		       	TestGradientKernel<BaseModel,IteratorType,Weights,real>()); // Outer transform-reduce
+		}
 
 		gradient = result.real();
 		hessian = result.imag();
@@ -920,10 +1148,67 @@ void ModelSpecifics<BaseModel,WeightType>::computeGradientAndHessianImpl(int ind
 
  }
 
+template <class BaseModel,typename WeightType> template <class IteratorType, class Weights>
+void ModelSpecifics<BaseModel,WeightType>::computeGradientAndHessianGathered(int index,
+		real* gradient, real* hessian, Weights /*w*/) {
+
+	// Gather row statistics for the non-zero entries with vector gathers, then run the
+	// model transform over contiguous memory instead of through permutation iterators
+	const size_t n = modelData.getNumberOfEntries(index);
+	const int* rows = modelData.getCompressedColumnVector(index);
+
+	if (gatherExpXBeta.size() < n) {
+		gatherExpXBeta.resize(n);
+		gatherXBeta.resize(n);
+		gatherY.resize(n);
+		gatherDenominator.resize(n);
+		gatherWeight.resize(n);
+	}
+
+	auto gatherRows = [this](size_t length, const int* rows, size_t offset) {
+		simd::gather(length, offsExpXBeta.data(), rows, gatherExpXBeta.data() + offset);
+		simd::gather(length, hXBeta.data(), rows, gatherXBeta.data() + offset);
+		simd::gather(length, hY.data(), rows, gatherY.data() + offset);
+		simd::gather(length, denomPid.data(), rows, gatherDenominator.data() + offset);
+		simd::gather(length, hNWeight.data(), rows, gatherWeight.data() + offset);
+	};
+
+	const RowIndexEncoding* encoding = modelData.getColumn(index).getEncoding();
+	if (encoding) {
+		// Stream the compact encoding, decoding one block of row indices at a time
+		int block[RowIndexEncoding::BLOCK_SIZE];
+		for (size_t b = 0; b < encoding->getNumberOfBlocks(); ++b) {
+			const size_t length = encoding->decodeBlock(b, block);
+			gatherRows(length, block, b * RowIndexEncoding::BLOCK_SIZE);
+		}
+	} else {
+		gatherRows(n, rows, 0);
+	}
+
+	// Indicator columns never dereference the x entry
+	const real* x = IteratorType::isIndicator ?
+			gatherXBeta.data() : modelData.getDataVector(index);
+
+	auto first = boost::make_zip_iterator(boost::make_tuple(
+			gatherExpXBeta.data(), gatherXBeta.data(), gatherY.data(),
+			gatherDenominator.data(), gatherWeight.data(), x));
+
+	const auto result = variants::reduce(first, first + n, Fraction<real>(0,0),
+		TransformAndAccumulateGradientAndHessianKernelIndependent<BaseModel,IteratorType, Weights, real, int>(),
+		SerialOnly()
+	);
+
+	*gradient = result.real();
+	*hessian = result.imag();
+}
+
 template <class BaseModel,typename WeightType>
 void ModelSpecifics<BaseModel,WeightType>::computeFisherInformation(int indexOne, int indexTwo,
 		double *oinfo, bool useWeights) {
 
+	KernelProfile::Scope profile(kernelProfile, KernelProfile::FISHER_INFORMATION,
+		kernelProfile.getEnabled() ? getColumnBytes(indexOne, 2) + getColumnBytes(indexTwo, 0) : 0);
+
 	if (useWeights) {
 // 		std::cerr << "Weights are not yet implemented in Fisher Information calculations" << std::endl;
 // 		exit(-1);
@@ -946,6 +1231,478 @@ void ModelSpecifics<BaseModel,WeightType>::computeFisherInformation(int indexOne
 	}
 }
 
+template <class BaseModel,typename WeightType>
+bool ModelSpecifics<BaseModel,WeightType>::computeGradientAndHessianMatrix(const std::vector<int>& indices,
+		std::vector<double>& gradient, std::vector<double>& hessian, bool useWeights) {
+
+	if (!hasFusedRowWeights()) {
+		return false;
+	}
+
+	const size_t p = indices.size();
+
+	transposeColumns(indices);
+
+	KernelProfile::Scope profile(kernelProfile, KernelProfile::GRADIENT_HESSIAN,
+		fusedColumn.size() * (sizeof(int) + sizeof(real)) + K * (sizeof(real) * 2 + sizeof(WeightType) * 3));
+
+	gradient.assign(p, 0.0);
+	hessian.assign(p * p, 0.0);
+
+	if (useWeights) {
+		computeFusedRowWeights(weighted);
+		computeGradientAndHessianMatrixImpl(p, gradient.data(), hessian.data(), weighted);
+	} else {
+		computeFusedRowWeights(unweighted);
+		computeGradientAndHessianMatrixImpl(p, gradient.data(), hessian.data(), unweighted);
+	}
+
+	for (size_t a = 0; a < p; ++a) {
+		if (BaseModel::precomputeGradient) { // Compile-time switch
+			gradient[a] -= hXjY[indices[a]];
+		}
+		for (size_t b = 0; b < a; ++b) {
+			hessian[a * p + b] = hessian[b * p + a];
+		}
+	}
+	return true;
+}
+
+template <class BaseModel,typename WeightType>
+bool ModelSpecifics<BaseModel,WeightType>::computeGradientAndHessianDiagonal(double* gradient,
+		double* hessian, bool useWeights, int threads) {
+
+	if (!hasFusedRowWeights()) {
+		return false;
+	}
+
+	const int J = static_cast<int>(modelData.getNumberOfColumns());
+
+	long long bytes = 0;
+	if (kernelProfile.getEnabled()) {
+		bytes = K * (sizeof(real) * 3 + sizeof(WeightType) * 3);
+		for (int j = 0; j < J; ++j) {
+			bytes += getColumnBytes(j, 3);
+		}
+	}
+	KernelProfile::Scope profile(kernelProfile, KernelProfile::GRADIENT_HESSIAN, bytes);
+
+	if (!BaseModel::hasIndependentRows) {
+		// Grouped rows only need their stratum's n / denominator, so skip the per-row pass
+		fusedStratumScale.resize(N);
+		for (size_t i = 0; i < N; ++i) {
+			fusedStratumScale[i] = hNWeight[i] / denomPid[i];
+		}
+	} else if (useWeights) {
+		computeFusedRowWeights(weighted);
+	} else {
+		computeFusedRowWeights(unweighted);
+	}
+
+	threads = std::max(1, std::min(threads, J));
+	if (threads == 1) {
+		computeColumnGradientAndHessian(0, J, gradient, hessian);
+	} else {
+		if (gradientThreads != threads || !gradientPool) {
+			gradientPool = bsccs::make_shared<ThreadPool>(threads - 1);
+			gradientThreads = threads;
+		}
+
+		// Cut the columns into runs of roughly equal non-zero counts
+		std::vector<size_t> work(J + 1, 0);
+		for (int j = 0; j < J; ++j) {
+			work[j + 1] = work[j] + modelData.getNumberOfNonZeroEntries(j) + 1;
+		}
+		std::vector<int> cut(threads + 1, J);
+		cut[0] = 0;
+		for (int t = 1; t < threads; ++t) {
+			cut[t] = static_cast<int>(std::lower_bound(work.begin(), work.end(),
+				work[J] * t / threads) - work.begin());
+			cut[t] = std::max(cut[t - 1], std::min(cut[t], J));
+		}
+
+		std::vector<std::future<void> > results;
+		results.reserve(threads - 1);
+		for (int t = 1; t < threads; ++t) {
+			const int begin = cut[t];
+			const int end = cut[t + 1];
+			results.push_back(gradientPool->enqueue([this, begin, end, gradient, hessian]() {
+				computeColumnGradientAndHessian(begin, end, gradient, hessian);
+			}));
+		}
+		computeColumnGradientAndHessian(cut[0], cut[1], gradient, hessian);
+		for (auto& result : results) {
+			result.get();
+		}
+	}
+
+	if (BaseModel::precomputeGradient) { // Compile-time switch
+		for (int j = 0; j < J; ++j) {
+			gradient[j] -= hXjY[j];
+		}
+	}
+	return true;
+}
+
+template <class BaseModel,typename WeightType>
+void ModelSpecifics<BaseModel,WeightType>::computeColumnGradientAndHessian(int begin, int end,
+		double* gradient, double* hessian) {
+	for (int index = begin; index < end; ++index) {
+		switch (modelData.getFormatType(index)) {
+			case INDICATOR :
+				computeColumnGradientAndHessian<IndicatorIterator>(index, gradient, hessian);
+				break;
+			case SPARSE :
+				computeColumnGradientAndHessian<SparseIterator>(index, gradient, hessian);
+				break;
+			case DENSE :
+				computeColumnGradientAndHessian<DenseIterator>(index, gradient, hessian);
+				break;
+			case INTERCEPT :
+				computeColumnGradientAndHessian<InterceptIterator>(index, gradient, hessian);
+				break;
+		}
+	}
+}
+
+template <class BaseModel,typename WeightType> template <class IteratorType>
+void ModelSpecifics<BaseModel,WeightType>::computeColumnGradientAndHessian(int index,
+		double* gradient, double* hessian) {
+
+	real columnGradient = static_cast<real>(0);
+	real columnHessian = static_cast<real>(0);
+
+	if (hessian == nullptr) {
+		for (IteratorType it(modelData, index); it; ++it) {
+			const int k = it.index();
+			columnGradient += BaseModel::hasIndependentRows ?
+					fusedRowGradient[k] * it.value() :
+					BaseModel::gradientNumeratorContrib(it.value(), offsExpXBeta[k], hXBeta[k], hY[k])
+						* fusedStratumScale[hPid[k]];
+		}
+	} else if (BaseModel::hasIndependentRows) {
+		for (IteratorType it(modelData, index); it; ++it) {
+			const int k = it.index();
+			const real x = it.value();
+			columnGradient += fusedRowGradient[k] * x;
+			columnHessian += fusedRowHessian[k] * x * x;
+		}
+	} else {
+		// Row gradient weights are numerator * n / denominator and equal the Hessian weights; the
+		// rank-one correction n * (sum x * mean)^2 is (sum x * rowGradient)^2 / n, flushed as the
+		// column leaves each stratum
+		int stratum = -1;
+		real stratumSum = static_cast<real>(0);
+		for (IteratorType it(modelData, index); it; ++it) {
+			const int k = it.index();
+			if (hPid[k] != stratum) {
+				if (stratumSum != static_cast<real>(0)) {
+					columnHessian -= stratumSum * stratumSum / hNWeight[stratum];
+				}
+				stratum = hPid[k];
+				stratumSum = static_cast<real>(0);
+			}
+			const real gx = BaseModel::gradientNumeratorContrib(it.value(),
+					offsExpXBeta[k], hXBeta[k], hY[k]) * fusedStratumScale[stratum];
+			columnGradient += gx;
+			columnHessian += gx * it.value();
+			stratumSum += gx;
+		}
+		if (stratumSum != static_cast<real>(0)) {
+			columnHessian -= stratumSum * stratumSum / hNWeight[stratum];
+		}
+	}
+
+	gradient[index] = columnGradient;
+	if (hessian != nullptr) {
+		hessian[index] = columnHessian;
+	}
+}
+
+template <class BaseModel,typename WeightType>
+bool ModelSpecifics<BaseModel,WeightType>::hasFusedRowWeights() const {
+
+	// Risk-set accumulations and exact ties do not reduce to per-row or per-stratum outer products
+	if (BaseModel::cumulativeGradientAndHessian || BaseModel::exactTies) {
+		return false;
+	}
+
+	// Stratum sums are flushed when the stratum changes, so strata must be contiguous
+	if (!BaseModel::hasIndependentRows) {
+		for (size_t k = 1; k < K; ++k) {
+			if (hPid[k] < hPid[k - 1]) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+template <class BaseModel,typename WeightType> template <class Weights>
+void ModelSpecifics<BaseModel,WeightType>::computeFusedRowWeights(Weights /*w*/) {
+
+	fusedRowGradient.resize(K);
+	fusedRowHessian.resize(K);
+	fusedRowMean.resize(BaseModel::hasIndependentRows ? 0 : K);
+
+	for (size_t k = 0; k < K; ++k) {
+		if (BaseModel::hasIndependentRows) {
+			// Column kernels are linear (gradient) and quadratic (Hessian) in x, so x = 1 gives the row weights
+			const real numerator = BaseModel::gradientNumeratorContrib(static_cast<real>(1),
+					offsExpXBeta[k], hXBeta[k], hY[k]);
+			const real numerator2 = BaseModel::hasTwoNumeratorTerms ?
+					BaseModel::gradientNumerator2Contrib(static_cast<real>(1), offsExpXBeta[k]) :
+					static_cast<real>(0);
+			const auto row = BaseModel::template incrementGradientAndHessian<DenseIterator, Weights, real>(
+					Fraction<real>(0,0), numerator, numerator2,
+					denomPid[k], hNWeight[k], hXBeta[k], hY[k]);
+			fusedRowGradient[k] = row.real();
+			fusedRowHessian[k] = row.imag();
+			if (BaseModel::precomputeHessian) { // Compile-time switch
+				fusedRowHessian[k] += static_cast<real>(2) * (Weights::isWeighted ? hKWeight[k] : static_cast<real>(1));
+			}
+		} else {
+			const int stratum = hPid[k];
+			fusedRowMean[k] = BaseModel::gradientNumeratorContrib(static_cast<real>(1),
+					offsExpXBeta[k], hXBeta[k], hY[k]) / denomPid[stratum];
+			fusedRowGradient[k] = hNWeight[stratum] * fusedRowMean[k];
+			fusedRowHessian[k] = fusedRowGradient[k];
+		}
+	}
+}
+
+template <class BaseModel,typename WeightType>
+bool ModelSpecifics<BaseModel,WeightType>::getLogLikelihoods(const std::vector<int>& indices,
+		const std::vector<double>& deltas, int B, double* logLikelihoods, bool useWeights) {
+
+	// Only rows on the support change xBeta; stratum denominators are patched when the rows of
+	// a stratum end, so the same contiguity as the fused kernels is required
+	if (!hasFusedRowWeights()) {
+		return false;
+	}
+
+	const double base = getLogLikelihood(useWeights);
+	std::fill(logLikelihoods, logLikelihoods + B, base);
+
+	// Union of the supports, in row order
+	std::vector<int> slot(K, -1);
+	std::vector<int> rows;
+	for (auto index : indices) {
+		for (GenericIterator it(modelData, index); it; ++it) {
+			if (slot[it.index()] < 0) {
+				slot[it.index()] = 0;
+				rows.push_back(it.index());
+			}
+		}
+	}
+	std::sort(rows.begin(), rows.end());
+	for (size_t t = 0; t < rows.size(); ++t) {
+		slot[rows[t]] = static_cast<int>(t);
+	}
+
+	KernelProfile::Scope profile(kernelProfile, KernelProfile::LOG_LIKELIHOOD,
+		rows.size() * B * (sizeof(real) * 3 + sizeof(WeightType) * 2));
+
+	if (rows.empty()) {
+		return true;
+	}
+
+	// Shifts are held for a chunk of C points at a time
+	const size_t maxShiftEntries = 1 << 23;
+	const size_t C = std::max(static_cast<size_t>(1),
+		std::min(static_cast<size_t>(B), maxShiftEntries / rows.size()));
+
+	std::vector<double> chunkDeltas;
+	RealVector shift;
+	for (size_t first = 0; first < static_cast<size_t>(B); first += C) {
+		const size_t width = std::min(C, B - first);
+		shift.assign(rows.size() * width, static_cast<real>(0));
+
+		for (size_t a = 0; a < indices.size(); ++a) {
+			chunkDeltas.assign(deltas.begin() + a * B + first, deltas.begin() + a * B + first + width);
+			switch (modelData.getFormatType(indices[a])) {
+				case INDICATOR :
+					accumulateLinearPredictorShift<IndicatorIterator>(indices[a], chunkDeltas.data(), width, slot, shift.data());
+					break;
+				case SPARSE :
+					accumulateLinearPredictorShift<SparseIterator>(indices[a], chunkDeltas.data(), width, slot, shift.data());
+					break;
+				case DENSE :
+					accumulateLinearPredictorShift<DenseIterator>(indices[a], chunkDeltas.data(), width, slot, shift.data());
+					break;
+				case INTERCEPT :
+					accumulateLinearPredictorShift<InterceptIterator>(indices[a], chunkDeltas.data(), width, slot, shift.data());
+					break;
+			}
+		}
+
+		if (useWeights) {
+			accumulateLogLikelihoodChanges<true>(rows, shift.data(), width, logLikelihoods + first);
+		} else {
+			accumulateLogLikelihoodChanges<false>(rows, shift.data(), width, logLikelihoods + first);
+		}
+	}
+	return true;
+}
+
+template <class BaseModel,typename WeightType> template <class IteratorType>
+void ModelSpecifics<BaseModel,WeightType>::accumulateLinearPredictorShift(int index,
+		const double* deltas, size_t C, const std::vector<int>& slot, real* shift) {
+	for (IteratorType it(modelData, index); it; ++it) {
+		const real x = it.value();
+		real* row = shift + slot[it.index()] * C;
+		for (size_t b = 0; b < C; ++b) {
+			row[b] += static_cast<real>(deltas[b]) * x;
+		}
+	}
+}
+
+template <class BaseModel,typename WeightType> template <bool useWeights>
+void ModelSpecifics<BaseModel,WeightType>::accumulateLogLikelihoodChanges(const std::vector<int>& rows,
+		const real* shift, size_t C, double* logLikelihoods) {
+
+	const real* counts = getRowCountsForDenominator();
+	std::vector<real> denominatorChange(C, static_cast<real>(0));
+	int group = -1;
+
+	auto flushGroup = [&]() {
+		if (group < 0) {
+			return;
+		}
+		const real denominator = denomPid[group];
+		const real old = logLikeDenominatorTerm(hNWeight[group], denominator);
+		for (size_t b = 0; b < C; ++b) {
+			logLikelihoods[b] -= logLikeDenominatorTerm(hNWeight[group],
+					denominator + denominatorChange[b]) - old;
+			denominatorChange[b] = static_cast<real>(0);
+		}
+	};
+
+	for (size_t t = 0; t < rows.size(); ++t) {
+		const int k = rows[t];
+		const real* rowShift = shift + t * C;
+		const real xBeta = hXBeta[k];
+		const real weight = useWeights ? static_cast<real>(hKWeight[k]) : static_cast<real>(1);
+		const real oldNumerator = BaseModel::logLikeNumeratorContrib(hY[k], xBeta);
+
+		for (size_t b = 0; b < C; ++b) {
+			logLikelihoods[b] += weight *
+					(BaseModel::logLikeNumeratorContrib(hY[k], xBeta + rowShift[b]) - oldNumerator);
+		}
+
+		if (BaseModel::likelihoodHasDenominator) { // Compile-time switch
+			const int rowGroup = BaseModel::getGroup(hPid, k);
+			if (rowGroup != group) {
+				flushGroup();
+				group = rowGroup;
+			}
+			const real oldEntry = offsExpXBeta[k];
+			const real scale = counts ? counts[k] : static_cast<real>(1);
+			for (size_t b = 0; b < C; ++b) {
+				denominatorChange[b] += scale * BaseModel::getOffsExpXBeta(hOffs.data(),
+						xBeta + rowShift[b], hY[k], k) - oldEntry;
+			}
+		}
+	}
+
+	if (BaseModel::likelihoodHasDenominator) {
+		flushGroup();
+	}
+}
+
+template <class BaseModel,typename WeightType>
+void ModelSpecifics<BaseModel,WeightType>::transposeColumns(const std::vector<int>& indices) {
+
+	fusedRowStart.assign(K + 1, 0);
+	for (auto index : indices) {
+		for (GenericIterator it(modelData, index); it; ++it) {
+			++fusedRowStart[it.index() + 1];
+		}
+	}
+	for (size_t k = 0; k < K; ++k) {
+		fusedRowStart[k + 1] += fusedRowStart[k];
+	}
+
+	fusedColumn.resize(fusedRowStart[K]);
+	fusedValue.resize(fusedRowStart[K]);
+	fusedCursor.assign(fusedRowStart.begin(), fusedRowStart.end() - 1);
+
+	// Filling column by column leaves each row's entries sorted by position in indices
+	for (size_t a = 0; a < indices.size(); ++a) {
+		for (GenericIterator it(modelData, indices[a]); it; ++it) {
+			const size_t entry = fusedCursor[it.index()]++;
+			fusedColumn[entry] = static_cast<int>(a);
+			fusedValue[entry] = it.value();
+		}
+	}
+}
+
+template <class BaseModel,typename WeightType> template <class Weights>
+void ModelSpecifics<BaseModel,WeightType>::computeGradientAndHessianMatrixImpl(size_t p,
+		double* gradient, double* hessian, Weights /*w*/) {
+
+	// Grouped models: per-stratum sums of x * offsExpXBeta / denominator, for the rank-one correction
+	std::vector<real> stratumSum(BaseModel::hasIndependentRows ? 0 : p, static_cast<real>(0));
+	std::vector<char> isTouched(stratumSum.size(), 0);
+	std::vector<int> touched;
+
+	auto flushStratum = [&](int stratum) {
+		const real nEvents = hNWeight[stratum];
+		for (size_t i = 0; i < touched.size(); ++i) {
+			const int a = touched[i];
+			const real scaled = nEvents * stratumSum[a];
+			for (size_t j = 0; j < touched.size(); ++j) {
+				const int b = touched[j];
+				if (a <= b) {
+					hessian[a * p + b] -= scaled * stratumSum[b];
+				}
+			}
+		}
+		for (auto a : touched) {
+			stratumSum[a] = static_cast<real>(0);
+			isTouched[a] = 0;
+		}
+		touched.clear();
+	};
+
+	for (size_t k = 0; k < K; ++k) {
+
+		const real rowGradient = fusedRowGradient[k];
+		const real rowHessian = fusedRowHessian[k];
+		const real rowMean = BaseModel::hasIndependentRows ? static_cast<real>(0) : fusedRowMean[k];
+
+		const size_t begin = fusedRowStart[k];
+		const size_t end = fusedRowStart[k + 1];
+
+		if (rowGradient != static_cast<real>(0) || rowHessian != static_cast<real>(0)) {
+			for (size_t e = begin; e < end; ++e) {
+				const int a = fusedColumn[e];
+				const real x = fusedValue[e];
+				gradient[a] += rowGradient * x;
+				const real hx = rowHessian * x;
+				double* row = hessian + a * p;
+				for (size_t f = e; f < end; ++f) {
+					row[fusedColumn[f]] += hx * fusedValue[f];
+				}
+			}
+		}
+
+		if (!BaseModel::hasIndependentRows) {
+			for (size_t e = begin; e < end; ++e) {
+				const int a = fusedColumn[e];
+				if (!isTouched[a]) {
+					isTouched[a] = 1;
+					touched.push_back(a);
+				}
+				stratumSum[a] += rowMean * fusedValue[e];
+			}
+			if (k + 1 == K || hPid[k + 1] != hPid[k]) {
+				flushStratum(hPid[k]);
+			}
+		}
+	}
+}
+
 template <class BaseModel, typename WeightType> template <typename IteratorTypeOne, class Weights>
 void ModelSpecifics<BaseModel,WeightType>::dispatchFisherInformation(int indexOne, int indexTwo, double *oinfo, Weights w) {
 	switch (modelData.getFormatType(indexTwo)) {
@@ -1083,6 +1840,9 @@ void ModelSpecifics<BaseModel,WeightType>::computeFisherInformationImpl(int inde
 template <class BaseModel,typename WeightType>
 void ModelSpecifics<BaseModel,WeightType>::computeNumeratorForGradient(int index) {
 
+	KernelProfile::Scope profile(kernelProfile, KernelProfile::NUMERATOR_FOR_GRADIENT,
+		kernelProfile.getEnabled() ? getColumnBytes(index, 3) : 0);
+
 #ifdef CYCLOPS_DEBUG_TIMING
 #ifndef CYCLOPS_DEBUG_TIMING_LOW
 	auto start = bsccs::chrono::steady_clock::now();
@@ -1269,6 +2029,9 @@ using namespace std;
 template <class BaseModel,typename WeightType>
 void ModelSpecifics<BaseModel,WeightType>::updateXBeta(real realDelta, int index, bool useWeights) {
 
+	KernelProfile::Scope profile(kernelProfile, KernelProfile::UPDATE_XBETA,
+		kernelProfile.getEnabled() ? getColumnBytes(index, 3) : 0);
+
 #ifdef CYCLOPS_DEBUG_TIMING
 #ifndef CYCLOPS_DEBUG_TIMING_LOW
 	auto start = bsccs::chrono::steady_clock::now();
@@ -1316,16 +2079,34 @@ inline void ModelSpecifics<BaseModel,WeightType>::updateXBetaImpl(real realDelta
 // #ifdef NEW_LOOPS
 
 #if 1
+	if (!BaseModel::likelihoodHasDenominator) { // Compile-time switch
+		// Only X beta changes, which is a plain (indexed) axpy
+		updateXBetaVectorized<IteratorType>(realDelta, index);
+	} else if (useDenseKernels<IteratorType>() && getRowCountsForDenominator() == nullptr) {
+		updateXBetaDense<IteratorType>(realDelta, index);
+	} else {
+
 	auto range = helper::getRangeX(modelData, index, typename IteratorType::tag());
 
-	auto kernel = UpdateXBetaKernel<BaseModel,IteratorType,real,int>(
-					realDelta, begin(offsExpXBeta), begin(hXBeta),
+	auto kernel = UpdateXBetaKernel<BaseModel,IteratorType,real,int,WeightType>(
+					realDelta, offsExpXBeta.data(), begin(hXBeta),
 					begin(hY),
 					begin(hPid),
-					begin(denomPid),
-					begin(hOffs)
+					denomPid.data(),
+					begin(hOffs),
+					getRowCountsForDenominator()
 					);
 
+	if (!BaseModel::hasIndependentRows && useStratumBlocks(modelData.getNumberOfNonZeroEntries(index))) {
+		// Rows of a block only touch the block's own strata in denomPid
+		forEachStratumBlock([&](size_t b) {
+			const size_t first = getEntryOffset<IteratorType>(index, stratumBlocks[b].rowBegin);
+			const size_t last = getEntryOffset<IteratorType>(index, stratumBlocks[b].rowEnd);
+			auto blockKernel = kernel;
+			variants::for_each(range.begin() + first, range.begin() + last,
+				blockKernel, SerialOnly());
+		});
+	} else {
 
 	variants::for_each(
 		range.begin(), range.end(),
@@ -1335,6 +2116,8 @@ inline void ModelSpecifics<BaseModel,WeightType>::updateXBetaImpl(real realDelta
 // 		RcppParallel() // TODO Currently *not* thread-safe
           SerialOnly()
 		);
+	}
+	}
 
 #else
 
@@ -1428,19 +2211,97 @@ inline void ModelSpecifics<BaseModel,WeightType>::updateXBetaImpl(real realDelta
 
 }
 
+template <class BaseModel,typename WeightType> template <class IteratorType>
+void ModelSpecifics<BaseModel,WeightType>::updateXBetaVectorized(real delta, int index) {
+	if (IteratorType::isSparse) {
+		const size_t n = modelData.getNumberOfEntries(index);
+		const int* rows = modelData.getCompressedColumnVector(index);
+		if (IteratorType::isIndicator) {
+			simd::addIndexed(n, delta, rows, hXBeta.data());
+		} else {
+			simd::axpyIndexed(n, delta, modelData.getDataVector(index), rows, hXBeta.data());
+		}
+	} else {
+		if (IteratorType::isIndicator) { // INTERCEPT
+			simd::add(K, delta, hXBeta.data());
+		} else {
+			const size_t n = std::min(K, modelData.getDataVectorSTL(index).size());
+			simd::axpy(n, delta, modelData.getDataVector(index), hXBeta.data());
+		}
+	}
+}
+
+template <class BaseModel,typename WeightType> template <class IteratorType>
+bool ModelSpecifics<BaseModel,WeightType>::useDenseKernels() const {
+	// SCALAR keeps the generic kernels, which the vector kernels are validated against
+	return BaseModel::denseKernel != simd::DenseKernel::NONE && !IteratorType::isSparse
+			&& std::is_same<WeightType, double>::value
+			&& simd::getInstructionSet() != simd::InstructionSet::SCALAR;
+}
+
+template <class BaseModel,typename WeightType> template <class IteratorType, class Weights>
+void ModelSpecifics<BaseModel,WeightType>::computeGradientAndHessianDense(int index,
+		real* gradient, real* hessian, Weights /*w*/) {
+	const bool hasX = !IteratorType::isIndicator; // INTERCEPT columns have no data
+	const size_t n = hasX ? std::min(K, modelData.getDataVectorSTL(index).size()) : K;
+	const real* x = hasX ? modelData.getDataVector(index) : nullptr;
+	const WeightType* weight = Weights::isWeighted ? hNWeight.data() : nullptr;
+
+	if (BaseModel::denseKernel == simd::DenseKernel::LOGISTIC) {
+		simd::logisticGradientAndHessian<hasX, Weights::isWeighted>(n, offsExpXBeta.data(),
+				denomPid.data(), x, weight, gradient, hessian);
+	} else {
+		simd::poissonGradientAndHessian<hasX, Weights::isWeighted>(n, offsExpXBeta.data(),
+				x, weight, gradient, hessian);
+	}
+}
+
+template <class BaseModel,typename WeightType> template <class IteratorType>
+void ModelSpecifics<BaseModel,WeightType>::updateXBetaDense(real delta, int index) {
+	// Rows are independent, so denomPid[k] tracks row k.  Each chunk stays in cache across the
+	// X beta axpy, the removal of the old exp(X beta), the bulk exp and the addition of the new one.
+	const bool hasX = !IteratorType::isIndicator;
+	const size_t n = hasX ? std::min(K, modelData.getDataVectorSTL(index).size()) : K;
+	const real* x = hasX ? modelData.getDataVector(index) : nullptr;
+	real* xBeta = hXBeta.data();
+	WeightType* expXBeta = offsExpXBeta.data();
+	WeightType* denominator = denomPid.data();
+
+	const size_t chunkSize = 512;
+	for (size_t begin = 0; begin < n; begin += chunkSize) {
+		const size_t length = std::min(chunkSize, n - begin);
+		if (hasX) {
+			simd::axpy(length, delta, x + begin, xBeta + begin);
+		} else {
+			simd::add(length, delta, xBeta + begin);
+		}
+		simd::axpy(length, static_cast<WeightType>(-1), expXBeta + begin, denominator + begin);
+		fastmath::exp(length, xBeta + begin, expXBeta + begin);
+		simd::axpy(length, static_cast<WeightType>(1), expXBeta + begin, denominator + begin);
+	}
+}
+
 template <class BaseModel,typename WeightType>
 void ModelSpecifics<BaseModel,WeightType>::computeRemainingStatistics(bool useWeights) {
 
+	KernelProfile::Scope profile(kernelProfile, KernelProfile::REMAINING_STATISTICS,
+		K * (sizeof(real) * 2 + sizeof(WeightType)) + N * sizeof(WeightType));
+
 #ifdef CYCLOPS_DEBUG_TIMING
 	auto start = bsccs::chrono::steady_clock::now();
 #endif
 
 
 	if (BaseModel::likelihoodHasDenominator) {
-		fillVector(denomPid.data(), N, BaseModel::getDenomNullValue());
-		for (size_t k = 0; k < K; ++k) {
-			offsExpXBeta[k] = BaseModel::getOffsExpXBeta(hOffs.data(), hXBeta[k], hY[k], k);
-			incrementByGroup(denomPid.data(), hPid, k, offsExpXBeta[k]);
+		if (!BaseModel::hasIndependentRows && useStratumBlocks(K)) {
+			// Blocks own disjoint strata, so each writes its own slice of denomPid
+			forEachStratumBlock([this](size_t b) {
+				const StratumBlock& block = stratumBlocks[b];
+				computeRemainingStatistics(block.rowBegin, block.rowEnd,
+					block.stratumBegin, block.stratumEnd);
+			});
+		} else {
+			computeRemainingStatistics(0, K, 0, N);
 		}
 		computeAccumlatedDenominator(useWeights); // WAS computeAccumlatedNumerDenom
 	}
@@ -1461,11 +2322,37 @@ void ModelSpecifics<BaseModel,WeightType>::computeRemainingStatistics(bool useWe
 
 }
 
+template <class BaseModel,typename WeightType>
+void ModelSpecifics<BaseModel,WeightType>::computeRemainingStatistics(size_t rowBegin, size_t rowEnd,
+		int stratumBegin, int stratumEnd) {
+
+	fillVector(denomPid.data() + stratumBegin, stratumEnd - stratumBegin,
+		static_cast<WeightType>(BaseModel::getDenomNullValue()));
+	// Bulk transform; equivalent to BaseModel::getOffsExpXBeta() for every row
+	fastmath::exp(rowEnd - rowBegin, hXBeta.data() + rowBegin, offsExpXBeta.data() + rowBegin);
+	if (BaseModel::offsetScalesExpXBeta) {
+		for (size_t k = rowBegin; k < rowEnd; ++k) {
+			offsExpXBeta[k] *= hOffs[k];
+		}
+	}
+	if (const real* counts = getRowCountsForDenominator()) {
+		for (size_t k = rowBegin; k < rowEnd; ++k) {
+			offsExpXBeta[k] *= counts[k];
+		}
+	}
+	for (size_t k = rowBegin; k < rowEnd; ++k) {
+		incrementByGroup(denomPid.data(), hPid, k, offsExpXBeta[k]);
+	}
+}
+
 template <class BaseModel,typename WeightType>
 void ModelSpecifics<BaseModel,WeightType>::computeAccumlatedNumerator(bool useWeights) {
 
 	if (BaseModel::likelihoodHasDenominator && //The two switches should ideally be separated
 			BaseModel::cumulativeGradientAndHessian) { // Compile-time switch
+
+		KernelProfile::Scope profile(kernelProfile, KernelProfile::ACCUMULATION,
+			N * (2 * sizeof(WeightType) + 2 * sizeof(real)));
 		if (accNumerPid.size() != N) {
 			accNumerPid.resize(N, static_cast<real>(0));
 		}
@@ -1500,6 +2387,9 @@ void ModelSpecifics<BaseModel,WeightType>::computeAccumlatedDenominator(bool use
 
 	if (BaseModel::likelihoodHasDenominator && //The two switches should ideally be separated
 		BaseModel::cumulativeGradientAndHessian) { // Compile-time switch
+
+			KernelProfile::Scope profile(kernelProfile, KernelProfile::ACCUMULATION,
+				N * (sizeof(WeightType) + sizeof(real)));
 			if (accDenomPid.size() != (N + 1)) {
 				accDenomPid.resize(N + 1, static_cast<real>(0));
 			}
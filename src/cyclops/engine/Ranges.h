@@ -76,7 +76,8 @@ namespace helper {
         };
     }
 
-    auto getRangeAllNumerators(const int length, const RealVector& y, const RealVector& xBeta, const RealVector& weight) ->
+    template <class WeightType>
+    auto getRangeAllNumerators(const int length, const RealVector& y, const RealVector& xBeta, const WeightType& weight) ->
     		boost::iterator_range<
     			boost::zip_iterator<
     				boost::tuple<
@@ -103,7 +104,8 @@ namespace helper {
     	};
     }
 
-    auto getRangeAllDenominators(const int length, const RealVector& denominator, const RealVector& weight) ->
+    template <class DenominatorType, class WeightType>
+    auto getRangeAllDenominators(const int length, const DenominatorType& denominator, const WeightType& weight) ->
     		boost::iterator_range<
     			boost::zip_iterator<
     				boost::tuple<
@@ -154,8 +156,9 @@ namespace helper {
 //     	};
 //     }
 
+    template <class DenominatorType>
     auto getRangeAllPredictiveLikelihood(const int length, const RealVector& y, const RealVector& xBeta,
-            const RealVector& denominator, const real* weights, const int* pid, std::true_type) ->
+            const DenominatorType& denominator, const real* weights, const int* /*pid*/, std::true_type) ->
 
         boost::iterator_range<
             boost::zip_iterator<
@@ -186,8 +189,9 @@ namespace helper {
         };
     }
 
+    template <class DenominatorType>
     auto getRangeAllPredictiveLikelihood(const int length, const RealVector& y, const RealVector& xBeta,
-            const RealVector& denominator, const real* weights, const int* pid, std::false_type) ->
+            const DenominatorType& denominator, const real* weights, const int* pid, std::false_type) ->
 
         boost::iterator_range<
             boost::zip_iterator<
@@ -227,12 +231,9 @@ namespace helper {
 
 namespace independent {
 
-//    template <class ExpXBetaType, class XBetaType, class YType, class DenominatorType, class WeightType>
+    template <class ExpXBetaType, class XBetaType, class YType, class DenominatorType, class WeightType>
     auto getRangeX(const CompressedDataMatrix& mat, const int index,
-//    			ExpXBetaType& expXBeta, XBetaType& xBeta, YType& y, DenominatorType& denominator, WeightType& weight,
-  					RealVector& expXBeta, RealVector& xBeta, const RealVector& y,
-  					RealVector& denominator,
-  					RealVector& weight,
+  					ExpXBetaType& expXBeta, XBetaType& xBeta, YType& y, DenominatorType& denominator, WeightType& weight,
   					IndicatorIterator::tag) ->
 
  			boost::iterator_range<
@@ -314,12 +315,9 @@ namespace independent {
         };
  	}
 
-//    template <class ExpXBetaType, class XBetaType, class YType, class DenominatorType, class WeightType>
+    template <class ExpXBetaType, class XBetaType, class YType, class DenominatorType, class WeightType>
     auto getRangeX(const CompressedDataMatrix& mat, const int index,
-//    			ExpXBetaType& expXBeta, XBetaType& xBeta, YType& y, DenominatorType& denominator, WeightType& weight,
-  					RealVector& expXBeta, RealVector& xBeta, const RealVector& y,
-  					RealVector& denominator,
-  					RealVector& weight,
+  					ExpXBetaType& expXBeta, XBetaType& xBeta, YType& y, DenominatorType& denominator, WeightType& weight,
   					SparseIterator::tag) ->
 
  			boost::iterator_range<
@@ -405,12 +403,9 @@ namespace independent {
         };
  	}
 
-//	template <class ExpXBetaType, class XBetaType, class YType, class DenominatorType, class WeightType>
+    template <class ExpXBetaType, class XBetaType, class YType, class DenominatorType, class WeightType>
     auto getRangeX(const CompressedDataMatrix& mat, const int index,
-//    			ExpXBetaType& expXBeta, XBetaType& xBeta, YType& y, DenominatorType& denominator, WeightType& weight,
-  					RealVector& expXBeta, RealVector& xBeta, const RealVector& y,
-  					RealVector& denominator,
-  					RealVector& weight,
+  					ExpXBetaType& expXBeta, XBetaType& xBeta, YType& y, DenominatorType& denominator, WeightType& weight,
   					DenseIterator::tag) ->
 
  			boost::iterator_range<
@@ -454,12 +449,9 @@ namespace independent {
         };
     }
 
-//	template <class ExpXBetaType, class XBetaType, class YType, class DenominatorType, class WeightType>
+    template <class ExpXBetaType, class XBetaType, class YType, class DenominatorType, class WeightType>
     auto getRangeX(const CompressedDataMatrix& mat, const int index,
-//    			ExpXBetaType& expXBeta, XBetaType& xBeta, YType& y, DenominatorType& denominator, WeightType& weight,
-  					RealVector& expXBeta, RealVector& xBeta, const RealVector& y,
-  					RealVector& denominator,
-  					RealVector& weight,
+  					ExpXBetaType& expXBeta, XBetaType& xBeta, YType& y, DenominatorType& denominator, WeightType& weight,
   					InterceptIterator::tag) ->
 
  			boost::iterator_range<
@@ -502,9 +494,10 @@ namespace independent {
         };
     }
 
+    template <class ExpXBetaType, class DenominatorType>
     auto getRangeXBeta(const CompressedDataMatrix& mat, const int index,
-  					RealVector& expXBeta, RealVector& xBeta,
-  					RealVector& denominator,
+  					ExpXBetaType& expXBeta, RealVector& xBeta,
+  					DenominatorType& denominator,
   					const RealVector& offs,
   					IndicatorIterator::tag) ->
 
@@ -575,9 +568,10 @@ namespace independent {
         };
  	}
 
+    template <class ExpXBetaType, class DenominatorType>
     auto getRangeXBeta(const CompressedDataMatrix& mat, const int index,
-  					RealVector& expXBeta, RealVector& xBeta,
-  					RealVector& denominator,
+  					ExpXBetaType& expXBeta, RealVector& xBeta,
+  					DenominatorType& denominator,
   					const RealVector& offs,
   					SparseIterator::tag) ->
 
@@ -653,9 +647,10 @@ namespace independent {
         };
  	}
 
+    template <class ExpXBetaType, class DenominatorType>
     auto getRangeXBeta(const CompressedDataMatrix& mat, const int index,
-  					RealVector& expXBeta, RealVector& xBeta,
-  					RealVector& denominator,
+  					ExpXBetaType& expXBeta, RealVector& xBeta,
+  					DenominatorType& denominator,
   					const RealVector& offs,
   					DenseIterator::tag) ->
 
@@ -778,10 +773,9 @@ namespace dependent {
         };
     }
 
-//    template <class ExpXBeta> // For dense
+    template <class ExpXBeta> // For dense
     auto getRangeX(const CompressedDataMatrix& mat, const int index,
-                //ExpXBeta&
-                RealVector&
+                ExpXBeta&
                 expXBeta, DenseIterator::tag) ->
             boost::iterator_range<
                 boost::zip_iterator<
@@ -805,10 +799,9 @@ namespace dependent {
         };
     }
 
-//    template <class ExpXBeta> // For sparse
+    template <class ExpXBeta> // For sparse
     auto getRangeX(const CompressedDataMatrix& mat, const int index,
-                //ExpXBeta&
-                RealVector&
+                ExpXBeta&
                 expXBeta, SparseIterator::tag) ->
             boost::iterator_range<
                 boost::zip_iterator<
@@ -838,10 +831,9 @@ namespace dependent {
         };
     }
 
-//    template <class ExpXBeta> // For indicator
+    template <class ExpXBeta> // For indicator
     auto getRangeX(const CompressedDataMatrix& mat, const int index,
-                //ExpXBeta&
-                RealVector&
+                ExpXBeta&
                 expXBeta, IndicatorIterator::tag) ->
             boost::iterator_range<
                 boost::zip_iterator<
@@ -868,10 +860,9 @@ namespace dependent {
         };
     }
 
-//    template <class ExpXBeta> // For intercept
+    template <class ExpXBeta> // For intercept
     auto getRangeX(const CompressedDataMatrix& mat, const int index,
-                //ExpXBeta&
-                RealVector&
+                ExpXBeta&
                 expXBeta, InterceptIterator::tag) ->
             boost::iterator_range<
                 boost::zip_iterator<
@@ -0,0 +1,567 @@
+/*
+ * Simd.h
+ *
+ * Explicitly vectorized primitives for the column kernels in ModelSpecifics.  Each primitive
+ * has AVX-512, AVX2 and SSE2 variants that are compiled via per-function target attributes
+ * (no global -m flags required) and selected at run-time from the host CPU.  Non-x86 builds,
+ * non-GNU compilers or -DCYCLOPS_NO_SIMD fall back to the scalar loops.
+ */
+
+#ifndef SIMD_H_
+#define SIMD_H_
+
+#include <cstddef>
+
+#if !defined(CYCLOPS_NO_SIMD) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+	#define CYCLOPS_SIMD_X86
+	#include <immintrin.h>
+#endif
+
+namespace bsccs {
+
+namespace simd {
+
+enum class InstructionSet {
+	SCALAR = 0,
+	SSE2 = 1,
+	AVX2 = 2,
+	AVX512 = 3
+};
+
+// Models with explicitly vectorized DENSE/INTERCEPT gradient kernels
+enum class DenseKernel {
+	NONE = 0,
+	LOGISTIC = 1,
+	POISSON = 2
+};
+
+namespace detail {
+
+	inline InstructionSet detectInstructionSet() {
+#ifdef CYCLOPS_SIMD_X86
+		__builtin_cpu_init();
+		if (__builtin_cpu_supports("avx512f")) {
+			return InstructionSet::AVX512;
+		}
+		if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+			return InstructionSet::AVX2;
+		}
+		if (__builtin_cpu_supports("sse2")) {
+			return InstructionSet::SSE2;
+		}
+#endif
+		return InstructionSet::SCALAR;
+	}
+
+	inline InstructionSet& activeInstructionSet() {
+		static InstructionSet active = detectInstructionSet();
+		return active;
+	}
+
+} // namespace detail
+
+// Instruction set supported by the host
+inline InstructionSet getSupportedInstructionSet() {
+	static const InstructionSet supported = detail::detectInstructionSet();
+	return supported;
+}
+
+// Instruction set currently used by the kernels
+inline InstructionSet getInstructionSet() {
+	return detail::activeInstructionSet();
+}
+
+// Caps the instruction set (e.g. to validate vector kernels against SCALAR); never exceeds the host
+inline void setMaximumInstructionSet(InstructionSet maximum) {
+	const InstructionSet supported = getSupportedInstructionSet();
+	detail::activeInstructionSet() = (maximum < supported) ? maximum : supported;
+}
+
+inline const char* getInstructionSetName(InstructionSet set) {
+	switch (set) {
+		case InstructionSet::AVX512 : return "avx512";
+		case InstructionSet::AVX2 : return "avx2";
+		case InstructionSet::SSE2 : return "sse2";
+		default : return "scalar";
+	}
+}
+
+namespace scalar {
+
+	// y += a * x
+	template <typename RealType>
+	inline void axpy(size_t n, RealType a, const RealType* x, RealType* y) {
+		for (size_t i = 0; i < n; ++i) {
+			y[i] += a * x[i];
+		}
+	}
+
+	// y += a
+	template <typename RealType>
+	inline void add(size_t n, RealType a, RealType* y) {
+		for (size_t i = 0; i < n; ++i) {
+			y[i] += a;
+		}
+	}
+
+	// y[idx] += a * x
+	template <typename RealType>
+	inline void axpyIndexed(size_t n, RealType a, const RealType* x, const int* idx, RealType* y) {
+		for (size_t i = 0; i < n; ++i) {
+			y[idx[i]] += a * x[i];
+		}
+	}
+
+	// y[idx] += a
+	template <typename RealType>
+	inline void addIndexed(size_t n, RealType a, const int* idx, RealType* y) {
+		for (size_t i = 0; i < n; ++i) {
+			y[idx[i]] += a;
+		}
+	}
+
+	// dst = src[idx]
+	template <typename RealType>
+	inline void gather(size_t n, const RealType* src, const int* idx, RealType* dst) {
+		for (size_t i = 0; i < n; ++i) {
+			dst[i] = src[idx[i]];
+		}
+	}
+
+	// Logistic gradient and Hessian over rows [0, n): g = e x / d, adds w g and w (e x^2 / d - g^2);
+	// without x (INTERCEPT) the Hessian term is w g (1 - g).  Weights are skipped when unweighted.
+	template <bool hasX, bool isWeighted, typename StorageType, typename RealType>
+	inline void logisticGradientAndHessian(size_t n, const StorageType* expXBeta,
+			const StorageType* denominator, const RealType* x, const StorageType* weight,
+			RealType* gradient, RealType* hessian) {
+		RealType g = 0, h = 0;
+		for (size_t i = 0; i < n; ++i) {
+			const RealType numerator = hasX ? expXBeta[i] * x[i] : expXBeta[i];
+			const RealType t = numerator / denominator[i];
+			const RealType ht = hasX ? numerator * x[i] / denominator[i] - t * t :
+					t * (static_cast<RealType>(1) - t);
+			g += isWeighted ? weight[i] * t : t;
+			h += isWeighted ? weight[i] * ht : ht;
+		}
+		*gradient += g;
+		*hessian += h;
+	}
+
+	// Poisson gradient and Hessian over rows [0, n): adds w e x and w e x^2 (w e for both
+	// without x)
+	template <bool hasX, bool isWeighted, typename StorageType, typename RealType>
+	inline void poissonGradientAndHessian(size_t n, const StorageType* expXBeta,
+			const RealType* x, const StorageType* weight, RealType* gradient, RealType* hessian) {
+		RealType g = 0, h = 0;
+		for (size_t i = 0; i < n; ++i) {
+			const RealType numerator = hasX ? expXBeta[i] * x[i] : expXBeta[i];
+			const RealType numerator2 = hasX ? numerator * x[i] : numerator;
+			g += isWeighted ? weight[i] * numerator : numerator;
+			h += isWeighted ? weight[i] * numerator2 : numerator2;
+		}
+		*gradient += g;
+		*hessian += h;
+	}
+
+} // namespace scalar
+
+#ifdef CYCLOPS_SIMD_X86
+
+namespace sse2 {
+
+	__attribute__((target("sse2")))
+	inline void axpy(size_t n, double a, const double* x, double* y) {
+		const __m128d va = _mm_set1_pd(a);
+		size_t i = 0;
+		for (; i + 2 <= n; i += 2) {
+			_mm_storeu_pd(y + i, _mm_add_pd(_mm_loadu_pd(y + i), _mm_mul_pd(va, _mm_loadu_pd(x + i))));
+		}
+		scalar::axpy(n - i, a, x + i, y + i);
+	}
+
+	__attribute__((target("sse2")))
+	inline void add(size_t n, double a, double* y) {
+		const __m128d va = _mm_set1_pd(a);
+		size_t i = 0;
+		for (; i + 2 <= n; i += 2) {
+			_mm_storeu_pd(y + i, _mm_add_pd(_mm_loadu_pd(y + i), va));
+		}
+		scalar::add(n - i, a, y + i);
+	}
+
+} // namespace sse2
+
+namespace avx2 {
+
+	__attribute__((target("avx2,fma")))
+	inline void axpy(size_t n, double a, const double* x, double* y) {
+		const __m256d va = _mm256_set1_pd(a);
+		size_t i = 0;
+		for (; i + 4 <= n; i += 4) {
+			_mm256_storeu_pd(y + i, _mm256_fmadd_pd(va, _mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i)));
+		}
+		scalar::axpy(n - i, a, x + i, y + i);
+	}
+
+	__attribute__((target("avx2,fma")))
+	inline void add(size_t n, double a, double* y) {
+		const __m256d va = _mm256_set1_pd(a);
+		size_t i = 0;
+		for (; i + 4 <= n; i += 4) {
+			_mm256_storeu_pd(y + i, _mm256_add_pd(_mm256_loadu_pd(y + i), va));
+		}
+		scalar::add(n - i, a, y + i);
+	}
+
+	// AVX2 has gathers but no scatters; gather, update and store lane-by-lane
+	__attribute__((target("avx2,fma")))
+	inline void axpyIndexed(size_t n, double a, const double* x, const int* idx, double* y) {
+		const __m256d va = _mm256_set1_pd(a);
+		double lanes[4];
+		size_t i = 0;
+		for (; i + 4 <= n; i += 4) {
+			const __m128i vi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(idx + i));
+			const __m256d vy = _mm256_i32gather_pd(y, vi, 8);
+			_mm256_storeu_pd(lanes, _mm256_fmadd_pd(va, _mm256_loadu_pd(x + i), vy));
+			y[idx[i]] = lanes[0]; y[idx[i + 1]] = lanes[1];
+			y[idx[i + 2]] = lanes[2]; y[idx[i + 3]] = lanes[3];
+		}
+		scalar::axpyIndexed(n - i, a, x + i, idx + i, y);
+	}
+
+	__attribute__((target("avx2,fma")))
+	inline void gather(size_t n, const double* src, const int* idx, double* dst) {
+		size_t i = 0;
+		for (; i + 4 <= n; i += 4) {
+			const __m128i vi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(idx + i));
+			_mm256_storeu_pd(dst + i, _mm256_i32gather_pd(src, vi, 8));
+		}
+		scalar::gather(n - i, src, idx + i, dst + i);
+	}
+
+	__attribute__((target("avx2,fma")))
+	inline double horizontalSum(__m256d v) {
+		const __m128d sum = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+		return _mm_cvtsd_f64(_mm_add_sd(sum, _mm_unpackhi_pd(sum, sum)));
+	}
+
+	template <bool hasX, bool isWeighted>
+	__attribute__((target("avx2,fma")))
+	inline void logisticGradientAndHessian(size_t n, const double* expXBeta,
+			const double* denominator, const double* x, const double* weight,
+			double* gradient, double* hessian) {
+		const __m256d one = _mm256_set1_pd(1.0);
+		__m256d vg = _mm256_setzero_pd();
+		__m256d vh = _mm256_setzero_pd();
+		size_t i = 0;
+		for (; i + 4 <= n; i += 4) {
+			const __m256d d = _mm256_loadu_pd(denominator + i);
+			__m256d numerator = _mm256_loadu_pd(expXBeta + i);
+			if (hasX) {
+				numerator = _mm256_mul_pd(numerator, _mm256_loadu_pd(x + i));
+			}
+			const __m256d t = _mm256_div_pd(numerator, d);
+			const __m256d ht = hasX ?
+					_mm256_fnmadd_pd(t, t, _mm256_div_pd(_mm256_mul_pd(numerator, _mm256_loadu_pd(x + i)), d)) :
+					_mm256_mul_pd(t, _mm256_sub_pd(one, t));
+			if (isWeighted) {
+				const __m256d w = _mm256_loadu_pd(weight + i);
+				vg = _mm256_fmadd_pd(w, t, vg);
+				vh = _mm256_fmadd_pd(w, ht, vh);
+			} else {
+				vg = _mm256_add_pd(vg, t);
+				vh = _mm256_add_pd(vh, ht);
+			}
+		}
+		*gradient += horizontalSum(vg);
+		*hessian += horizontalSum(vh);
+		scalar::logisticGradientAndHessian<hasX, isWeighted>(n - i, expXBeta + i, denominator + i,
+				hasX ? x + i : x, isWeighted ? weight + i : weight, gradient, hessian);
+	}
+
+	template <bool hasX, bool isWeighted>
+	__attribute__((target("avx2,fma")))
+	inline void poissonGradientAndHessian(size_t n, const double* expXBeta,
+			const double* x, const double* weight, double* gradient, double* hessian) {
+		__m256d vg = _mm256_setzero_pd();
+		__m256d vh = _mm256_setzero_pd();
+		size_t i = 0;
+		for (; i + 4 <= n; i += 4) {
+			__m256d numerator = _mm256_loadu_pd(expXBeta + i);
+			__m256d numerator2 = numerator;
+			if (hasX) {
+				const __m256d vx = _mm256_loadu_pd(x + i);
+				numerator = _mm256_mul_pd(numerator, vx);
+				numerator2 = _mm256_mul_pd(numerator, vx);
+			}
+			if (isWeighted) {
+				const __m256d w = _mm256_loadu_pd(weight + i);
+				vg = _mm256_fmadd_pd(w, numerator, vg);
+				vh = _mm256_fmadd_pd(w, numerator2, vh);
+			} else {
+				vg = _mm256_add_pd(vg, numerator);
+				vh = _mm256_add_pd(vh, numerator2);
+			}
+		}
+		*gradient += horizontalSum(vg);
+		*hessian += horizontalSum(vh);
+		scalar::poissonGradientAndHessian<hasX, isWeighted>(n - i, expXBeta + i,
+				hasX ? x + i : x, isWeighted ? weight + i : weight, gradient, hessian);
+	}
+
+} // namespace avx2
+
+namespace avx512 {
+
+	__attribute__((target("avx512f")))
+	inline void axpy(size_t n, double a, const double* x, double* y) {
+		const __m512d va = _mm512_set1_pd(a);
+		size_t i = 0;
+		for (; i + 8 <= n; i += 8) {
+			_mm512_storeu_pd(y + i, _mm512_fmadd_pd(va, _mm512_loadu_pd(x + i), _mm512_loadu_pd(y + i)));
+		}
+		scalar::axpy(n - i, a, x + i, y + i);
+	}
+
+	__attribute__((target("avx512f")))
+	inline void add(size_t n, double a, double* y) {
+		const __m512d va = _mm512_set1_pd(a);
+		size_t i = 0;
+		for (; i + 8 <= n; i += 8) {
+			_mm512_storeu_pd(y + i, _mm512_add_pd(_mm512_loadu_pd(y + i), va));
+		}
+		scalar::add(n - i, a, y + i);
+	}
+
+	// Row indices within a column are unique, so scatters never conflict
+	__attribute__((target("avx512f")))
+	inline void axpyIndexed(size_t n, double a, const double* x, const int* idx, double* y) {
+		const __m512d va = _mm512_set1_pd(a);
+		size_t i = 0;
+		for (; i + 8 <= n; i += 8) {
+			const __m256i vi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(idx + i));
+			const __m512d vy = _mm512_i32gather_pd(vi, y, 8);
+			_mm512_i32scatter_pd(y, vi, _mm512_fmadd_pd(va, _mm512_loadu_pd(x + i), vy), 8);
+		}
+		scalar::axpyIndexed(n - i, a, x + i, idx + i, y);
+	}
+
+	__attribute__((target("avx512f")))
+	inline void addIndexed(size_t n, double a, const int* idx, double* y) {
+		const __m512d va = _mm512_set1_pd(a);
+		size_t i = 0;
+		for (; i + 8 <= n; i += 8) {
+			const __m256i vi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(idx + i));
+			_mm512_i32scatter_pd(y, vi, _mm512_add_pd(_mm512_i32gather_pd(vi, y, 8), va), 8);
+		}
+		scalar::addIndexed(n - i, a, idx + i, y);
+	}
+
+	__attribute__((target("avx512f")))
+	inline void gather(size_t n, const double* src, const int* idx, double* dst) {
+		size_t i = 0;
+		for (; i + 8 <= n; i += 8) {
+			const __m256i vi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(idx + i));
+			_mm512_storeu_pd(dst + i, _mm512_i32gather_pd(vi, src, 8));
+		}
+		scalar::gather(n - i, src, idx + i, dst + i);
+	}
+
+	template <bool hasX, bool isWeighted>
+	__attribute__((target("avx512f")))
+	inline void logisticGradientAndHessian(size_t n, const double* expXBeta,
+			const double* denominator, const double* x, const double* weight,
+			double* gradient, double* hessian) {
+		const __m512d one = _mm512_set1_pd(1.0);
+		__m512d vg = _mm512_setzero_pd();
+		__m512d vh = _mm512_setzero_pd();
+		size_t i = 0;
+		for (; i + 8 <= n; i += 8) {
+			const __m512d d = _mm512_loadu_pd(denominator + i);
+			__m512d numerator = _mm512_loadu_pd(expXBeta + i);
+			if (hasX) {
+				numerator = _mm512_mul_pd(numerator, _mm512_loadu_pd(x + i));
+			}
+			const __m512d t = _mm512_div_pd(numerator, d);
+			const __m512d ht = hasX ?
+					_mm512_fnmadd_pd(t, t, _mm512_div_pd(_mm512_mul_pd(numerator, _mm512_loadu_pd(x + i)), d)) :
+					_mm512_mul_pd(t, _mm512_sub_pd(one, t));
+			if (isWeighted) {
+				const __m512d w = _mm512_loadu_pd(weight + i);
+				vg = _mm512_fmadd_pd(w, t, vg);
+				vh = _mm512_fmadd_pd(w, ht, vh);
+			} else {
+				vg = _mm512_add_pd(vg, t);
+				vh = _mm512_add_pd(vh, ht);
+			}
+		}
+		*gradient += _mm512_reduce_add_pd(vg);
+		*hessian += _mm512_reduce_add_pd(vh);
+		scalar::logisticGradientAndHessian<hasX, isWeighted>(n - i, expXBeta + i, denominator + i,
+				hasX ? x + i : x, isWeighted ? weight + i : weight, gradient, hessian);
+	}
+
+	template <bool hasX, bool isWeighted>
+	__attribute__((target("avx512f")))
+	inline void poissonGradientAndHessian(size_t n, const double* expXBeta,
+			const double* x, const double* weight, double* gradient, double* hessian) {
+		__m512d vg = _mm512_setzero_pd();
+		__m512d vh = _mm512_setzero_pd();
+		size_t i = 0;
+		for (; i + 8 <= n; i += 8) {
+			__m512d numerator = _mm512_loadu_pd(expXBeta + i);
+			__m512d numerator2 = numerator;
+			if (hasX) {
+				const __m512d vx = _mm512_loadu_pd(x + i);
+				numerator = _mm512_mul_pd(numerator, vx);
+				numerator2 = _mm512_mul_pd(numerator, vx);
+			}
+			if (isWeighted) {
+				const __m512d w = _mm512_loadu_pd(weight + i);
+				vg = _mm512_fmadd_pd(w, numerator, vg);
+				vh = _mm512_fmadd_pd(w, numerator2, vh);
+			} else {
+				vg = _mm512_add_pd(vg, numerator);
+				vh = _mm512_add_pd(vh, numerator2);
+			}
+		}
+		*gradient += _mm512_reduce_add_pd(vg);
+		*hessian += _mm512_reduce_add_pd(vh);
+		scalar::poissonGradientAndHessian<hasX, isWeighted>(n - i, expXBeta + i,
+				hasX ? x + i : x, isWeighted ? weight + i : weight, gradient, hessian);
+	}
+
+} // namespace avx512
+
+#endif // CYCLOPS_SIMD_X86
+
+// Run-time dispatched entry points; non-double types use the scalar loops
+
+template <typename RealType>
+inline void axpy(size_t n, RealType a, const RealType* x, RealType* y) {
+	scalar::axpy(n, a, x, y);
+}
+
+template <typename RealType>
+inline void add(size_t n, RealType a, RealType* y) {
+	scalar::add(n, a, y);
+}
+
+template <typename RealType>
+inline void axpyIndexed(size_t n, RealType a, const RealType* x, const int* idx, RealType* y) {
+	scalar::axpyIndexed(n, a, x, idx, y);
+}
+
+template <typename RealType>
+inline void addIndexed(size_t n, RealType a, const int* idx, RealType* y) {
+	scalar::addIndexed(n, a, idx, y);
+}
+
+template <typename RealType>
+inline void gather(size_t n, const RealType* src, const int* idx, RealType* dst) {
+	scalar::gather(n, src, idx, dst);
+}
+
+template <bool hasX, bool isWeighted, typename StorageType, typename RealType>
+inline void logisticGradientAndHessian(size_t n, const StorageType* expXBeta,
+		const StorageType* denominator, const RealType* x, const StorageType* weight,
+		RealType* gradient, RealType* hessian) {
+	scalar::logisticGradientAndHessian<hasX, isWeighted>(n, expXBeta, denominator, x, weight,
+			gradient, hessian);
+}
+
+template <bool hasX, bool isWeighted, typename StorageType, typename RealType>
+inline void poissonGradientAndHessian(size_t n, const StorageType* expXBeta,
+		const RealType* x, const StorageType* weight, RealType* gradient, RealType* hessian) {
+	scalar::poissonGradientAndHessian<hasX, isWeighted>(n, expXBeta, x, weight, gradient, hessian);
+}
+
+#ifdef CYCLOPS_SIMD_X86
+
+template <>
+inline void axpy<double>(size_t n, double a, const double* x, double* y) {
+	switch (getInstructionSet()) {
+		case InstructionSet::AVX512 : avx512::axpy(n, a, x, y); break;
+		case InstructionSet::AVX2 : avx2::axpy(n, a, x, y); break;
+		case InstructionSet::SSE2 : sse2::axpy(n, a, x, y); break;
+		default : scalar::axpy(n, a, x, y);
+	}
+}
+
+template <>
+inline void add<double>(size_t n, double a, double* y) {
+	switch (getInstructionSet()) {
+		case InstructionSet::AVX512 : avx512::add(n, a, y); break;
+		case InstructionSet::AVX2 : avx2::add(n, a, y); break;
+		case InstructionSet::SSE2 : sse2::add(n, a, y); break;
+		default : scalar::add(n, a, y);
+	}
+}
+
+template <>
+inline void axpyIndexed<double>(size_t n, double a, const double* x, const int* idx, double* y) {
+	switch (getInstructionSet()) {
+		case InstructionSet::AVX512 : avx512::axpyIndexed(n, a, x, idx, y); break;
+		case InstructionSet::AVX2 : avx2::axpyIndexed(n, a, x, idx, y); break;
+		default : scalar::axpyIndexed(n, a, x, idx, y);
+	}
+}
+
+template <>
+inline void addIndexed<double>(size_t n, double a, const int* idx, double* y) {
+	switch (getInstructionSet()) {
+		case InstructionSet::AVX512 : avx512::addIndexed(n, a, idx, y); break;
+		default : scalar::addIndexed(n, a, idx, y); // Without scatter, gather-add-store gains nothing
+	}
+}
+
+template <>
+inline void gather<double>(size_t n, const double* src, const int* idx, double* dst) {
+	switch (getInstructionSet()) {
+		case InstructionSet::AVX512 : avx512::gather(n, src, idx, dst); break;
+		case InstructionSet::AVX2 : avx2::gather(n, src, idx, dst); break;
+		default : scalar::gather(n, src, idx, dst);
+	}
+}
+
+template <bool hasX, bool isWeighted>
+inline void logisticGradientAndHessian(size_t n, const double* expXBeta,
+		const double* denominator, const double* x, const double* weight,
+		double* gradient, double* hessian) {
+	switch (getInstructionSet()) {
+		case InstructionSet::AVX512 :
+			avx512::logisticGradientAndHessian<hasX, isWeighted>(n, expXBeta, denominator, x, weight,
+					gradient, hessian);
+			break;
+		case InstructionSet::AVX2 :
+			avx2::logisticGradientAndHessian<hasX, isWeighted>(n, expXBeta, denominator, x, weight,
+					gradient, hessian);
+			break;
+		default :
+			scalar::logisticGradientAndHessian<hasX, isWeighted>(n, expXBeta, denominator, x, weight,
+					gradient, hessian);
+	}
+}
+
+template <bool hasX, bool isWeighted>
+inline void poissonGradientAndHessian(size_t n, const double* expXBeta,
+		const double* x, const double* weight, double* gradient, double* hessian) {
+	switch (getInstructionSet()) {
+		case InstructionSet::AVX512 :
+			avx512::poissonGradientAndHessian<hasX, isWeighted>(n, expXBeta, x, weight, gradient, hessian);
+			break;
+		case InstructionSet::AVX2 :
+			avx2::poissonGradientAndHessian<hasX, isWeighted>(n, expXBeta, x, weight, gradient, hessian);
+			break;
+		default :
+			scalar::poissonGradientAndHessian<hasX, isWeighted>(n, expXBeta, x, weight, gradient, hessian);
+	}
+}
+
+#endif // CYCLOPS_SIMD_X86
+
+} // namespace simd
+
+} // namespace bsccs
+
+#endif /* SIMD_H_ */
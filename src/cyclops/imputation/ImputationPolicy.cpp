@@ -44,6 +44,13 @@ ImputationHelper::~ImputationHelper() { }
  *
 **/
 
+template <class T> void reindexVector(std::vector<T>& vec, const std::vector<int>& ind) {
+	const std::vector<T> temp = vec;
+	for (size_t i = 0; i < vec.size(); i++) {
+		vec[i] = temp[ind[i]];
+	}
+}
+
 template <class InputIterator1, class InputIterator2>
 int set_intersection(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, InputIterator2 last2)
 {
@@ -82,13 +89,12 @@ int set_difference(int* columns, int length, InputIterator first2, InputIterator
 	}
 	return result;
 }
-void ImputationHelper::sortColumns(){
+void ImputationHelper::sortColumns(std::mt19937& rng){
 	colIndices.clear();
-	srand(time(NULL));
 	vector<int> rands;
 	for(int i = 0; i < nCols_Orig; i++){
 		colIndices.push_back(i);
-		rands.push_back(rand());
+		rands.push_back(static_cast<int>(rng() >> 1));
 	}
 	sort(colIndices.begin(),colIndices.end(),Compare(nMissingPerColumn,rands));
 
@@ -98,7 +104,7 @@ void ImputationHelper::sortColumns(){
 
 	reindexVector(nMissingPerColumn,colIndices);
 
-	vector<int_vector*> missingEntries_ = missingEntries;
+	vector<IntVector*> missingEntries_ = missingEntries;
 	for(int i = 0; i < nCols_Orig; i++){
 		missingEntries[i] = missingEntries_[colIndices[i]];
 	}
@@ -107,7 +113,7 @@ void ImputationHelper::sortColumns(){
 void ImputationHelper::resortColumns(){
 	reindexVector(nMissingPerColumn,reverseColIndices);
 
-	vector<int_vector*> missingEntries_ = missingEntries;
+	vector<IntVector*> missingEntries_ = missingEntries;
 	for(int i = 0; i < nCols_Orig; i++){
 		missingEntries[i] = missingEntries_[reverseColIndices[i]];
 	}
@@ -120,7 +126,7 @@ void ImputationHelper::resortColumns(){
 	reverseColIndices = colIndices;
 }
 
-void ImputationHelper::push_back(int_vector* vecMissing, int nMissing){
+void ImputationHelper::push_back(IntVector* vecMissing, int nMissing){
 	missingEntries.push_back(vecMissing);
 	nMissingPerColumn.push_back(nMissing);
 	nCols_Orig++;
@@ -173,7 +179,7 @@ vector<real> ImputationHelper::getOrigYVector(){
 	return y_Orig;
 }
 
-void ImputationHelper::saveOrigYVector(real* y, int nRows){
+void ImputationHelper::saveOrigYVector(const real* y, int nRows){
 	y_Orig.resize(nRows,0.0);
 	for(int i = 0; i < nRows; i++)
 		y_Orig[i] = y[i];
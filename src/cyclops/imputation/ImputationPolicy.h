@@ -8,6 +8,8 @@
 #ifndef ImputationHelper_H_
 #define ImputationHelper_H_
 
+#include <random>
+
 #include "io/InputReader.h"
 
 namespace bsccs {
@@ -30,7 +32,7 @@ public:
 	ImputationHelper();
 	virtual ~ImputationHelper();
 
-	void sortColumns();
+	void sortColumns(std::mt19937& rng);
 	void resortColumns();
 	void push_back(IntVector* vecMissing,int nMissing);
 	void push_back(int col, int indMissing);
@@ -41,7 +43,7 @@ public:
 	const vector<int>& getSortedColIndices() const;
 	const vector<int>& getReverseColIndices() const;
 	void setWeightsForImputation(int col, vector<real>& weights, int nRows);
-	void saveOrigYVector(real* y, int nRows);
+	void saveOrigYVector(const real* y, int nRows);
 	void saveOrigNumberOfColumns(int nCols);
 	int getOrigNumberOfColumns();
 	vector<real> getOrigYVector();
@@ -64,7 +66,7 @@ public:
 	NoImputation() {}
 	virtual ~NoImputation() {}
 
-	void sortColumns() {}
+	void sortColumns(std::mt19937& /*rng*/) {}
 	void resortColumns() {}
 	void push_back(IntVector* vecMissing,int nMissing) {}
 	void push_back(int col, int indMissing) {}
@@ -75,7 +77,7 @@ public:
 //	const vector<int>& getSortedColIndices() const {}
 //	const vector<int>& getReverseColIndices() const {}
 	void setWeightsForImputation(int col, vector<real>& weights, int nRows) {}
-	void saveOrigYVector(real* y, int nRows) {}
+	void saveOrigYVector(const real* /*y*/, int /*nRows*/) {}
 	void saveOrigNumberOfColumns(int nCols) {}
 	int getOrigNumberOfColumns() { return 0; }
 //	vector<real> getOrigYVector() {}
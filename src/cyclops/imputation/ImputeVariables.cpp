@@ -9,49 +9,15 @@
 #include "io/CSVInputReader.h"
 #include "io/BBRInputReader.h"
 #include "io/BBROutputWriter.h"
-#include "GridSearchCrossValidationDriver.h"
-#include "CrossValidationSelector.h"
+#include "io/CmdLineProgressLogger.h"
+#include "drivers/GridSearchCrossValidationDriver.h"
+#include "drivers/CrossValidationSelector.h"
+#include "Thread.h"
+#include "boost/iterator/counting_iterator.hpp"
 #include <time.h>
 
 namespace bsccs {
 
-double randn_notrig(double mu=0.0, double sigma=1.0) {
-	static bool deviateAvailable=false;        //        flag
-	static float storedDeviate;                        //        deviate from previous calculation
-	double polar, rsquared, var1, var2;
-
-	//        If no deviate has been stored, the polar Box-Muller transformation is
-	//        performed, producing two independent normally-distributed random
-	//        deviates.  One is stored for the next round, and one is returned.
-	if (!deviateAvailable) {
-
-		//        choose pairs of uniformly distributed deviates, discarding those
-		//        that don't fall within the unit circle
-		do {
-			var1=2.0*( double(rand())/double(RAND_MAX) ) - 1.0;
-			var2=2.0*( double(rand())/double(RAND_MAX) ) - 1.0;
-			rsquared=var1*var1+var2*var2;
-		} while ( rsquared>=1.0 || rsquared == 0.0);
-
-		//        calculate polar tranformation for each deviate
-		polar=sqrt(-2.0*log(rsquared)/rsquared);
-
-		//        store first deviate and set flag
-		storedDeviate=var1*polar;
-		deviateAvailable=true;
-
-		//        return second deviate
-		return var2*polar*sigma + mu;
-	}
-
-	//        If a deviate is available from a previous call to this function, it is
-	//        returned, and the flag is set to false.
-	else {
-		deviateAvailable=false;
-		return storedDeviate*sigma + mu;
-	}
-}
-
 void getComplement(vector<real>& weights){
 	for(std::vector<real>::iterator it = weights.begin(); it != weights.end(); it++) {
 		*it = 1 - *it;
@@ -61,17 +27,29 @@ void getComplement(vector<real>& weights){
 ImputeVariables::ImputeVariables(){
 	ccd = NULL;
 	model = NULL;
+	reader = NULL;
+	modelData = NULL;
+	imputeHelper = NULL;
+	nThreads = 1;
+	isWorker = false;
+	originalData = NULL;
+	logger = bsccs::make_shared<loggers::CoutLogger>();
+	error = bsccs::make_shared<loggers::CerrErrorHandler>();
 }
 
 ImputeVariables::~ImputeVariables(){
 	if (modelData)
 		delete modelData;
+	if (isWorker && imputeHelper)
+		delete imputeHelper;
 }
 
-void ImputeVariables::initialize(CCDArguments args, int numberOfImputations, bool inclY){
+void ImputeVariables::initialize(CCDArguments args, int numberOfImputations, bool inclY, int threads){
 	arguments = args;
 	nImputations = numberOfImputations;
+	nThreads = threads;
 	includeY = inclY;
+
 	if(arguments.fileFormat == "csv"){
 		reader = new CSVInputReader<ImputationHelper>();
 		static_cast<CSVInputReader<ImputationHelper>*>(reader)->readFile(arguments.inFileName.c_str());
@@ -79,7 +57,7 @@ void ImputeVariables::initialize(CCDArguments args, int numberOfImputations, boo
 		modelData = static_cast<CSVInputReader<ImputationHelper>*>(reader)->getModelData();
 	}
 	else if(arguments.fileFormat == "bbr"){
-		reader = new BBRInputReader<ImputationHelper>();
+		reader = new BBRInputReader<ImputationHelper>(nThreads);
 		static_cast<BBRInputReader<ImputationHelper>*>(reader)->readFile(arguments.inFileName.c_str());
 		imputeHelper = static_cast<BBRInputReader<ImputationHelper>*>(reader)->getImputationPolicy();
 		modelData = static_cast<BBRInputReader<ImputationHelper>*>(reader)->getModelData();
@@ -89,72 +67,152 @@ void ImputeVariables::initialize(CCDArguments args, int numberOfImputations, boo
 		exit(-1);
 	}
 	imputeHelper->saveOrigYVector(modelData->getYVector(), modelData->getNumberOfRows());
-	srand(time(NULL));
+	originalData = modelData;
+	initializeObservedWeights();
 }
 
-void ImputeVariables::impute(){
-	
-	for(int i = 0; i < nImputations; i++){
-		if(includeY){
-			includeYVector();
+void ImputeVariables::initializeObservedWeights(){
+	int nRows = modelData->getNumberOfRows();
+	if(includeY){
+		imputeHelper->includeYVector();
+	}
+	const vector<int>& nMissingPerColumn = imputeHelper->getnMissingPerColumn();
+	auto weights = bsccs::make_shared<vector<vector<real> > >(nMissingPerColumn.size());
+	for(int j = 0; j < (int)nMissingPerColumn.size(); j++){
+		if(nMissingPerColumn[j] > 0){
+			imputeHelper->setWeightsForImputation(j, (*weights)[j], nRows);
 		}
-		imputeHelper->sortColumns();
-		vector<int> sortedColIndices = imputeHelper->getSortedColIndices();
-		modelData->sortDataColumns(sortedColIndices);
-
-		vector<int> nMissingPerColumn = imputeHelper->getnMissingPerColumn();
-		int nColsToImpute = 0;
-		for(int j = 0; j < (int)nMissingPerColumn.size(); j++){
-			if(nMissingPerColumn[j] > 0){
-				nColsToImpute++;
-			}
+	}
+	if(includeY){
+		imputeHelper->pop_back();
+	}
+	observedWeights = weights;
+}
+
+void ImputeVariables::initializeWorker(const ImputeVariables& source){
+	arguments = source.arguments;
+	nImputations = source.nImputations;
+	includeY = source.includeY;
+	isWorker = true;
+	originalData = source.originalData;
+	observedWeights = source.observedWeights;
+	modelData = copyModelData(*source.originalData);
+	imputeHelper = new ImputationHelper(*source.imputeHelper);
+}
+
+ModelData* ImputeVariables::copyModelData(const ModelData& source){
+	ModelData* copy = new ModelData(source.modelType, source.pid, source.y, source.z, source.offs,
+			source.log, source.error);
+	copy->nPatients = source.nPatients;
+	copy->hasOffsetCovariate = source.hasOffsetCovariate;
+	copy->hasInterceptCovariate = source.hasInterceptCovariate;
+	copy->isFinalized = source.isFinalized;
+	copy->nevents = source.nevents;
+	copy->conditionId = source.conditionId;
+	copy->labels = source.labels;
+	copy->nTypes = source.nTypes;
+	copy->nRows = source.nRows;
+	for(size_t j = 0; j < source.getNumberOfColumns(); j++){
+		const CompressedDataColumn& column = source.getColumn(j);
+		const ColumnView<int> rows = column.getColumnsView();
+		const ColumnView<real> values = column.getDataView();
+		copy->push_back(rows.begin(), rows.end(), values.begin(), values.end(),
+				column.getFormatType());
+		copy->getColumn(j).add_label(column.getNumericalLabel());
+		copy->getColumn(j).add_label(column.getLabel());
+	}
+	return copy;
+}
+
+void ImputeVariables::impute(){
+	const int threads = (nThreads == -1) ?
+		bsccs::thread::hardware_concurrency() : std::max(nThreads, 1);
+	const int nWorkers = std::max(1, std::min(threads, nImputations));
+
+	// Imputations are independent; threads left over go to each worker's cross-validation
+	arguments.threads = std::max(1, threads / nWorkers);
+
+	// Each worker owns a model, workspace and copy of the data, so memory grows with
+	// threads, not imputations; imputed data sets are streamed to disk as they finish
+	vector<bsccs::unique_ptr<ImputeVariables> > workers;
+	for(int t = 0; t < nWorkers; t++){
+		workers.push_back(bsccs::unique_ptr<ImputeVariables>(new ImputeVariables()));
+		workers.back()->initializeWorker(*this);
+	}
+
+	auto scheduler = TaskScheduler<boost::counting_iterator<int> >(
+		boost::make_counting_iterator(0),
+		boost::make_counting_iterator(nImputations),
+		nWorkers);
+	scheduler.execute([&workers, &scheduler](int i) {
+		workers[scheduler.getThreadIndex(i)]->imputeOne(i);
+	});
+}
+
+void ImputeVariables::imputeOne(int i){
+
+	rng.seed(static_cast<unsigned int>(arguments.seed + i));
+
+	if(includeY){
+		includeYVector();
+	}
+	imputeHelper->sortColumns(rng);
+	vector<int> sortedColIndices = imputeHelper->getSortedColIndices();
+	modelData->sortDataColumns(sortedColIndices);
+
+	vector<int> nMissingPerColumn = imputeHelper->getnMissingPerColumn();
+	int nColsToImpute = 0;
+	for(int j = 0; j < (int)nMissingPerColumn.size(); j++){
+		if(nMissingPerColumn[j] > 0){
+			nColsToImpute++;
 		}
+	}
 
-		cout << "Total columns to impute = " << nColsToImpute << endl;
+	cout << "Imputation " << i << ": total columns to impute = " << nColsToImpute << endl;
 
-		for(int j = 0; j < (int)nMissingPerColumn.size(); j++){
-			if(nMissingPerColumn[j] > 0){
-				cout << endl << "Imputing column " << j - ((int)nMissingPerColumn.size() - nColsToImpute) << endl;
-				imputeColumn(j);
-			}
+	for(int j = 0; j < (int)nMissingPerColumn.size(); j++){
+		if(nMissingPerColumn[j] > 0){
+			cout << endl << "Imputation " << i << ": imputing column "
+				<< j - ((int)nMissingPerColumn.size() - nColsToImpute) << endl;
+			imputeColumn(j);
 		}
+	}
+	modelData->setNumberOfColumns(imputeHelper->getOrigNumberOfColumns());
+	modelData->sortDataColumns(imputeHelper->getReverseColIndices());
+	imputeHelper->resortColumns();
+	
+	if(includeY){
+		excludeYVector();
+	}
+	else{
+		modelData->setYVector(imputeHelper->getOrigYVector());
 		modelData->setNumberOfColumns(imputeHelper->getOrigNumberOfColumns());
-		modelData->sortDataColumns(imputeHelper->getReverseColIndices());
-		imputeHelper->resortColumns();
-		
-		if(includeY){
-			excludeYVector();
-		}
-		else{
-			modelData->setYVector(imputeHelper->getOrigYVector());
-			modelData->setNumberOfColumns(imputeHelper->getOrigNumberOfColumns());
-		}
-
-		writeImputedData(i);
-		resetModelData();
 	}
+
+	writeImputedData(i);
+	resetModelData();
 }
 
 void ImputeVariables::imputeColumn(int col){
 	
 	int nRows = modelData->getNumberOfRows();
 
-	vector<real> y(nRows,0.0);
-	getColumnToImpute(col, &y[0]);
+	yColumn.assign(nRows,0.0);
+	getColumnToImpute(col, &yColumn[0]);
 
-	modelData->setYVector(y);
+	modelData->setYVector(yColumn);
 	modelData->setNumberOfColumns(col);
 
-	vector<real> weights(nRows,1.0);
-	imputeHelper->setWeightsForImputation(col,weights,nRows);
+	weights = (*observedWeights)[imputeHelper->getSortedColIndices()[col]];
 
-	vector<real> weightsMissing = weights;
+	weightsMissing = weights;
 	getComplement(weightsMissing);
 
 	initializeCCDModel(col);
 	// Do cross validation for finding optimum hyperparameter value
-	CrossValidationSelector selector(arguments.fold, modelData->getPidVectorSTL(), SUBJECT, rand(), &weightsMissing);
-	GridSearchCrossValidationDriver driver(arguments.gridSteps, arguments.lowerLimit, arguments.upperLimit, &weightsMissing);
+	CrossValidationSelector selector(arguments.crossValidation.fold, modelData->getPidVectorSTL(),
+			SelectorType::BY_PID, rng(), logger, error, &weightsMissing);
+	GridSearchCrossValidationDriver driver(arguments, logger, error, &weightsMissing);
 	driver.drive(*ccd, selector, arguments);
 //	driver.logResults(arguments);
 	driver.resetForOptimal(*ccd, selector, arguments);
@@ -163,25 +221,22 @@ void ImputeVariables::imputeColumn(int col){
 	// No need to initialize ccd again, just reset weights.
 	ccd->setWeights(&weights[0]);
 
-	ccd->update(arguments.maxIterations, arguments.convergenceType, arguments.tolerance);
-	getComplement(weights);
+	ccd->update(arguments.modeFinding);
 
-	vector<real> yPred(nRows,0.0);
-
-	vector<real> allOnes(nRows,1.0);
+	yPred.assign(nRows,0.0);
+	allOnes.assign(nRows,1.0);
 
 	ccd->getPredictiveEstimates(&yPred[0], &allOnes[0]);
 
-	srand(time(NULL));
 	if(modelData->getFormatType(col) == DENSE)
-		randomizeImputationsLS(yPred, weights, col);
+		randomizeImputationsLS(yPred, weightsMissing, col);
 	else
-		randomizeImputationsLR(yPred, weights, col);
+		randomizeImputationsLR(yPred, weightsMissing, col);
 
-	if (ccd)
-		delete ccd;
-	if (model)
-		delete model;
+	delete ccd;
+	ccd = NULL;
+	delete model;
+	model = NULL;
 }
 
 void ImputeVariables::getColumnToImpute(int col, real* y){
@@ -200,31 +255,30 @@ void ImputeVariables::getColumnToImpute(int col, real* y){
 
 void ImputeVariables::initializeCCDModel(int col){
 	if(modelData->getFormatType(col) == DENSE)	//Least Squares
-		model = new ModelSpecifics<LeastSquares<real>,real>(*modelData);
+		model = AbstractModelSpecifics::factory(ModelType::NORMAL, *modelData);
 	else										//Logistic Regression
-		model = new ModelSpecifics<LogisticRegression<real>,real>(*modelData);
+		model = AbstractModelSpecifics::factory(ModelType::LOGISTIC, *modelData);
 
 	using namespace bsccs::priors;
 	PriorPtr covariatePrior;
 	if (arguments.useNormalPrior) {
-		covariatePrior = std::make_shared<NormalPrior>();
+		covariatePrior = std::make_shared<NormalPrior>(arguments.hyperprior);
 	} else {
-		covariatePrior = std::make_shared<LaplacePrior>();
+		covariatePrior = std::make_shared<LaplacePrior>(arguments.hyperprior);
 	}
 
-	covariatePrior->setVariance(arguments.hyperprior);
-
-	JointPriorPtr prior(new priors::FullyExchangeableJointPrior(covariatePrior));
-	ccd = new CyclicCoordinateDescent(modelData, *model, prior);
+	JointPriorPtr prior = std::make_shared<FullyExchangeableJointPrior>(covariatePrior);
+	ccd = new CyclicCoordinateDescent(*modelData, *model, prior, logger, error);
 }
 
-void ImputeVariables::randomizeImputationsLR(vector<real> yPred, vector<real> weights, int col){
+void ImputeVariables::randomizeImputationsLR(const vector<real>& yPred, const vector<real>& weights, int col){
+	std::uniform_real_distribution<real> uniform(0.0, 1.0);
 	if(modelData->getFormatType(col) == INDICATOR){
 		int nRows = modelData->getNumberOfRows();
 		vector<int> y;
 		for(int i = 0; i < nRows; i++){
 			if(weights[i]){
-				real r = (real)rand()/RAND_MAX;
+				real r = uniform(rng);
 				if(r < yPred[i])
 					y.push_back(i);
 			}
@@ -235,7 +289,7 @@ void ImputeVariables::randomizeImputationsLR(vector<real> yPred, vector<real> we
 		real* y = modelData->getDataVector(col);
 		for(int i = 0; i < modelData->getNumberOfRows(); i++){
 			if(weights[i]){
-				real r = (real)rand()/RAND_MAX;
+				real r = uniform(rng);
 				if(r < yPred[i])
 					y[i] = 1.0;
 				else
@@ -245,7 +299,7 @@ void ImputeVariables::randomizeImputationsLR(vector<real> yPred, vector<real> we
 	}
 }
 
-void ImputeVariables::randomizeImputationsLS(vector<real> yPred, vector<real> weights, int col){
+void ImputeVariables::randomizeImputationsLS(const vector<real>& yPred, const vector<real>& weights, int col){
 	
 	int n = 0;
 	
@@ -295,7 +349,7 @@ void ImputeVariables::randomizeImputationsLS(vector<real> yPred, vector<real> we
 	for(int i = 0; i < nRows; i++){
 		if(weights[i]){
 			double predInterval = 1.96 * sigma * sqrt(1 + 1/n + dist[i]/(n-1));
-			y[i] = randn_notrig(yPred[i],predInterval);
+			y[i] = std::normal_distribution<double>(yPred[i],predInterval)(rng);
 //			y[i] = yPred[i];
 		}
 	}
@@ -309,20 +363,26 @@ void ImputeVariables::writeImputedData(int imputationNumber){
 	outFileName.insert(dotind,addendum.str());
 
 	if(arguments.fileFormat == "bbr"){
-		BBROutputWriter* bbrout = new BBROutputWriter();
-		bbrout->writeFile(outFileName.c_str(),modelData);
+		BBROutputWriter bbrout;
+		bbrout.writeFile(outFileName.c_str(),modelData);
 	}
 }
 
 void ImputeVariables::resetModelData(){
-	int nCols = modelData->getNumberOfColumns();
-	for(int j = 0; j < nCols; j++){
-		if(modelData->getFormatType(j) == INDICATOR){
-			vector<int> missing;
-			imputeHelper->getMissingEntries(j,missing);
-			modelData->removeFromColumnVector(j,missing);
+	// Every imputation starts from the data as read; column storage is reused
+	for(size_t j = 0; j < originalData->getNumberOfColumns(); j++){
+		const CompressedDataColumn& original = originalData->getColumn(j);
+		CompressedDataColumn& column = modelData->getColumn(j);
+		if(original.hasColumns()){
+			const ColumnView<int> rows = original.getColumnsView();
+			column.getColumnsVector().assign(rows.begin(), rows.end());
+		}
+		if(original.hasData()){
+			const ColumnView<real> values = original.getDataView();
+			column.getDataVector().assign(values.begin(), values.end());
 		}
 	}
+	modelData->setYVector(imputeHelper->getOrigYVector());
 }
 
 void ImputeVariables::includeYVector(){
@@ -8,8 +8,11 @@
 #ifndef IMPUTEVARIABLES_H_
 #define IMPUTEVARIABLES_H_
 
+#include <random>
+
 #include "ImputationPolicy.h"
-#include "ccd.h"
+#include "CcdInterface.h"
+#include "CyclicCoordinateDescent.h"
 
 namespace bsccs {
 
@@ -17,18 +20,23 @@ class ImputeVariables {
 public:
 	ImputeVariables();
 	~ImputeVariables();
-	void initialize(CCDArguments args, int numberOfImputations, bool inclY);
+	void initialize(CCDArguments args, int numberOfImputations, bool inclY, int threads = 1);
 	void impute();
+	void imputeOne(int imputationNumber);
 	void imputeColumn(int col);
 	void getColumnToImpute(int col, real* y);
 	void initializeCCDModel(int col);
-	void randomizeImputationsLR(vector<real> yPred, vector<real> weights, int col);
-	void randomizeImputationsLS(vector<real> yPred, vector<real> weights, int col);
+	void randomizeImputationsLR(const vector<real>& yPred, const vector<real>& weights, int col);
+	void randomizeImputationsLS(const vector<real>& yPred, const vector<real>& weights, int col);
 	void writeImputedData(int imputationNumber);
 	void resetModelData();
 	void includeYVector();
 	void excludeYVector();
 private:
+	void initializeObservedWeights();
+	void initializeWorker(const ImputeVariables& source);
+	static ModelData* copyModelData(const ModelData& source);
+
 	CCDArguments arguments;
 	CyclicCoordinateDescent*  ccd;
 	AbstractModelSpecifics* model;
@@ -36,8 +44,30 @@ private:
 	ModelData* modelData;
 	ImputationHelper* imputeHelper;
 	int nImputations;
+	int nThreads;
 	bool includeY;
 	FormatType formatTypeY;
+	loggers::ProgressLoggerPtr logger;
+	loggers::ErrorHandlerPtr error;
+
+	// Workers impute a private copy of the data and restore it from the data as read,
+	// which is shared read-only with the reading instance
+	bool isWorker;
+	const ModelData* originalData;
+
+	// Per-column row weights (1 = observed) built once from the missingness as read and
+	// reused by every imputation; empty for columns without missing entries
+	bsccs::shared_ptr<const vector<vector<real> > > observedWeights;
+
+	// Seeded per imputation, so results do not depend on the number of threads
+	std::mt19937 rng;
+
+	// Workspace reused across columns and imputations
+	vector<real> yColumn;
+	vector<real> weights;
+	vector<real> weightsMissing;
+	vector<real> yPred;
+	vector<real> allOnes;
 };
 
 } // namespace
@@ -0,0 +1,324 @@
+/*
+ * BinaryOutputStream.h
+ *
+ * Output stream policy for the OutputWriter classes that stores tables as typed column
+ * blocks instead of delimited text.  All numbers are written little-endian, whatever the
+ * host byte order, and every record starts with a one-byte tag:
+ *
+ *   file      "CYCBIN01", then records
+ *   'M'       metadata: string key, uint8 type, value
+ *   'T'       table header: uint32 column count, then per column: string name, uint8 type
+ *   'B'       block: uint32 row count, then per column: uint64 byte count, values
+ *   'E'       end of table: string table name
+ *
+ * Strings are a uint32 length followed by their bytes.  Value types are FLOAT64, INT64,
+ * STRING and (metadata only) FLOAT64_VECTOR, a uint32 count followed by doubles.
+ *
+ * Column types are declared with the header, so every block of a table has the same
+ * layout; headers without a type are FLOAT64.  Values are converted to the declared type:
+ * integers widen to doubles and numbers become text in STRING columns.  Values the type
+ * cannot hold (text in numeric columns, fractions in INT64 columns) and values missing
+ * from a row are stored as NaN, INT64 minimum or the empty string.  The header is written
+ * as soon as it is complete, so tables without rows are still described.
+ */
+
+#ifndef BINARYOUTPUTSTREAM_H_
+#define BINARYOUTPUTSTREAM_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace bsccs {
+
+namespace OutputHelper {
+
+// Column and metadata value types; text streams accept and ignore them
+enum ValueType {
+	UNKNOWN = 0, FLOAT64 = 1, INT64 = 2, STRING = 3, FLOAT64_VECTOR = 4
+};
+
+class BinaryStream {
+public:
+
+	static const size_t DEFAULT_BLOCK_ROWS = 1 << 16;
+
+	BinaryStream(size_t blockRows = DEFAULT_BLOCK_ROWS) : blockRows(blockRows),
+			buffer(1 << 20), inHeader(true), headerWritten(false), rows(0), currentColumn(0) { }
+
+	~BinaryStream() {
+		close();
+	}
+
+	void open(const char* fileName) {
+		out.rdbuf()->pubsetbuf(buffer.data(), buffer.size());
+		out.open(fileName, std::ios::out | std::ios::binary);
+		out.write("CYCBIN01", 8);
+	}
+
+	bool is_open() const {
+		return out.is_open();
+	}
+
+	void close() {
+		if (out.is_open()) {
+			out.close();
+		}
+	}
+
+	template <typename T>
+	BinaryStream& addText(const T& t) { return *this; }
+
+	BinaryStream& addDelimitor() { return *this; }
+
+	BinaryStream& addEndl() {
+		if (inHeader) {
+			inHeader = false;
+			writeHeader();
+		} else if (currentColumn > 0) {
+			// Pad short rows
+			for (; currentColumn < columns.size(); ++currentColumn) {
+				appendMissing(columns[currentColumn]);
+			}
+			currentColumn = 0;
+			if (++rows == blockRows) {
+				writeBlock();
+			}
+		}
+		return *this;
+	}
+
+	BinaryStream& addHeader(const std::string& t, ValueType type = FLOAT64) {
+		columns.push_back(Column(t, type));
+		return *this;
+	}
+
+	BinaryStream& addMetaKey(const std::string& t) {
+		currentKey = t;
+		return *this;
+	}
+
+	template <typename T>
+	BinaryStream& addMetaValue(const T& t) {
+		out.put('M');
+		writeString(out, currentKey);
+		writeMetaValue(t);
+		return *this;
+	}
+
+	template <typename T>
+	BinaryStream& addValue(const T& t) {
+		if (currentColumn >= columns.size()) { // Value beyond the header
+			return *this;
+		}
+		appendValue(columns[currentColumn], t);
+		++currentColumn;
+		return *this;
+	}
+
+	BinaryStream& endTable(const char* t) {
+		writeHeader();
+		if (rows > 0) {
+			writeBlock();
+		}
+		out.put('E');
+		writeString(out, t);
+		columns.clear();
+		inHeader = true;
+		headerWritten = false;
+		return *this;
+	}
+
+	bool includeLabels() { return true; }
+
+private:
+
+	struct Column {
+		std::string name;
+		ValueType type;
+		std::vector<char> bytes;
+
+		Column(const std::string& name, ValueType type) : name(name), type(type) { }
+	};
+
+	static bool isLittleEndian() {
+		const uint16_t one = 1;
+		return *reinterpret_cast<const unsigned char*>(&one) == 1;
+	}
+
+	template <typename T>
+	static void toLittleEndian(const T& value, char* raw) {
+		std::memcpy(raw, &value, sizeof(T));
+		if (!isLittleEndian()) {
+			std::reverse(raw, raw + sizeof(T));
+		}
+	}
+
+	template <typename T>
+	static void appendRaw(std::vector<char>& bytes, const T& value) {
+		char raw[sizeof(T)];
+		toLittleEndian(value, raw);
+		bytes.insert(bytes.end(), raw, raw + sizeof(T));
+	}
+
+	template <typename T>
+	static void writeRaw(std::ostream& stream, const T& value) {
+		char raw[sizeof(T)];
+		toLittleEndian(value, raw);
+		stream.write(raw, sizeof(T));
+	}
+
+	static void writeString(std::ostream& stream, const std::string& value) {
+		writeRaw(stream, static_cast<uint32_t>(value.size()));
+		stream.write(value.data(), value.size());
+	}
+
+	template <typename T>
+	typename std::enable_if<std::is_floating_point<T>::value>::type
+	appendValue(Column& column, const T& value) {
+		appendDouble(column, static_cast<double>(value));
+	}
+
+	template <typename T>
+	typename std::enable_if<std::is_integral<T>::value>::type
+	appendValue(Column& column, const T& value) {
+		appendInteger(column, static_cast<int64_t>(value));
+	}
+
+	void appendValue(Column& column, const std::string& value) {
+		if (column.type == STRING) {
+			appendString(column.bytes, value);
+		} else {
+			appendMissing(column);
+		}
+	}
+
+	void appendValue(Column& column, const char* value) {
+		appendValue(column, std::string(value));
+	}
+
+	// 2^63; doubles at or beyond it do not fit INT64
+	static double integerLimit() {
+		return -static_cast<double>(std::numeric_limits<int64_t>::min());
+	}
+
+	void appendDouble(Column& column, double value) {
+		switch (column.type) {
+			case INT64 :
+				if (value == std::floor(value) && std::abs(value) < integerLimit()) {
+					appendRaw(column.bytes, static_cast<int64_t>(value));
+				} else {
+					appendMissing(column);
+				}
+				break;
+			case STRING : {
+					std::ostringstream text;
+					text.precision(17);
+					text << value;
+					appendString(column.bytes, text.str());
+				}
+				break;
+			default : appendRaw(column.bytes, value);
+		}
+	}
+
+	void appendInteger(Column& column, int64_t value) {
+		switch (column.type) {
+			case INT64 : appendRaw(column.bytes, value); break;
+			case STRING : appendString(column.bytes, std::to_string(value)); break;
+			default : appendRaw(column.bytes, static_cast<double>(value));
+		}
+	}
+
+	static void appendString(std::vector<char>& bytes, const std::string& value) {
+		appendRaw(bytes, static_cast<uint32_t>(value.size()));
+		bytes.insert(bytes.end(), value.begin(), value.end());
+	}
+
+	void appendMissing(Column& column) {
+		switch (column.type) {
+			case INT64 : appendRaw(column.bytes, std::numeric_limits<int64_t>::min()); break;
+			case STRING : appendString(column.bytes, std::string()); break;
+			default : appendRaw(column.bytes, std::numeric_limits<double>::quiet_NaN());
+		}
+	}
+
+	void writeHeader() {
+		if (headerWritten) {
+			return;
+		}
+		out.put('T');
+		writeRaw(out, static_cast<uint32_t>(columns.size()));
+		for (size_t j = 0; j < columns.size(); ++j) {
+			writeString(out, columns[j].name);
+			writeRaw(out, static_cast<uint8_t>(columns[j].type));
+		}
+		headerWritten = true;
+	}
+
+	void writeBlock() {
+		out.put('B');
+		writeRaw(out, static_cast<uint32_t>(rows));
+		for (size_t j = 0; j < columns.size(); ++j) {
+			writeRaw(out, static_cast<uint64_t>(columns[j].bytes.size()));
+			out.write(columns[j].bytes.data(), columns[j].bytes.size());
+			columns[j].bytes.clear();
+		}
+		rows = 0;
+	}
+
+	template <typename T>
+	typename std::enable_if<std::is_floating_point<T>::value>::type
+	writeMetaValue(const T& value) {
+		writeRaw(out, static_cast<uint8_t>(FLOAT64));
+		writeRaw(out, static_cast<double>(value));
+	}
+
+	template <typename T>
+	typename std::enable_if<std::is_integral<T>::value>::type
+	writeMetaValue(const T& value) {
+		writeRaw(out, static_cast<uint8_t>(INT64));
+		writeRaw(out, static_cast<int64_t>(value));
+	}
+
+	void writeMetaValue(const std::string& value) {
+		writeRaw(out, static_cast<uint8_t>(STRING));
+		writeString(out, value);
+	}
+
+	void writeMetaValue(const char* value) {
+		writeMetaValue(std::string(value));
+	}
+
+	template <typename T>
+	void writeMetaValue(const std::vector<T>& values) {
+		writeRaw(out, static_cast<uint8_t>(FLOAT64_VECTOR));
+		writeRaw(out, static_cast<uint32_t>(values.size()));
+		for (size_t i = 0; i < values.size(); ++i) {
+			writeRaw(out, static_cast<double>(values[i]));
+		}
+	}
+
+	const size_t blockRows;
+	std::vector<char> buffer;
+	std::ofstream out;
+	std::vector<Column> columns;
+	std::string currentKey;
+	bool inHeader;
+	bool headerWritten;
+	size_t rows;
+	size_t currentColumn;
+};
+
+} // namespace OutputHelper
+
+} // namespace bsccs
+
+#endif /* BINARYOUTPUTSTREAM_H_ */
@@ -116,9 +116,6 @@ public:
 			parseOffsetCovariateEntry(ss, rowInfo, offsetInLogSpace);
 		}
 
-		if (includeIntercept) {
-			modelData->getColumn(columnIntercept).add_data(rowInfo.currentRow, static_cast<real>(1.0));
-		}
 		parseAllBBRCovariatesEntry(ss, rowInfo, indicatorOnly);
 	}
 
@@ -160,7 +157,7 @@ public:
 			modelData->getColumn(0).add_label(-1);
 		}
 		if (includeIntercept) {
-			modelData->push_back(DENSE); // Column 0 or 1
+			modelData->push_back(INTERCEPT); // Column 0 or 1, no storage
 			modelData->setHasInterceptCovariate(true);
 			columnIntercept = modelData->getNumberOfColumns() - 1;			
 		}
@@ -171,7 +168,7 @@ public:
 			std::ostringstream stream;
 			stream << "Going to up-cast all columns to sparse!";
 			logger->writeLine(stream);
-			size_t i = includeIntercept ? 1 : 0;
+			size_t i = (includeOffset ? 1 : 0) + (includeIntercept ? 1 : 0);
 			for (; i < modelData->getNumberOfColumns(); ++i) {
 				modelData->getColumn(i).convertColumnToSparse();
 			}
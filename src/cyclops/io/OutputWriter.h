@@ -12,6 +12,7 @@
 
 #include "CyclicCoordinateDescent.h"
 #include "ModelData.h"
+#include "io/BinaryOutputStream.h"
 
 namespace bsccs {
 
@@ -23,6 +24,8 @@ public:
 	virtual ~OutputWriter() { }
 
 	virtual void writeFile(const char* fileName) = 0;
+
+	virtual void writeBinaryFile(const char* fileName) = 0;
 };
 
 namespace OutputHelper {
@@ -76,6 +79,9 @@ public:
 	
 	template <typename T> 
 	OFStream& addHeader(const T& t) { return addText(t); }
+
+	template <typename T>
+	OFStream& addHeader(const T& t, ValueType /*type*/) { return addText(t); }
 		
 	template <typename T>
 	OFStream& addMetaKey(const T& t) { return addText(t).addDelimitor(); }
@@ -121,6 +127,9 @@ public:
 	
 	template <typename T> 
 	CoutStream& addHeader(const T& t) { return addText(t); }
+
+	template <typename T>
+	CoutStream& addHeader(const T& t, ValueType /*type*/) { return addText(t); }
 		
 	template <typename T>
 	CoutStream& addMetaKey(const T& t) { return addText(t).addDelimitor(); }
@@ -157,6 +166,12 @@ public:
 		out.open(fileName, std::ios::out);
 		writeFile(out);
 	}
+
+	virtual void writeBinaryFile(const char* fileName) {
+		OutputHelper::BinaryStream out;
+		out.open(fileName);
+		writeFile(out);
+	}
 	
 	template <typename Stream>
 	void writeStream(Stream& stream) {
@@ -249,7 +264,8 @@ public:
 
 	template <typename Stream>
 	void writeHeader(Stream& out) {
-		out.addHeader("key").addDelimitor().addHeader("value").addEndl();
+		out.addHeader("key", OutputHelper::STRING).addDelimitor()
+			.addHeader("value", OutputHelper::STRING).addEndl();
 	}
 	
 	template <typename Stream>
@@ -318,9 +334,9 @@ public:
 	template <typename Stream>
 	void writeHeader(Stream& out) {
 		if (data.getHasRowLabels() && out.includeLabels()) {
-			out.addHeader("row_label").addDelimitor();
+			out.addHeader("row_label", OutputHelper::STRING).addDelimitor();
 		}
-  	out.addHeader("prediction").addEndl();		
+  	out.addHeader("prediction", OutputHelper::FLOAT64).addEndl();		
 	}
 	
 	template <typename Stream>
@@ -386,9 +402,11 @@ public:
 
   template <typename Stream>
 	void writeHeader(Stream& out) {
-		out.addHeader("column_label").addDelimitor().addHeader("estimate");
+		out.addHeader("column_label", OutputHelper::INT64).addDelimitor()
+			.addHeader("estimate", OutputHelper::FLOAT64);
 		if (withProfileBounds) {
-            out.addDelimitor().addHeader("lower").addDelimitor().addHeader("upper");
+            out.addDelimitor().addHeader("lower", OutputHelper::FLOAT64)
+                .addDelimitor().addHeader("upper", OutputHelper::FLOAT64);
 		}
 		out.addEndl();		
 	}
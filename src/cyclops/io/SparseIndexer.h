@@ -8,7 +8,7 @@
 #ifndef SPARSEINDEXER_H_
 #define SPARSEINDEXER_H_
 
-#include <map>
+#include <unordered_map>
 
 //#include "../CompressedDataMatrix.h"
 class CompressedDataMatrix; // forward reference
@@ -47,7 +47,7 @@ public:
 private:
 	CompressedDataMatrix& dataMatrix;
 //	int nCovariates;
-	std::map<IdType, int> sparseMap;	
+	std::unordered_map<IdType, int> sparseMap;
 };
 
 } // namespace
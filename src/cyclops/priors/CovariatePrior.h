@@ -57,6 +57,12 @@ public:
 
 	virtual std::vector<VariancePtr> getVarianceParameters() const = 0 ; // pure virtual
 
+	// Separable priors report their family and current parameter (lambda for Laplace, variance
+	// for normal) so that updates can be evaluated from a flat PriorTable without dispatch
+	virtual bool tabulate(PriorType& /*type*/, double& /*parameter*/) const {
+		return false;
+	}
+
 	static PriorPtr makePrior(PriorType priorType, double variance);
 
 	static VariancePtr makeVariance(double variance) {
@@ -94,6 +100,12 @@ public:
 		return -(gh.first / gh.second); // No regularization
 	}
 
+	bool tabulate(PriorType& type, double& parameter) const {
+		type = NONE;
+		parameter = 0.0;
+		return true;
+	}
+
 	bool getSupportsKktSwindle() const {
 		return false;
 	}
@@ -145,9 +157,16 @@ public:
 	}
 
 	double getDelta(GradientHessian gh, const DoubleVector& betaVector, const int index) const {
+		return getDelta(gh, betaVector[index], getLambda());
+	}
+
+	bool tabulate(PriorType& type, double& parameter) const {
+		type = LAPLACE;
+		parameter = getLambda();
+		return true;
+	}
 
-		double beta = betaVector[index];
-		double lambda = getLambda();
+	static double getDelta(const GradientHessian gh, const double beta, const double lambda) {
 		double delta = 0.0;
 
 		double neg_update = - (gh.first - lambda) / gh.second;
@@ -214,7 +233,7 @@ private:
 		return result;
 	}
 
-	int sign(double x) const {
+	static int sign(double x) {
 		if (x == 0) {
 			return 0;
 		}
@@ -264,6 +283,10 @@ public:
 
 	double getDelta(const GradientHessian gh, const DoubleVector& betaVector, const int index) const;
 
+	bool tabulate(PriorType& /*type*/, double& /*parameter*/) const {
+		return false;
+	}
+
 private:
 	double getEpsilon() const {
 		return convertVarianceToHyperparameter(*variance2);
@@ -315,8 +338,16 @@ public:
     }
 
 	double getDelta(GradientHessian gh, const DoubleVector& betaVector, const int index) const {
-		double sigma2Beta = getVariance();
-		double beta = betaVector[index];
+		return getDelta(gh, betaVector[index], getVariance());
+	}
+
+	bool tabulate(PriorType& type, double& parameter) const {
+		type = NORMAL;
+		parameter = getVariance();
+		return true;
+	}
+
+	static double getDelta(const GradientHessian gh, const double beta, const double sigma2Beta) {
 		return - (gh.first + (beta / sigma2Beta)) /
 				  (gh.second + (1.0 / sigma2Beta));
 	}
@@ -366,6 +397,10 @@ public:
 
     double getDelta(GradientHessian gh, const DoubleVector& betaVector, const int index) const;
 
+    bool tabulate(PriorType& /*type*/, double& /*parameter*/) const {
+        return false;
+    }
+
     std::vector<VariancePtr> getVarianceParameters() const {
         auto tmp = NormalPrior::getVarianceParameters();
         tmp.push_back(variance2);
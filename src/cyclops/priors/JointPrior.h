@@ -43,6 +43,10 @@ public:
 
 	virtual double getKktBoundary(const int index) const = 0; // pure virtual
 
+	virtual bool tabulate(const int /*index*/, PriorType& /*type*/, double& /*parameter*/) const {
+		return false; // Non-separable priors must be evaluated through getDelta()
+	}
+
 //  	virtual JointPrior* clone() const = 0; // pure virtual
 
     void addVarianceParameter(const VariancePtr& ptr) {
@@ -143,6 +147,10 @@ public:
 		return listPriors[index]->getKktBoundary();
 	}
 
+	bool tabulate(const int index, PriorType& type, double& parameter) const {
+		return listPriors[index]->tabulate(type, parameter);
+	}
+
 	bool getSupportsKktSwindle(void) const {
 		// Return true if *any* prior supports swindle
 		for (auto&prior : uniquePriors) {
@@ -634,6 +642,10 @@ public:
 		return singlePrior->getKktBoundary();
 	}
 
+	bool tabulate(const int /*index*/, PriorType& type, double& parameter) const {
+		return singlePrior->tabulate(type, parameter);
+	}
+
 // 	JointPrior* clone() const {
 // 	    std::vector<VariancePtr> newPtrs;
 // 	    for (auto x : variance) {
@@ -0,0 +1,119 @@
+/*
+ * PriorTable.h
+ *
+ *  Flattened, per-coordinate view of a JointPrior.  Separable Laplace and normal
+ *  priors are stored as (type, parameter) pairs so that the inner coordinate loop
+ *  evaluates updates with a switch rather than two levels of virtual dispatch;
+ *  anything else falls back to the JointPrior itself.
+ */
+
+#ifndef PRIORTABLE_H_
+#define PRIORTABLE_H_
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "priors/JointPrior.h"
+
+namespace bsccs {
+namespace priors {
+
+class PriorTable {
+public:
+
+	PriorTable() : fallback(nullptr) { }
+
+	// Must be called whenever the JointPrior or its variances change
+	void refresh(const JointPrior& prior, const int length) {
+		fallback = &prior;
+		kind.resize(length);
+		parameter.resize(length);
+		for (int index = 0; index < length; ++index) {
+			PriorType type;
+			double value;
+			if (prior.tabulate(index, type, value)) {
+				kind[index] = type;
+				parameter[index] = value;
+			} else {
+				kind[index] = GENERIC;
+				parameter[index] = 0.0;
+			}
+		}
+	}
+
+	double getDelta(const GradientHessian gh, const DoubleVector& beta, const int index) const {
+		switch (kind[index]) {
+			case NONE :
+				return -(gh.first / gh.second);
+			case LAPLACE :
+				return LaplacePrior::getDelta(gh, beta[index], parameter[index]);
+			case NORMAL :
+				return NormalPrior::getDelta(gh, beta[index], parameter[index]);
+			default :
+				return fallback->getDelta(gh, beta, index);
+		}
+	}
+
+	bool getSupportsKktSwindle(const int index) const {
+		switch (kind[index]) {
+			case NONE :
+			case NORMAL :
+				return false;
+			case LAPLACE :
+				return true;
+			default :
+				return fallback->getSupportsKktSwindle(index);
+		}
+	}
+
+	double getKktBoundary(const int index) const {
+		switch (kind[index]) {
+			case LAPLACE :
+				return parameter[index];
+			case NONE :
+			case NORMAL :
+				return 0.0;
+			default :
+				return fallback->getKktBoundary(index);
+		}
+	}
+
+	// Flat and normal priors keep the objective twice-differentiable for full Newton steps
+	bool getIsQuadratic(const int index) const {
+		return kind[index] == NONE || kind[index] == NORMAL;
+	}
+
+	double getPrecision(const int index) const {
+		return (kind[index] == NORMAL) ? 1.0 / parameter[index] : 0.0;
+	}
+
+	// True when every coordinate is tabulated, so getLogDensityChange() covers the whole prior
+	bool getIsTabulated() const {
+		return std::none_of(kind.begin(), kind.end(), [](int k) { return k == GENERIC; });
+	}
+
+	// Exact change in log density when beta[index] moves from oldBeta to newBeta
+	double getLogDensityChange(const int index, const double oldBeta, const double newBeta) const {
+		switch (kind[index]) {
+			case LAPLACE :
+				return -parameter[index] * (std::abs(newBeta) - std::abs(oldBeta));
+			case NORMAL :
+				return -0.5 * (newBeta - oldBeta) * (newBeta + oldBeta) / parameter[index];
+			default : // NONE
+				return 0.0;
+		}
+	}
+
+private:
+	static const int GENERIC = -1;
+
+	std::vector<int> kind;
+	std::vector<double> parameter;
+	const JointPrior* fallback;
+};
+
+} /* namespace priors */
+} /* namespace bsccs */
+
+#endif /* PRIORTABLE_H_ */
@@ -136,6 +136,7 @@ void CmdLineCcdInterface::parseCommandLine(std::vector<std::string>& args) {
 		allowedModels.push_back("cox");
 		ValuesConstraint<std::string> allowedModelValues(allowedModels);
 		ValueArg<string> modelArg("", "model", "Model specification", false, arguments.modelName, &allowedModelValues);
+		SwitchArg singlePrecisionArg("", "float", "Store row statistics in single precision", arguments.useSinglePrecisionStorage);
 
 		// Format arguments
 		std::vector<std::string> allowedFormats;
@@ -158,6 +159,7 @@ void CmdLineCcdInterface::parseCommandLine(std::vector<std::string>& args) {
 		ValuesConstraint<std::string> allowedOutputFormatValues(allowedOutputFormats);
 //		ValueArg<string> outputFormatArg("", "outputFormat", "Format of the output file", false, arguments.outputFormat, &allowedOutputFormatValues);
 		MultiArg<std::string> outputFormatArg("", "output", "Format of the output file", false, &allowedOutputFormatValues);
+		SwitchArg binaryOutputArg("", "binary", "Write output files as binary column blocks", arguments.binaryOutput);
 
 		// Control screen output volume
 		SwitchArg quietArg("q", "quiet", "Limit writing to standard out", arguments.noiseLevel <= QUIET);
@@ -179,8 +181,10 @@ void CmdLineCcdInterface::parseCommandLine(std::vector<std::string>& args) {
 		cmd.add(convergenceArg);
 		cmd.add(seedArg);
 		cmd.add(modelArg);
+		cmd.add(singlePrecisionArg);
 		cmd.add(formatArg);
 		cmd.add(outputFormatArg);
+		cmd.add(binaryOutputArg);
 		cmd.add(profileCIArg);
 		cmd.add(flatPriorArg);
 
@@ -238,8 +242,10 @@ void CmdLineCcdInterface::parseCommandLine(std::vector<std::string>& args) {
 		arguments.classHierarchyVariance = classHierarchyVarianceArg.getValue(); //Hierarchy argument
 
 		arguments.modelName = modelArg.getValue();
+		arguments.useSinglePrecisionStorage = singlePrecisionArg.getValue();
 		arguments.fileFormat = formatArg.getValue();
 		arguments.outputFormat = outputFormatArg.getValue();
+		arguments.binaryOutput = binaryOutputArg.getValue();
 		if (arguments.outputFormat.size() == 0) {
 			arguments.outputFormat.push_back("estimates");
 		}
@@ -362,7 +368,7 @@ void CmdLineCcdInterface::initializeModelImpl(
 	logger = bsccs::make_shared<loggers::CoutLogger>();
 	error = bsccs::make_shared<loggers::CerrErrorHandler>();
 	if (arguments.fileFormat == "sccs") {
-		reader = new SCCSInputReader();
+		reader = new SCCSInputReader(arguments.threads);
 	} else if (arguments.fileFormat == "clr") {
 		reader = new NewCLRInputReader(logger, error);
 	} else if (arguments.fileFormat == "csv") {
@@ -372,7 +378,7 @@ void CmdLineCcdInterface::initializeModelImpl(
 	} else if (arguments.fileFormat == "cox-csv") {
 		reader = new CoxInputReader();
 	} else if (arguments.fileFormat == "bbr") {
-		reader = new BBRInputReader<NoImputation>();
+		reader = new BBRInputReader<NoImputation>(arguments.threads);
 	} else if (arguments.fileFormat == "generic") {
 		reader = new NewGenericInputReader(modelType, logger, error);
 	} else if (arguments.fileFormat == "new-cox") {
@@ -385,6 +391,7 @@ void CmdLineCcdInterface::initializeModelImpl(
 	reader->readFile(arguments.inFileName.c_str()); // TODO Check for error
 	// delete reader;
 	*modelData = reader->getModelData();
+	(*modelData)->packColumns();
 
 // 	switch (modelType) {
 // 		case bsccs::Models::SELF_CONTROLLED_MODEL :
@@ -410,7 +417,8 @@ void CmdLineCcdInterface::initializeModelImpl(
 // 			exit(-1);
 // 	}
 
-	*model = AbstractModelSpecifics::factory(modelType, **modelData);
+	*model = AbstractModelSpecifics::factory(modelType, **modelData,
+			arguments.useSinglePrecisionStorage ? StoragePrecision::SINGLE : StoragePrecision::DOUBLE);
 	if (*model == nullptr) {
 		cerr << "Invalid model type." << endl;
 		exit(-1);
@@ -498,7 +506,11 @@ void CmdLineCcdInterface::predictModelImpl(CyclicCoordinateDescent *ccd, ModelDa
 
 	bsccs::PredictionOutputWriter predictor(*ccd, *modelData);
 	string fileName = getPathAndFileName(arguments, "pred_");
-	predictor.writeFile(fileName.c_str());
+	if (arguments.binaryOutput) {
+		predictor.writeBinaryFile(fileName.c_str());
+	} else {
+		predictor.writeFile(fileName.c_str());
+	}
 }
 	    
 void CmdLineCcdInterface::logModelImpl(CyclicCoordinateDescent *ccd, ModelData *modelData,
@@ -509,7 +521,11 @@ void CmdLineCcdInterface::logModelImpl(CyclicCoordinateDescent *ccd, ModelData *
 	estimates.addBoundInformation(profileMap);
 
 	string fileName = getPathAndFileName(arguments, "est_");
-	estimates.writeFile(fileName.c_str());
+	if (arguments.binaryOutput) {
+		estimates.writeBinaryFile(fileName.c_str());
+	} else {
+		estimates.writeFile(fileName.c_str());
+	}
 }
 
 void CmdLineCcdInterface::diagnoseModelImpl(CyclicCoordinateDescent *ccd, ModelData *modelData,	
@@ -526,7 +542,11 @@ void CmdLineCcdInterface::diagnoseModelImpl(CyclicCoordinateDescent *ccd, ModelD
 	extraInfo.push_back(ExtraInformation("update_time",updateTime));
 
 	diagnostics.addExtraInformation(extraInfo);
-	diagnostics.writeFile(fileName.c_str());
+	if (arguments.binaryOutput) {
+		diagnostics.writeBinaryFile(fileName.c_str());
+	} else {
+		diagnostics.writeFile(fileName.c_str());
+	}
 }
 
 CmdLineCcdInterface::CmdLineCcdInterface(int argc, char* argv[]) {
@@ -0,0 +1,449 @@
+/*
+ * benchmark.cpp
+ *
+ *  Synthetic-data benchmark for the engine paths.  Designs are generated directly into
+ *  ModelData and each path is timed for every model type; results are written as CSV
+ *  (one row per model and path) for regression tracking between releases.
+ *
+ *  The Cox risk-set accumulation scans have no entry point of their own; for cox and
+ *  cox_raw they are timed inside the updateXBeta and remainingStatistics paths.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <map>
+#include <random>
+#include <algorithm>
+#include <functional>
+#include <chrono>
+
+#include "tclap/CmdLine.h"
+
+#include "CcdInterface.h"
+#include "CyclicCoordinateDescent.h"
+#include "ModelData.h"
+#include "engine/AbstractModelSpecifics.h"
+#include "priors/JointPrior.h"
+#include "io/CmdLineProgressLogger.h"
+
+namespace bsccs {
+
+namespace benchmark {
+
+struct DesignArguments {
+	int rows;
+	int columns;
+	double density;
+	double denseFraction;
+	double indicatorFraction;
+	int stratumSize;
+	double tieRate;
+	unsigned int seed;
+	bool packColumns;
+	bool encodeColumns;
+};
+
+class SilentLogger : public loggers::ProgressLogger {
+public:
+	void writeLine(const std::ostringstream& /*stream*/) { }
+	void yield() { }
+};
+
+// CcdInterface supplies cross-validation and profile-likelihood drivers; data are built here
+class BenchmarkCcdInterface : public CcdInterface {
+public:
+	BenchmarkCcdInterface(int threads) {
+		logger = bsccs::make_shared<SilentLogger>();
+		error = bsccs::make_shared<loggers::CerrErrorHandler>();
+		arguments.noiseLevel = SILENT;
+		arguments.threads = threads;
+		arguments.seed = 123;
+		arguments.crossValidation.doCrossValidation = true;
+		arguments.crossValidation.useAutoSearchCV = false;
+		arguments.crossValidation.fold = 5;
+		arguments.crossValidation.foldToCompute = 5;
+		arguments.crossValidation.gridSteps = 3;
+		arguments.crossValidation.doFitAtOptimal = false;
+	}
+
+	loggers::ProgressLoggerPtr getLogger() { return logger; }
+
+	loggers::ErrorHandlerPtr getErrorHandler() { return error; }
+
+protected:
+	void initializeModelImpl(ModelData** /*modelData*/, CyclicCoordinateDescent** /*ccd*/,
+			AbstractModelSpecifics** /*model*/) { }
+
+	void predictModelImpl(CyclicCoordinateDescent* /*ccd*/, ModelData* /*modelData*/) { }
+
+	void logModelImpl(CyclicCoordinateDescent* /*ccd*/, ModelData* /*modelData*/,
+			ProfileInformationMap& /*profileMap*/, bool /*withProfileBounds*/) { }
+
+	void diagnoseModelImpl(CyclicCoordinateDescent* /*ccd*/, ModelData* /*modelData*/,
+			double /*loadTime*/, double /*updateTime*/) { }
+};
+
+static const std::vector<std::pair<ModelType, std::string>> modelTypes = {
+	{ModelType::NORMAL, "ls"},
+	{ModelType::POISSON, "pr"},
+	{ModelType::LOGISTIC, "lr"},
+	{ModelType::CONDITIONAL_LOGISTIC, "clr"},
+	{ModelType::TIED_CONDITIONAL_LOGISTIC, "clr_exact"},
+	{ModelType::CONDITIONAL_POISSON, "cpr"},
+	{ModelType::SELF_CONTROLLED_MODEL, "sccs"},
+	{ModelType::COX, "cox"},
+	{ModelType::COX_RAW, "cox_raw"}
+};
+
+bool isStratified(const ModelType modelType) {
+	return modelType == ModelType::CONDITIONAL_LOGISTIC
+		|| modelType == ModelType::TIED_CONDITIONAL_LOGISTIC
+		|| modelType == ModelType::CONDITIONAL_POISSON
+		|| modelType == ModelType::SELF_CONTROLLED_MODEL;
+}
+
+bool isSurvival(const ModelType modelType) {
+	return modelType == ModelType::COX || modelType == ModelType::COX_RAW;
+}
+
+ModelData* synthesize(const ModelType modelType, const DesignArguments& design,
+		BenchmarkCcdInterface& interface) {
+
+	std::mt19937 generator(design.seed);
+	std::uniform_real_distribution<double> uniform(0.0, 1.0);
+	std::normal_distribution<double> normal(0.0, 1.0);
+	std::poisson_distribution<int> poisson(0.5);
+
+	const int N = design.rows;
+	const int stratumSize = isStratified(modelType) ? std::max(design.stratumSize, 1) : 1;
+
+	std::vector<IdType> stratumId(N);
+	std::vector<IdType> rowId(N);
+	std::vector<double> y(N);
+	std::vector<double> time(N);
+
+	for (int i = 0; i < N; ++i) {
+		stratumId[i] = i / stratumSize;
+		rowId[i] = i;
+		if (modelType == ModelType::NORMAL) {
+			y[i] = normal(generator);
+		} else if (modelType == ModelType::POISSON || modelType == ModelType::CONDITIONAL_POISSON
+				|| modelType == ModelType::SELF_CONTROLLED_MODEL) {
+			y[i] = poisson(generator);
+		} else {
+			y[i] = (uniform(generator) < 0.3) ? 1.0 : 0.0;
+		}
+		if (isSurvival(modelType)) {
+			time[i] = (uniform(generator) < design.tieRate) ?
+					std::floor(uniform(generator) * 10.0) + 1.0 : // Tied on a coarse grid
+					1.0 + 10.0 * uniform(generator);
+		} else {
+			time[i] = 1.0 + uniform(generator);
+		}
+	}
+
+	if (isStratified(modelType)) { // Guarantee at least one event per stratum
+		for (int i = 0; i < N; i += stratumSize) {
+			y[i] = 1.0;
+		}
+	}
+
+	std::vector<int64_t> covariateId;
+	std::vector<int64_t> covariateRowId;
+	std::vector<double> covariateValue;
+	std::vector<IdType> denseColumns;
+
+	const int nDense = static_cast<int>(design.denseFraction * design.columns);
+	const int nIndicator = static_cast<int>(design.indicatorFraction * design.columns);
+
+	for (int j = 0; j < design.columns; ++j) {
+		const IdType id = j + 1;
+		const bool dense = j < nDense;
+		const bool indicator = !dense && j < nDense + nIndicator;
+		if (dense) {
+			denseColumns.push_back(id);
+			for (int i = 0; i < N; ++i) {
+				covariateId.push_back(id);
+				covariateRowId.push_back(i);
+				covariateValue.push_back(normal(generator));
+			}
+		} else if (design.density > 0.0) {
+			std::geometric_distribution<int> skip(std::min(design.density, 1.0));
+			for (int i = skip(generator); i < N; i += 1 + skip(generator)) {
+				covariateId.push_back(id);
+				covariateRowId.push_back(i);
+				covariateValue.push_back(indicator ? 1.0 : 0.5 + uniform(generator));
+			}
+		}
+	}
+
+	ModelData* data = new ModelData(modelType, interface.getLogger(), interface.getErrorHandler());
+	data->loadY(stratumId, rowId, y, time);
+	data->loadMultipleX(covariateId, covariateRowId, covariateValue, true, true, false, false);
+	for (auto id : denseColumns) {
+		data->convertColumnToDense(data->getColumnIndex(id));
+	}
+	if (isSurvival(modelType)) {
+		data->sortRows(true);
+	}
+	if (design.packColumns) {
+		data->packColumns();
+	}
+	if (design.encodeColumns) {
+		data->encodeColumns();
+	}
+	data->setIsFinalized(true);
+	return data;
+}
+
+struct Result {
+	std::string model;
+	std::string path;
+	std::vector<double> seconds;
+};
+
+double timeOnce(const std::function<void()>& task) {
+	auto start = chrono::steady_clock::now();
+	task();
+	auto end = chrono::steady_clock::now();
+	return chrono::duration<double>(end - start).count();
+}
+
+void writeResults(std::ostream& stream, const std::vector<Result>& results,
+		const DesignArguments& design, int threads, const std::map<std::string, size_t>& entries) {
+	stream << "model,path,rows,columns,density,dense_fraction,indicator_fraction,stratum_size,"
+		   << "tie_rate,entries,threads,repeats,min_seconds,median_seconds,mean_seconds" << std::endl;
+	for (const auto& result : results) {
+		std::vector<double> sorted(result.seconds);
+		std::sort(sorted.begin(), sorted.end());
+		double sum = 0.0;
+		for (double s : sorted) {
+			sum += s;
+		}
+		stream << result.model << "," << result.path << ","
+			   << design.rows << "," << design.columns << "," << design.density << ","
+			   << design.denseFraction << "," << design.indicatorFraction << ","
+			   << design.stratumSize << "," << design.tieRate << ","
+			   << entries.at(result.model) << "," << threads << "," << sorted.size() << ","
+			   << sorted.front() << "," << sorted[sorted.size() / 2] << ","
+			   << sum / sorted.size() << std::endl;
+	}
+}
+
+} // namespace benchmark
+
+} // namespace bsccs
+
+int main(int argc, char* argv[]) {
+
+	using namespace bsccs;
+	using namespace bsccs::benchmark;
+	using namespace TCLAP;
+
+	DesignArguments design;
+	int repeats;
+	int threads;
+	int stratumThreads;
+	double variance;
+	std::string outFileName;
+	std::vector<std::string> models;
+	std::vector<std::string> paths;
+	bool singlePrecision;
+	std::string algorithm;
+
+	try {
+		CmdLine cmd("Synthetic-data benchmark for Cyclops engine paths", ' ', "0.1");
+		ValueArg<int> rowsArg("N", "rows", "Number of rows", false, 100000, "int");
+		ValueArg<int> columnsArg("J", "columns", "Number of covariates", false, 100, "int");
+		ValueArg<double> densityArg("d", "density", "Fraction of non-zero entries per sparse/indicator column", false, 0.01, "real");
+		ValueArg<double> denseArg("", "denseFraction", "Fraction of dense columns", false, 0.05, "real");
+		ValueArg<double> indicatorArg("", "indicatorFraction", "Fraction of indicator columns", false, 0.5, "real");
+		ValueArg<int> stratumArg("s", "stratumSize", "Rows per stratum for conditional models", false, 10, "int");
+		ValueArg<double> tieArg("", "tieRate", "Fraction of tied survival times", false, 0.1, "real");
+		ValueArg<unsigned int> seedArg("", "seed", "Random number seed", false, 666, "int");
+		ValueArg<int> repeatsArg("r", "repeats", "Repetitions per path", false, 3, "int");
+		ValueArg<int> threadsArg("t", "threads", "Threads for cross-validation and profiling", false, 1, "int");
+		ValueArg<int> stratumThreadsArg("", "stratumThreads", "Threads for stratum-partitioned kernels in grouped models", false, 1, "int");
+		ValueArg<double> varianceArg("v", "variance", "Laplace prior variance", false, 1.0, "real");
+		ValueArg<std::string> outArg("o", "out", "CSV output file (default: stdout)", false, "", "file");
+		MultiArg<std::string> modelArg("m", "model", "Model type to benchmark (repeatable; default: all)", false, "string");
+		MultiArg<std::string> pathArg("p", "path", "Engine path to benchmark (repeatable; default: all)", false, "string");
+		SwitchArg singleArg("", "single", "Use single-precision row statistics", false);
+		SwitchArg packArg("", "packed", "Store columns in contiguous arenas", false);
+		SwitchArg encodeArg("", "encoded", "Add compressed row-index encodings", false);
+		std::vector<std::string> allowedAlgorithms = {"auto", "ccd", "newton"};
+		ValuesConstraint<std::string> allowedAlgorithmValues(allowedAlgorithms);
+		ValueArg<std::string> algorithmArg("", "algorithm", "Mode-finding engine", false, "ccd", &allowedAlgorithmValues);
+
+		cmd.add(rowsArg);
+		cmd.add(columnsArg);
+		cmd.add(densityArg);
+		cmd.add(denseArg);
+		cmd.add(indicatorArg);
+		cmd.add(stratumArg);
+		cmd.add(tieArg);
+		cmd.add(seedArg);
+		cmd.add(repeatsArg);
+		cmd.add(threadsArg);
+		cmd.add(stratumThreadsArg);
+		cmd.add(varianceArg);
+		cmd.add(outArg);
+		cmd.add(modelArg);
+		cmd.add(pathArg);
+		cmd.add(singleArg);
+		cmd.add(packArg);
+		cmd.add(encodeArg);
+		cmd.add(algorithmArg);
+		cmd.parse(argc, argv);
+
+		design.rows = rowsArg.getValue();
+		design.columns = columnsArg.getValue();
+		design.density = densityArg.getValue();
+		design.denseFraction = denseArg.getValue();
+		design.indicatorFraction = indicatorArg.getValue();
+		design.stratumSize = stratumArg.getValue();
+		design.tieRate = tieArg.getValue();
+		design.seed = seedArg.getValue();
+		design.packColumns = packArg.getValue();
+		design.encodeColumns = encodeArg.getValue();
+		algorithm = algorithmArg.getValue();
+		repeats = std::max(repeatsArg.getValue(), 1);
+		threads = threadsArg.getValue();
+		stratumThreads = stratumThreadsArg.getValue();
+		variance = varianceArg.getValue();
+		outFileName = outArg.getValue();
+		models = modelArg.getValue();
+		paths = pathArg.getValue();
+		singlePrecision = singleArg.getValue();
+	} catch (ArgException& e) {
+		std::cerr << "Error: " << e.error() << " for argument " << e.argId() << std::endl;
+		std::exit(-1);
+	}
+
+	auto selected = [](const std::vector<std::string>& list, const std::string& name) {
+		return list.empty() || std::find(list.begin(), list.end(), name) != list.end();
+	};
+
+	BenchmarkCcdInterface interface(threads);
+	ModeFindingArguments modeFinding;
+	modeFinding.algorithmType = (algorithm == "auto") ? AlgorithmType::AUTO :
+			(algorithm == "newton") ? AlgorithmType::NEWTON : AlgorithmType::CCD;
+
+	std::vector<Result> results;
+	std::map<std::string, size_t> entries;
+
+	for (const auto& model : modelTypes) {
+		if (!selected(models, model.second)) continue;
+
+		ModelData* data = synthesize(model.first, design, interface);
+		size_t nEntries = 0;
+		for (size_t j = 0; j < data->getNumberOfColumns(); ++j) {
+			nEntries += data->getNumberOfNonZeroEntries(j);
+		}
+		entries[model.second] = nEntries;
+
+		AbstractModelSpecifics* specifics = AbstractModelSpecifics::factory(model.first, *data,
+				singlePrecision ? StoragePrecision::SINGLE : StoragePrecision::DOUBLE);
+		priors::JointPriorPtr prior = bsccs::make_shared<priors::FullyExchangeableJointPrior>(
+				bsccs::make_shared<priors::LaplacePrior>(variance));
+		CyclicCoordinateDescent* ccd = new CyclicCoordinateDescent(*data, *specifics, prior,
+				interface.getLogger(), interface.getErrorHandler());
+		ccd->setNoiseLevel(SILENT);
+		ccd->setStratumThreads(stratumThreads);
+
+		const int J = static_cast<int>(data->getNumberOfColumns());
+
+		std::vector<std::pair<std::string, std::function<void()>>> tasks = {
+			{"gradientHessian", [&]() {
+				double gradient, hessian;
+				for (int j = 0; j < J; ++j) {
+					specifics->computeNumeratorForGradient(j);
+					specifics->computeGradientAndHessian(j, &gradient, &hessian, false);
+				}
+			}},
+			{"fullGradient", [&]() {
+				std::vector<double> gradient(J), hessian(J);
+				ccd->getLogLikelihoodGradient(gradient.data(), hessian.data(), threads);
+			}},
+			{"updateXBeta", [&]() {
+				for (int j = 0; j < J; ++j) {
+					specifics->updateXBeta(0.01, j, false);
+					specifics->updateXBeta(-0.01, j, false);
+				}
+			}},
+			{"remainingStatistics", [&]() {
+				specifics->computeRemainingStatistics(false);
+			}},
+			{"logLikelihood", [&]() {
+				specifics->getLogLikelihood(false);
+			}},
+			{"logLikelihoodSweep", [&]() {
+				std::vector<double> values(32);
+				for (size_t b = 0; b < values.size(); ++b) {
+					values[b] = ccd->getBeta(J - 1) + 0.01 * b;
+				}
+				ccd->getLogLikelihoodSweep(J - 1, values);
+			}},
+			{"findMode", [&]() {
+				ccd->resetBeta();
+				ccd->update(modeFinding);
+			}},
+			{"crossValidation", [&]() {
+				ccd->resetBeta();
+				interface.runCrossValidation(ccd, data);
+			}},
+			{"profileLikelihood", [&]() {
+				ccd->setHyperprior(variance);
+				ccd->resetBeta();
+				ccd->update(modeFinding);
+				ProfileVector covariates(1, data->getColumn(J - 1).getNumericalLabel());
+				ProfileInformationMap profileMap;
+				interface.profileModel(ccd, data, covariates, profileMap, threads, 1.920729, true);
+			}},
+			{"profileGrid", [&]() {
+				ccd->setHyperprior(variance);
+				ccd->resetBeta();
+				ccd->update(modeFinding);
+				std::vector<double> points(16), values;
+				for (size_t i = 0; i < points.size(); ++i) {
+					points[i] = ccd->getBeta(J - 1) + 0.05 * (static_cast<double>(i) - 7.5);
+				}
+				interface.evaluateProfileModel(ccd, data, data->getColumn(J - 1).getNumericalLabel(),
+						points, values, threads, true);
+			}}
+		};
+
+		ccd->getLogLikelihood(); // Initialize all lazy statistics before timing kernels
+
+		for (auto& task : tasks) {
+			if (!selected(paths, task.first)) continue;
+			if (model.first == ModelType::COX_RAW && task.first == "crossValidation") {
+				continue; // Untied Cox indexes denominators by row, which CV weights compact
+			}
+			Result result;
+			result.model = model.second;
+			result.path = task.first;
+			for (int r = 0; r < repeats; ++r) {
+				result.seconds.push_back(timeOnce(task.second));
+			}
+			results.push_back(result);
+			specifics->computeRemainingStatistics(false); // Restore consistent state
+		}
+
+		delete ccd;
+		delete specifics;
+		delete data;
+	}
+
+	if (outFileName.empty()) {
+		writeResults(std::cout, results, design, threads, entries);
+	} else {
+		std::ofstream out(outFileName);
+		writeResults(out, results, design, threads, entries);
+	}
+
+	return 0;
+}
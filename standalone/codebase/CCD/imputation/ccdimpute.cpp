@@ -15,22 +15,9 @@
 #include <math.h>
 
 #include "imputation/ccdimpute.h"
-#include "ccd.h"
 #include "CyclicCoordinateDescent.h"
 #include "ModelData.h"
-#include "io/InputReader.h"
-#include "io/CLRInputReader.h"
-#include "io/RTestInputReader.h"
-#include "io/CCTestInputReader.h"
-#include "io/CoxInputReader.h"
-#include "io/BBRInputReader.h"
-#include "CrossValidationSelector.h"
-#include "GridSearchCrossValidationDriver.h"
-#include "BootstrapSelector.h"
-#include "ProportionSelector.h"
-#include "BootstrapDriver.h"
-#include "ModelSpecifics.h"
-#include "ImputeVariables.h"
+#include "imputation/ImputeVariables.h"
 
 #include "tclap/CmdLine.h"
 
@@ -84,6 +71,7 @@ void setDefaultArguments(CCDImputeArguments &ccdImputeArgs) {
 	ccdImputeArgs.doPartial = false;
 	ccdImputeArgs.doImputation = false;
 	ccdImputeArgs.numberOfImputations = 5;
+	ccdImputeArgs.threads = 1;
 	ccdImputeArgs.includeY = false;
 }
 
@@ -160,6 +148,7 @@ void parseCommandLine(std::vector<std::string>& args,
 		SwitchArg doImputationArg("i", "imputation", "Perform multiple imputation", ccdImputeArgs.doImputation);
 		ValueArg<int> numberOfImputationsArg("m", "numberOfImputations", "Number of imputed data sets (default is m=5)", false, ccdImputeArgs.numberOfImputations, "int");
 		SwitchArg includeYArg("y", "includeY", "Use output vector y for imputation", ccdImputeArgs.includeY);
+		ValueArg<int> threadsArg("", "threads", "Number of threads for concurrent imputations and cross-validation", false, ccdImputeArgs.threads, "int");
 
 		cmd.add(gpuArg);
 //		cmd.add(betterGPUArg);
@@ -191,6 +180,7 @@ void parseCommandLine(std::vector<std::string>& args,
 		cmd.add(doImputationArg);
 		cmd.add(numberOfImputationsArg);
 		cmd.add(includeYArg);
+		cmd.add(threadsArg);
 		cmd.add(inFileArg);
 		cmd.add(outFileArg);
 		cmd.parse(args);
@@ -272,6 +262,7 @@ void parseCommandLine(std::vector<std::string>& args,
 		if(ccdImputeArgs.doImputation){
 			ccdImputeArgs.numberOfImputations = numberOfImputationsArg.getValue();
 			ccdImputeArgs.includeY = includeYArg.isSet();
+			ccdImputeArgs.threads = threadsArg.getValue();
 		}
 
 		if (partialArg.getValue() != -1) {
@@ -295,22 +286,14 @@ CCDArguments convertCCDToCCDImpute(CCDImputeArguments ccdImputeArgs){
 	ccdArgs.useGPU = ccdImputeArgs.useGPU;
 	ccdArgs.useBetterGPU = ccdImputeArgs.useBetterGPU;
 	ccdArgs.deviceNumber = ccdImputeArgs.deviceNumber;
-	ccdArgs.tolerance = ccdImputeArgs.tolerance;
 	ccdArgs.hyperprior = ccdImputeArgs.hyperprior;
+	ccdArgs.computeMLE = false;
+	ccdArgs.fitMLEAtMode = false;
+	ccdArgs.reportASE = false;
 	ccdArgs.useNormalPrior = ccdImputeArgs.useNormalPrior;
 	ccdArgs.hyperPriorSet = ccdImputeArgs.hyperPriorSet;
-	ccdArgs.maxIterations = ccdImputeArgs.maxIterations;
-	ccdArgs.convergenceTypeString = ccdImputeArgs.convergenceTypeString;
-	ccdArgs.convergenceType = ccdImputeArgs.convergenceType;
 	ccdArgs.seed = ccdImputeArgs.seed;
-	ccdArgs.doCrossValidation = ccdImputeArgs.doCrossValidation;
-	ccdArgs.lowerLimit = ccdImputeArgs.lowerLimit;
-	ccdArgs.upperLimit = ccdImputeArgs.upperLimit;
-	ccdArgs.fold = ccdImputeArgs.fold;
-	ccdArgs.foldToCompute = ccdImputeArgs.foldToCompute;
-	ccdArgs.gridSteps = ccdImputeArgs.gridSteps;
-	ccdArgs.cvFileName = ccdImputeArgs.cvFileName;
-	ccdArgs.doFitAtOptimal = ccdImputeArgs.doFitAtOptimal;
+	ccdArgs.useHierarchy = false;
 	ccdArgs.doBootstrap = ccdImputeArgs.doBootstrap;
 	ccdArgs.reportRawEstimates = ccdImputeArgs.reportRawEstimates;
 	ccdArgs.replicates = ccdImputeArgs.replicates;
@@ -318,6 +301,24 @@ CCDArguments convertCCDToCCDImpute(CCDImputeArguments ccdImputeArgs){
 	ccdArgs.doPartial = ccdImputeArgs.doPartial;
 	ccdArgs.modelType = ccdImputeArgs.modelType;
 	ccdArgs.modelName = ccdImputeArgs.modelName;
+	ccdArgs.useSinglePrecisionStorage = false;
+	ccdArgs.noiseLevel = NOISY;
+	ccdArgs.threads = ccdImputeArgs.threads;
+	ccdArgs.resetCoefficients = false;
+
+	ccdArgs.modeFinding.tolerance = ccdImputeArgs.tolerance;
+	ccdArgs.modeFinding.maxIterations = ccdImputeArgs.maxIterations;
+	ccdArgs.modeFinding.convergenceTypeString = ccdImputeArgs.convergenceTypeString;
+	ccdArgs.modeFinding.convergenceType = ccdImputeArgs.convergenceType;
+
+	ccdArgs.crossValidation.doCrossValidation = ccdImputeArgs.doCrossValidation;
+	ccdArgs.crossValidation.lowerLimit = ccdImputeArgs.lowerLimit;
+	ccdArgs.crossValidation.upperLimit = ccdImputeArgs.upperLimit;
+	ccdArgs.crossValidation.fold = ccdImputeArgs.fold;
+	ccdArgs.crossValidation.foldToCompute = ccdImputeArgs.foldToCompute;
+	ccdArgs.crossValidation.gridSteps = ccdImputeArgs.gridSteps;
+	ccdArgs.crossValidation.cvFileName = ccdImputeArgs.cvFileName;
+	ccdArgs.crossValidation.doFitAtOptimal = ccdImputeArgs.doFitAtOptimal;
 
 	return ccdArgs;
 }
@@ -334,7 +335,8 @@ int main(int argc, char* argv[]) {
 
 	ImputeVariables imputation;
 	CCDArguments ccdArgs = convertCCDToCCDImpute(ccdImputeArgs);
-	imputation.initialize(ccdArgs, ccdImputeArgs.numberOfImputations, ccdImputeArgs.includeY);
+	imputation.initialize(ccdArgs, ccdImputeArgs.numberOfImputations, ccdImputeArgs.includeY,
+			ccdImputeArgs.threads);
 	imputation.impute();
 	return 0;
 }
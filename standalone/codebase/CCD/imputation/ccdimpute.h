@@ -20,7 +20,6 @@
 #include <sys/time.h>
 #endif
 
-#include "ModelSpecifics.h"
 #include "CyclicCoordinateDescent.h"
 
 namespace bsccs {
@@ -68,6 +67,7 @@ struct CCDImputeArguments {
 	// Needed for doing multiple imputation
 	bool doImputation;
 	int numberOfImputations;
+	int threads;
 	bool includeY;
 };
 
@@ -14,6 +14,7 @@
 #include "imputation/ImputationPolicy.h"
 #include "io/SparseIndexer.h"
 #include "io/CmdLineProgressLogger.h"
+#include "io/ChunkedFileParser.h"
 
 using namespace std;
 
@@ -33,27 +34,31 @@ namespace bsccs {
 template <class ImputationPolicy>
 class BBRInputReader : public InputReader{
 public:
-	BBRInputReader() : InputReader(
+	BBRInputReader(int threads = -1) : InputReader(
 	bsccs::make_shared<loggers::CoutLogger>(),
-	bsccs::make_shared<loggers::CerrErrorHandler>()) {
+	bsccs::make_shared<loggers::CerrErrorHandler>()), threads(threads) {
 		imputePolicy = new ImputationPolicy();
 	}
 	virtual ~BBRInputReader() {}
 
 	virtual void readFile(const char* fileName){
 		// Currently supports only INDICATOR and DENSE columns
-		ifstream in(fileName);
-		if (!in) {
+		MappedFile file(fileName);
+		if (!file.isOpen()) {
 			cerr << "Unable to open " << fileName << endl;
 			exit(-1);
 		}
 
-		string line;
-		//	getline(in, line); // Read header and ignore
+		// Tokenize and parse numbers in parallel; column bookkeeping replays in file order
+		const int nThreads = parsing::getParserThreads(threads);
+		std::vector<LineChunk> chunks = parsing::splitLines(file.data(),
+				file.data() + file.size(), nThreads);
+		std::vector<BBRFragment> fragments = parseChunks<BBRFragment>(chunks, nThreads,
+			[](const LineChunk& chunk, BBRFragment& fragment) {
+				parseChunk(chunk, fragment);
+			});
 
 		int numCases = 0;
-		vector<string> strVector;
-		string outerDelimiter(DELIMITER);
 
 		SparseIndexer indexer(*modelData);
 
@@ -64,94 +69,53 @@ public:
 
 		int currentRow = 0;
 		modelData->nRows = 0;
-		int maxCol = 0;
-		while (getline(in, line) && (currentRow < MAX_ENTRIES)) {
-			if (!line.empty()) {
-				strVector.clear();
-				split(strVector, line, outerDelimiter);
-
+		for (const auto& fragment : fragments) {
+			auto entry = fragment.entries.begin();
+			for (size_t row = 0; row < fragment.y.size() && currentRow < MAX_ENTRIES; ++row) {
 				modelData->nevents.push_back(1);
 				numCases++;
 				modelData->pid.push_back(numCases - 1);
 
-				vector<string> thisCovariate;
-				split(thisCovariate, strVector[0], ":");
-
 				// Parse outcome and censoring (if any). Also handling missingness in Y now.
-				real thisY;
-				int yIndex;
-				if(thisCovariate.size() == 2){
-					yIndex = 1;
-					real thisZ = static_cast<real>(atof(thisCovariate[0].c_str()));
-					modelData->z.push_back(thisZ);
+				if (fragment.hasZ[row]) {
+					modelData->z.push_back(fragment.z[row]);
 				}
-				else{
-					yIndex = 0;
-				}
-				if(thisCovariate[yIndex] == MISSING_STRING_1 || thisCovariate[yIndex] == MISSING_STRING_2){
+				if (fragment.yMissing[row]) {
 					imputePolicy->push_backY(currentRow);
-					thisY = 0.0;
-				}
-				else{
-					thisY = static_cast<real>(atof(thisCovariate[yIndex].c_str()));
 				}
-				modelData->y.push_back(thisY);
+				modelData->y.push_back(fragment.y[row]);
 
-				/*
-				real thisY;
-				if(thisCovariate[0] == MISSING_STRING_1 || thisCovariate[0] == MISSING_STRING_2){
-					imputePolicy->push_backY(currentRow);
-					thisY = 0.0;
-				}
-				else{
-					thisY = static_cast<real>(atof(thisCovariate[0].c_str()));
-				}
-				modelData->y.push_back(thisY);
-
-				// Parse censoring index entry if any
-				if(thisCovariate.size() == 2){
-					real thisZ = static_cast<real>(atof(thisCovariate[1].c_str()));
-					modelData->z.push_back(thisZ);
-				}
-				*/
 				// Fix offs for CLR
 				modelData->offs.push_back(1);
 
-				//Fill intercept
-//				modelData->getColumn(0).add_data(currentRow, 1.0);
-
 				// Parse covariates
-				for (int i = 0; i < (int)strVector.size() - 1; ++i){
-					thisCovariate.clear();
-					split(thisCovariate, strVector[i + 1], ":");
-					if((int)thisCovariate.size() == 2){
-						DrugIdType drug = static_cast<DrugIdType>(atof(thisCovariate[0].c_str()));
-						if (!indexer.hasColumn(drug)) {
-							indexer.addColumn(drug, INDICATOR);
-							IntVector* nullVector = new IntVector();
-							imputePolicy->push_back(nullVector,0);
+				for (; entry != fragment.entries.end() && entry->row == static_cast<int>(row); ++entry) {
+					IdType drug = entry->drug;
+					if (!indexer.hasColumn(drug)) {
+						indexer.addColumn(drug, INDICATOR);
+						IntVector* nullVector = new IntVector();
+						imputePolicy->push_back(nullVector,0);
+					}
+					int col = indexer.getIndex(drug);
+					if(entry->missing){
+						if(modelData->getFormatType(col) == DENSE){
+							modelData->getColumn(col).add_data(currentRow, 0.0);
 						}
-						int col = indexer.getIndex(drug);
-						if(thisCovariate[1] == MISSING_STRING_1 || thisCovariate[1] == MISSING_STRING_2){
-							if(modelData->getFormatType(col) == DENSE){
-								modelData->getColumn(col).add_data(currentRow, 0.0);
-							}
-							imputePolicy->push_back(col,currentRow);
+						imputePolicy->push_back(col,currentRow);
+					}
+					else{
+						real value = entry->value;
+						if(modelData->getFormatType(col) == DENSE){
+							modelData->getColumn(col).add_data(currentRow, value);
 						}
-						else{
-							real value = static_cast<real>(atof(thisCovariate[1].c_str()));
-							if(modelData->getFormatType(col) == DENSE){
-								modelData->getColumn(col).add_data(currentRow, value);
+						else if(modelData->getFormatType(col) == INDICATOR){
+							if(value != 1.0 && value != 0.0){
+									modelData->convertColumnToDense(col);
+								modelData->getColumn(col).add_data(currentRow,value);
 							}
-							else if(modelData->getFormatType(col) == INDICATOR){
-								if(value != 1.0 && value != 0.0){
-										modelData->convertColumnToDense(col);
-									modelData->getColumn(col).add_data(currentRow,value);
-								}
-								else{
-									if(value == 1.0){
-										modelData->getColumn(col).add_data(currentRow,1.0);
-									}
+							else{
+								if(value == 1.0){
+									modelData->getColumn(col).add_data(currentRow,1.0);
 								}
 							}
 						}
@@ -195,7 +159,85 @@ public:
 	}
 
 protected:
+	// One parsed entry "drug:value" of a data line
+	struct BBREntry {
+		int row;
+		IdType drug;
+		real value;
+		bool missing;
+	};
+
+	// Rows parsed from one line-aligned chunk, with chunk-local row numbers
+	struct BBRFragment {
+		vector<real> y;
+		vector<real> z;
+		vector<char> hasZ;
+		vector<char> yMissing;
+		vector<BBREntry> entries;
+	};
+
+	static bool isMissing(const parsing::Token& token) {
+		return token.equals(MISSING_STRING_1) || token.equals(MISSING_STRING_2);
+	}
+
+	static void parseChunk(const LineChunk& chunk, BBRFragment& fragment) {
+		using namespace parsing;
+		Token token, first, second, dummy;
+		const char* line = chunk.begin;
+		while (line < chunk.end) {
+			const char* lineEnd = findLineEnd(line, chunk.end);
+			const char* position = line;
+			line = lineEnd + 1;
+
+			if (!nextToken(position, lineEnd, token)) {
+				continue; // Empty line
+			}
+			const int row = static_cast<int>(fragment.y.size());
+
+			// Outcome, optionally preceded by censoring time
+			real thisZ = 0.0;
+			bool hasZ = false;
+			if (splitToken(token, ':', first, second)) {
+				hasZ = !splitToken(second, ':', dummy, dummy);
+				if (hasZ) {
+					parseReal(first, thisZ);
+					token = second;
+				} else {
+					token = first;
+				}
+			}
+			real thisY = 0.0;
+			const bool yMissing = isMissing(token);
+			if (!yMissing) {
+				parseReal(token, thisY);
+			}
+			fragment.y.push_back(thisY);
+			fragment.z.push_back(thisZ);
+			fragment.hasZ.push_back(hasZ);
+			fragment.yMissing.push_back(yMissing);
+
+			// Covariates
+			while (nextToken(position, lineEnd, token)) {
+				if (!splitToken(token, ':', first, second) || splitToken(second, ':', dummy, dummy)) {
+					continue; // Only "drug:value" entries
+				}
+				BBREntry entry;
+				entry.row = row;
+				real drug = 0.0;
+				parseReal(first, drug);
+				entry.drug = static_cast<IdType>(drug);
+				entry.missing = isMissing(second);
+				entry.value = 0.0;
+				if (!entry.missing) {
+					parseReal(second, entry.value);
+				}
+				fragment.entries.push_back(entry);
+			}
+		}
+	}
+
 	ImputationPolicy* imputePolicy;
+	int threads; // Parser threads; -1 uses all cores
 };
 
 }
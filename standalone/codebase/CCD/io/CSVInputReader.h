@@ -8,8 +8,9 @@
 #ifndef CSVINPUTREADER_H_
 #define CSVINPUTREADER_H_
 
-#include "InputReader.h"
+#include "io/InputReader.h"
 #include "imputation/ImputationPolicy.h"
+#include "io/CmdLineProgressLogger.h"
 
 using namespace std;
 
@@ -29,7 +30,9 @@ namespace bsccs {
 template <typename ImputationPolicy>
 class CSVInputReader : public InputReader{
 public:
-	CSVInputReader() : InputReader() {
+	CSVInputReader() : InputReader(
+	bsccs::make_shared<loggers::CoutLogger>(),
+	bsccs::make_shared<loggers::CerrErrorHandler>()) {
 		imputePolicy = new ImputationPolicy();
 	}
 	virtual ~CSVInputReader() {}
@@ -65,7 +68,7 @@ public:
 					numCovariates = strVector.size() - 2;
 					for (int i = 0; i < numCovariates; ++i) {
 						modelData->push_back(DENSE);
-						int_vector* nullVector = new int_vector();
+						IntVector* nullVector = new IntVector();
 						imputePolicy->push_back(nullVector,0);
 					}
 				} else if (numCovariates != strVector.size() - 2) {
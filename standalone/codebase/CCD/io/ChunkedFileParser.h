@@ -0,0 +1,252 @@
+/*
+ * ChunkedFileParser.h
+ *
+ * Memory-mapped input split into line-aligned chunks that are parsed concurrently.
+ * Tokens are read in place and numbers are parsed without allocating, so the per-chunk
+ * parsers only grow their own output fragments; readers merge fragments in chunk order.
+ */
+
+#ifndef CHUNKEDFILEPARSER_H_
+#define CHUNKEDFILEPARSER_H_
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+#include "Types.h"
+#include "Thread.h"
+#include "boost/iterator/counting_iterator.hpp"
+
+namespace bsccs {
+
+class MappedFile {
+public:
+	MappedFile(const char* fileName) : begin(nullptr), length(0), mapped(false), opened(false) {
+#ifndef _WIN32
+		const int fd = open(fileName, O_RDONLY);
+		if (fd == -1) {
+			return;
+		}
+		struct stat info;
+		if (fstat(fd, &info) == 0 && info.st_size > 0) {
+			void* address = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (address != MAP_FAILED) {
+				madvise(address, info.st_size, MADV_SEQUENTIAL);
+				begin = static_cast<const char*>(address);
+				length = info.st_size;
+				mapped = true;
+			}
+		}
+		close(fd);
+		if (mapped) {
+			return;
+		}
+#endif
+		std::ifstream in(fileName, std::ios::binary);
+		if (in) {
+			buffer.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+			begin = buffer.data();
+			length = buffer.size();
+			opened = true;
+		}
+	}
+
+	~MappedFile() {
+#ifndef _WIN32
+		if (mapped) {
+			munmap(const_cast<char*>(begin), length);
+		}
+#endif
+	}
+
+	bool isOpen() const { return mapped || opened; }
+
+	const char* data() const { return begin; }
+
+	size_t size() const { return length; }
+
+private:
+	MappedFile(const MappedFile&);
+	MappedFile& operator=(const MappedFile&);
+
+	const char* begin;
+	size_t length;
+	bool mapped;
+	bool opened;
+	std::vector<char> buffer;
+};
+
+struct LineChunk {
+	const char* begin;
+	const char* end;
+};
+
+namespace parsing {
+
+inline bool isSpace(char c) {
+	return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+// Returns the end of the line starting at begin (not including the newline)
+inline const char* findLineEnd(const char* begin, const char* end) {
+	const void* newline = std::memchr(begin, '\n', end - begin);
+	return newline ? static_cast<const char*>(newline) : end;
+}
+
+// Splits [begin, end) into up to nChunks pieces of similar size that start at line starts
+inline std::vector<LineChunk> splitLines(const char* begin, const char* end, int nChunks) {
+	std::vector<LineChunk> chunks;
+	const size_t length = end - begin;
+	const size_t step = length / std::max(nChunks, 1) + 1;
+	const char* start = begin;
+	while (start < end) {
+		const char* stop = (end - start > static_cast<ptrdiff_t>(step)) ?
+				findLineEnd(start + step, end) : end;
+		if (stop < end) {
+			++stop; // Keep the newline
+		}
+		LineChunk chunk = { start, stop };
+		chunks.push_back(chunk);
+		start = stop;
+	}
+	return chunks;
+}
+
+// Token within a single line, read in place
+struct Token {
+	const char* begin;
+	const char* end;
+
+	bool empty() const { return begin == end; }
+
+	bool equals(const Token& other) const {
+		return (end - begin) == (other.end - other.begin) &&
+				std::memcmp(begin, other.begin, end - begin) == 0;
+	}
+
+	bool equals(const char* string) const {
+		const size_t length = std::strlen(string);
+		return static_cast<size_t>(end - begin) == length &&
+				std::memcmp(begin, string, length) == 0;
+	}
+
+	std::string str() const { return std::string(begin, end); }
+};
+
+// Reads the next whitespace-delimited token of the line; false at end of line
+inline bool nextToken(const char*& position, const char* lineEnd, Token& token) {
+	while (position < lineEnd && isSpace(*position)) {
+		++position;
+	}
+	token.begin = position;
+	while (position < lineEnd && !isSpace(*position)) {
+		++position;
+	}
+	token.end = position;
+	return !token.empty();
+}
+
+// Splits token at the first delimiter; false if the delimiter is absent
+inline bool splitToken(const Token& token, char delimiter, Token& first, Token& second) {
+	const void* found = std::memchr(token.begin, delimiter, token.end - token.begin);
+	if (!found) {
+		return false;
+	}
+	first.begin = token.begin;
+	first.end = static_cast<const char*>(found);
+	second.begin = first.end + 1;
+	second.end = token.end;
+	return true;
+}
+
+// Parses a decimal integer; false on any other character or if the value overflows IntType
+template <typename IntType>
+inline bool parseInteger(const Token& token, IntType& value) {
+	const char* p = token.begin;
+	bool negative = false;
+	if (p < token.end && (*p == '-' || *p == '+')) {
+		negative = (*p == '-');
+		++p;
+	}
+	if (p == token.end) {
+		return false;
+	}
+	const IntType limit = std::numeric_limits<IntType>::max();
+	IntType result = 0;
+	for (; p < token.end; ++p) {
+		const unsigned int digit = static_cast<unsigned int>(*p - '0');
+		if (digit > 9) {
+			return false;
+		}
+		if (result > (limit - static_cast<IntType>(digit)) / 10) {
+			return false; // Out of range for IntType
+		}
+		result = result * 10 + static_cast<IntType>(digit);
+	}
+	value = negative ? -result : result;
+	return true;
+}
+
+// Parses a real, with a fast path for integers; other values go through strtod
+inline bool parseReal(const Token& token, real& value) {
+	long integer;
+	if (parseInteger(token, integer)) { // Common case: counts and indicators
+		value = static_cast<real>(integer);
+		return true;
+	}
+	char local[64]; // strtod needs a terminated string; mapped input is not
+	const size_t length = token.end - token.begin;
+	if (length == 0 || length >= sizeof(local)) {
+		return false;
+	}
+	std::memcpy(local, token.begin, length);
+	local[length] = '\0';
+	char* stop;
+	value = static_cast<real>(std::strtod(local, &stop));
+	return stop == local + length;
+}
+
+inline int getParserThreads(int threads) {
+	if (threads < 1) {
+		threads = static_cast<int>(std::thread::hardware_concurrency());
+	}
+	return std::max(threads, 1);
+}
+
+} // namespace parsing
+
+/**
+ * Parses chunks concurrently; parse(chunk, fragment) fills one Fragment per chunk and
+ * must only touch its own fragment.  Fragments are returned in file order.
+ */
+template <typename Fragment, typename ParseFunction>
+std::vector<Fragment> parseChunks(const std::vector<LineChunk>& chunks, int nThreads,
+		ParseFunction parse) {
+	std::vector<Fragment> fragments(chunks.size());
+	if (chunks.empty()) {
+		return fragments;
+	}
+	auto scheduler = TaskScheduler<boost::counting_iterator<int> >(
+		boost::make_counting_iterator(0),
+		boost::make_counting_iterator(static_cast<int>(chunks.size())),
+		std::max(nThreads, 1));
+	scheduler.execute([&chunks, &fragments, &parse](unsigned long task) {
+		parse(chunks[task], fragments[task]);
+	});
+	return fragments;
+}
+
+} // namespace
+
+#endif /* CHUNKEDFILEPARSER_H_ */
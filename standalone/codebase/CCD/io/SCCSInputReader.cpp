@@ -14,9 +14,11 @@
 #include <cstring>
 #include <numeric>
 #include <algorithm>
+#include <unordered_map>
 
 #include "SCCSInputReader.h"
 #include "io/SparseIndexer.h"
+#include "io/ChunkedFileParser.h"
 
 #include "io/CmdLineProgressLogger.h"
 
@@ -49,9 +51,9 @@ stringstream& operator>> (stringstream &in, int &out) {
 
 using namespace std;
 
-SCCSInputReader::SCCSInputReader() : InputReader(
+SCCSInputReader::SCCSInputReader(int threads) : InputReader(
 	bsccs::make_shared<loggers::CoutLogger>(),
-	bsccs::make_shared<loggers::CerrErrorHandler>()) {
+	bsccs::make_shared<loggers::CerrErrorHandler>()), threads(threads) {
 	// Do nothing
 }
 
@@ -59,15 +61,111 @@ SCCSInputReader::~SCCSInputReader() {
 	// Do nothing
 }
 
+namespace {
+
+// Rows parsed from one line-aligned chunk, with chunk-local row and patient numbers
+struct SCCSFragment {
+	parsing::Token outcomeId;
+	bool mixedOutcomes;
+	parsing::Token firstPid;
+	parsing::Token lastPid;
+	parsing::Token badToken;            // First outcome or offset that is not an int
+	vector<int> pid;
+	vector<int> nevents;
+	vector<real> y;
+	vector<real> offs;
+	vector<IdType> drugs;               // In order of first appearance
+	vector<IntVector> rows;             // Rows of each drug
+	std::unordered_map<IdType, int> drugIndex;
+
+	SCCSFragment() : mixedOutcomes(false) {
+		outcomeId.begin = outcomeId.end = nullptr;
+		firstPid = lastPid = badToken = outcomeId;
+	}
+};
+
+void parseSCCSChunk(const LineChunk& chunk, bool hasConditionId, IdType noDrug,
+		SCCSFragment& fragment) {
+	using namespace parsing;
+	Token token;
+	const char* line = chunk.begin;
+	while (line < chunk.end) {
+		const char* lineEnd = findLineEnd(line, chunk.end);
+		const char* position = line;
+		line = lineEnd + 1;
+
+		// Parse first entry
+		if (!nextToken(position, lineEnd, token)) {
+			continue; // Empty line
+		}
+		if (hasConditionId) {
+			if (fragment.outcomeId.empty()) {
+				fragment.outcomeId = token;
+			} else if (!token.equals(fragment.outcomeId)) {
+				fragment.mixedOutcomes = true;
+			}
+			nextToken(position, lineEnd, token);
+		}
+
+		// Parse second entry
+		const int row = static_cast<int>(fragment.y.size());
+		if (row == 0) {
+			fragment.firstPid = token;
+			fragment.nevents.push_back(0);
+		} else if (!token.equals(fragment.lastPid)) { // New patient, ASSUMES these are sorted
+			fragment.nevents.push_back(0);
+		}
+		fragment.lastPid = token;
+		fragment.pid.push_back(static_cast<int>(fragment.nevents.size()) - 1);
+
+		// Parse third entry
+		int thisY = 0;
+		nextToken(position, lineEnd, token);
+		if (!parseInteger(token, thisY) && fragment.badToken.empty()) {
+			fragment.badToken = token;
+		}
+		fragment.nevents.back() += thisY;
+		fragment.y.push_back(thisY);
+
+		// Parse fourth entry
+		int thisOffs = 0;
+		nextToken(position, lineEnd, token);
+		if (!parseInteger(token, thisOffs) && fragment.badToken.empty()) {
+			fragment.badToken = token;
+		}
+		fragment.offs.push_back(thisOffs);
+
+		// Parse remaining (variable-length) entries
+		IdType drug;
+		while (nextToken(position, lineEnd, token) && parseInteger(token, drug)) {
+			if (drug == noDrug) { // No drug
+				continue;
+			}
+			auto found = fragment.drugIndex.find(drug);
+			if (found == fragment.drugIndex.end()) {
+				found = fragment.drugIndex.insert(
+						std::make_pair(drug, static_cast<int>(fragment.drugs.size()))).first;
+				fragment.drugs.push_back(drug);
+				fragment.rows.push_back(IntVector());
+			}
+			fragment.rows[found->second].push_back(row);
+		}
+	}
+}
+
+} // namespace
+
 void SCCSInputReader::readFile(const char* fileName) {
-	ifstream in(fileName);
-	if (!in) {
+	MappedFile file(fileName);
+	if (!file.isOpen()) {
 		cerr << "Unable to open " << fileName << endl;
 		exit(-1);
 	}
 
-	string line;
-	getline(in, line); // Read header
+	const char* begin = file.data();
+	const char* end = begin + file.size();
+	const char* headerEnd = parsing::findLineEnd(begin, end);
+	string line(begin, headerEnd); // Read header
 
 	if ((line.compare(0, MATCH_LENGTH_1, FORMAT_MATCH_1) != 0) &&
 			(line.compare(0, MATCH_LENGTH_2, FORMAT_MATCH_2) != 0)) {
@@ -80,82 +178,83 @@ void SCCSInputReader::readFile(const char* fileName) {
 		hasConditionId = false; // Original data format style
 	}
 
-	vector<IntVector*> unorderColumns = vector<IntVector*>();
+	const int nThreads = parsing::getParserThreads(threads);
+	const char* body = (headerEnd < end) ? headerEnd + 1 : end;
+	std::vector<LineChunk> chunks = parsing::splitLines(body, end, nThreads);
+
+	IdType noDrug = NO_DRUG;
+	std::vector<SCCSFragment> fragments = parseChunks<SCCSFragment>(chunks, nThreads,
+		[hasConditionId, noDrug](const LineChunk& chunk, SCCSFragment& fragment) {
+			parseSCCSChunk(chunk, hasConditionId, noDrug, fragment);
+		});
+
+	// Merge fragments in file order; patients may span chunk boundaries
+	size_t totalRows = 0;
+	for (const auto& fragment : fragments) {
+		totalRows += fragment.y.size();
+	}
+	modelData->pid.reserve(totalRows);
+	modelData->y.reserve(totalRows);
+	modelData->offs.reserve(totalRows);
 
 	SparseIndexer indexer(*modelData);
 
 	int numPatients = 0;
-	int numDrugs = 0;
-	string currentPid = MISSING_STRING;
-	int numEvents = 0;
-	string outcomeId = MISSING_STRING;
-	IdType noDrug = NO_DRUG;
-
 	int currentEntry = 0;
-	while (getline(in, line) && (currentEntry < MAX_ENTRIES)) {	
-		if (!line.empty()) {
-
-			stringstream ss(line.c_str()); // Tokenize
-
-			// Parse first entry
-			if (hasConditionId) {
-				string currentOutcomeId;
-				ss >> currentOutcomeId;
-				if (outcomeId == MISSING_STRING) {
-					outcomeId = currentOutcomeId;
-				} else if (currentOutcomeId != outcomeId) {
-					cerr << "More than one condition ID in input file" << endl;
-					exit(-1);
-				}
+	const parsing::Token* currentPid = nullptr;
+	const parsing::Token* outcomeId = nullptr;
+
+	for (const auto& fragment : fragments) {
+		if (fragment.y.empty()) {
+			continue;
+		}
+		if (hasConditionId) {
+			if (outcomeId == nullptr) {
+				outcomeId = &fragment.outcomeId;
 			}
+			if (fragment.mixedOutcomes || !fragment.outcomeId.equals(*outcomeId)) {
+				cerr << "More than one condition ID in input file" << endl;
+				exit(-1);
+			}
+		}
+		if (!fragment.badToken.empty()) {
+			cerr << "Unable to parse '" << fragment.badToken.str() << "' as an integer in "
+				<< fileName << endl;
+			exit(-1);
+		}
 
-			// Parse second entry
-			string unmappedPid;
-			ss >> unmappedPid;
-			if (unmappedPid != currentPid) { // New patient, ASSUMES these are sorted
-				if (currentPid != MISSING_STRING) { // Skip first switch
-					modelData->nevents.push_back(numEvents);
-					numEvents = 0;
-				}
-				currentPid = unmappedPid;
-				numPatients++;
+		const bool continues = currentPid != nullptr && fragment.firstPid.equals(*currentPid);
+		const int firstPatient = continues ? numPatients - 1 : numPatients;
+		for (int pid : fragment.pid) {
+			modelData->pid.push_back(firstPatient + pid);
+		}
+		auto events = fragment.nevents.begin();
+		if (continues) {
+			modelData->nevents.back() += *events++;
+		}
+		modelData->nevents.insert(modelData->nevents.end(), events, fragment.nevents.end());
+		numPatients = firstPatient + static_cast<int>(fragment.nevents.size());
+		currentPid = &fragment.lastPid;
+
+		modelData->y.insert(modelData->y.end(), fragment.y.begin(), fragment.y.end());
+		modelData->offs.insert(modelData->offs.end(), fragment.offs.begin(), fragment.offs.end());
+
+		for (size_t k = 0; k < fragment.drugs.size(); ++k) {
+			const IdType drug = fragment.drugs[k];
+			if (!indexer.hasColumn(drug)) {
+				// Add new column
+				indexer.addColumn(drug, INDICATOR);
 			}
-			modelData->pid.push_back(numPatients - 1);
-
-			// Parse third entry
-			int thisY;
-			ss >> thisY;
-			numEvents += thisY;
-			modelData->y.push_back(thisY);
-
-			// Parse fourth entry
-			int thisOffs;
-			ss >> thisOffs;
-			modelData->offs.push_back(thisOffs);
-
-			// Parse remaining (variable-length) entries
-			IdType drug;		
-			while (ss >> drug) {
-				if (drug == noDrug) { // No drug
-					// Do nothing
-				} else {
-					if (!indexer.hasColumn(drug)) {
-						// Add new column
-						indexer.addColumn(drug, INDICATOR);
-					}		
-					// Add to CSC storage
-					bool valid = indexer.getColumn(drug).add_data(currentEntry, 1.0);
-					if (!valid) {
-//						std::cerr << "Repeated entry!" << std::endl;
-//						exit(-1);
-					}
-				}
+			// Add to CSC storage
+			CompressedDataColumn& column = indexer.getColumn(drug);
+			for (int row : fragment.rows[k]) {
+				column.add_data(currentEntry + row, 1.0);
 			}
-			currentEntry++;
 		}
+		currentEntry += static_cast<int>(fragment.y.size());
 	}
 
-	modelData->nevents.push_back(numEvents); // Save last patient
+	string conditionId = outcomeId ? outcomeId->str() : MISSING_STRING;
 
 	// Easy to sort columns now in AOS format
 	modelData->sortColumns(CompressedDataColumn::sortNumerically);
@@ -170,7 +269,7 @@ void SCCSInputReader::readFile(const char* fileName) {
 
 	modelData->nPatients = numPatients;
 	modelData->nRows = currentEntry;
-	modelData->conditionId = outcomeId;
+	modelData->conditionId = conditionId;
 
 #if 0
 	cout << "Converting first column to dense format" << endl;
@@ -22,10 +22,13 @@ using namespace std;
 
 class SCCSInputReader: public InputReader {
 public:
-	SCCSInputReader();
+	SCCSInputReader(int threads = -1);
 	virtual ~SCCSInputReader();
 
 	virtual void readFile(const char* fileName);
+
+private:
+	int threads; // Parser threads; -1 uses all cores
 };
 
 } // namespace
@@ -1,3 +1,5 @@
+#include <sstream>
+
 #include "dr_inference_regression_RegressionJNIWrapper.h"
 
 #include "ccd.h"
@@ -67,6 +69,51 @@ JNIEXPORT jdouble JNICALL Java_dr_inference_regression_RegressionJNIWrapper_getH
  	return instances[instance].ccd->getAsymptoticPrecision(index1, index2);
 }
 
+// Address of a direct ByteBuffer holding at least J doubles; otherwise throws IllegalArgumentException
+// and returns NULL
+static double* getDirectDoubleBuffer(JNIEnv *env, jobject buffer, const int J, const char* name) {
+	double* values = static_cast<double*>(env->GetDirectBufferAddress(buffer));
+	const jlong capacity = env->GetDirectBufferCapacity(buffer); // In bytes for a ByteBuffer
+	if (values == NULL || capacity < static_cast<jlong>(J * sizeof(double))) {
+		std::ostringstream stream;
+		stream << name << " must be a direct ByteBuffer of at least " << J << " doubles";
+		env->ThrowNew(env->FindClass("java/lang/IllegalArgumentException"), stream.str().c_str());
+		return NULL;
+	}
+	return values;
+}
+
+// Direct ByteBuffers of getBetaSize() doubles in native byte order (ByteOrder.nativeOrder(); Java
+// defaults to big-endian); a null beta keeps the current values and a null hessian skips the
+// Hessian diagonal
+extern "C"
+JNIEXPORT void JNICALL Java_dr_inference_regression_RegressionJNIWrapper_getLogLikelihoodGradient
+  (JNIEnv *env, jobject obj, jint instance, jobject beta, jobject gradient, jobject hessian, jint threads) {
+	CyclicCoordinateDescent* ccd = instances[instance].ccd;
+	const int J = ccd->getBetaSize();
+
+	if (beta != NULL) {
+		const double* values = getDirectDoubleBuffer(env, beta, J, "beta");
+		if (values == NULL) {
+			return;
+		}
+		ccd->setBeta(std::vector<double>(values, values + J));
+	}
+
+	double* gradientValues = getDirectDoubleBuffer(env, gradient, J, "gradient");
+	if (gradientValues == NULL) {
+		return;
+	}
+	double* hessianValues = NULL;
+	if (hessian != NULL) {
+		hessianValues = getDirectDoubleBuffer(env, hessian, J, "hessian");
+		if (hessianValues == NULL) {
+			return;
+		}
+	}
+	ccd->getLogLikelihoodGradient(gradientValues, hessianValues, threads);
+}
+
 extern "C"
 JNIEXPORT jint JNICALL Java_dr_inference_regression_RegressionJNIWrapper_getBetaSize
   (JNIEnv *env, jobject obj, jint instance) {
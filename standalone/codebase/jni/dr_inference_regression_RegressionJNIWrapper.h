@@ -61,6 +61,14 @@ JNIEXPORT jint JNICALL Java_dr_inference_regression_RegressionJNIWrapper_getBeta
 JNIEXPORT jdouble JNICALL Java_dr_inference_regression_RegressionJNIWrapper_getHessian
   (JNIEnv *, jobject, jint, jint, jint);  
 
+/*
+ * Class:     dr_inference_regression_RegressionJNIWrapper
+ * Method:    getLogLikelihoodGradient
+ * Signature: (ILjava/nio/ByteBuffer;Ljava/nio/ByteBuffer;Ljava/nio/ByteBuffer;I)V
+ */
+JNIEXPORT void JNICALL Java_dr_inference_regression_RegressionJNIWrapper_getLogLikelihoodGradient
+  (JNIEnv *, jobject, jint, jobject, jobject, jobject, jint);
+
 /*
  * Class:     dr_inference_regression_RegressionJNIWrapper
  * Method:    setBeta
@@ -0,0 +1,255 @@
+/*
+ * binarytest.cpp
+ *
+ *  Writes tables and metadata through OutputHelper::BinaryStream and reads them back
+ *  with an independent decoder of the layout documented in BinaryOutputStream.h.  Blocks
+ *  are kept small so tables span several of them.
+ *
+ *  Usage: binarytest <scratch file>
+ */
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "io/BinaryOutputStream.h"
+
+namespace bsccs {
+
+namespace binarytest {
+
+struct Column {
+	std::string name;
+	int type;
+	std::vector<double> doubles;
+	std::vector<int64_t> integers;
+	std::vector<std::string> strings;
+};
+
+struct Table {
+	std::vector<Column> columns;
+	size_t rows;
+	size_t blocks;
+
+	Table() : rows(0), blocks(0) { }
+};
+
+struct Contents {
+	std::string magic;
+	std::map<std::string, int> metaTypes;
+	std::map<std::string, std::string> metaStrings;
+	std::map<std::string, double> metaDoubles;
+	std::map<std::string, int64_t> metaIntegers;
+	std::map<std::string, std::vector<double> > metaVectors;
+	std::map<std::string, Table> tables;
+};
+
+// Decodes little-endian values byte by byte, so the test does not depend on host order
+class Decoder {
+public:
+	Decoder(const std::vector<unsigned char>& bytes) : bytes(bytes), position(0) { }
+
+	bool done() const { return position >= bytes.size(); }
+
+	uint64_t unsignedValue(int size) {
+		uint64_t value = 0;
+		for (int i = 0; i < size; ++i) {
+			value |= static_cast<uint64_t>(bytes.at(position + i)) << (8 * i);
+		}
+		position += size;
+		return value;
+	}
+
+	char tag() { return static_cast<char>(unsignedValue(1)); }
+
+	uint32_t uint32() { return static_cast<uint32_t>(unsignedValue(4)); }
+
+	uint64_t uint64() { return unsignedValue(8); }
+
+	int64_t int64() { return static_cast<int64_t>(unsignedValue(8)); }
+
+	double float64() {
+		const uint64_t raw = unsignedValue(8);
+		double value;
+		std::memcpy(&value, &raw, sizeof(double));
+		return value;
+	}
+
+	std::string string(size_t length) {
+		std::string value(bytes.begin() + position, bytes.begin() + position + length);
+		position += length;
+		return value;
+	}
+
+	std::string string() { return string(uint32()); }
+
+	size_t offset() const { return position; }
+
+private:
+	const std::vector<unsigned char>& bytes;
+	size_t position;
+};
+
+Contents read(const std::string& fileName) {
+	std::ifstream in(fileName.c_str(), std::ios::binary);
+	std::vector<unsigned char> bytes((std::istreambuf_iterator<char>(in)),
+			std::istreambuf_iterator<char>());
+	Decoder decoder(bytes);
+
+	Contents contents;
+	contents.magic = decoder.string(8);
+	Table table;
+	while (!decoder.done()) {
+		const char tag = decoder.tag();
+		if (tag == 'M') {
+			const std::string key = decoder.string();
+			const int type = static_cast<int>(decoder.unsignedValue(1));
+			contents.metaTypes[key] = type;
+			if (type == OutputHelper::FLOAT64) {
+				contents.metaDoubles[key] = decoder.float64();
+			} else if (type == OutputHelper::INT64) {
+				contents.metaIntegers[key] = decoder.int64();
+			} else if (type == OutputHelper::STRING) {
+				contents.metaStrings[key] = decoder.string();
+			} else {
+				const uint32_t count = decoder.uint32();
+				for (uint32_t i = 0; i < count; ++i) {
+					contents.metaVectors[key].push_back(decoder.float64());
+				}
+			}
+		} else if (tag == 'T') {
+			table = Table();
+			const uint32_t count = decoder.uint32();
+			for (uint32_t j = 0; j < count; ++j) {
+				Column column;
+				column.name = decoder.string();
+				column.type = static_cast<int>(decoder.unsignedValue(1));
+				table.columns.push_back(column);
+			}
+		} else if (tag == 'B') {
+			const uint32_t rows = decoder.uint32();
+			for (auto& column : table.columns) {
+				const size_t end = decoder.uint64() + decoder.offset();
+				for (uint32_t i = 0; i < rows; ++i) {
+					if (column.type == OutputHelper::FLOAT64) {
+						column.doubles.push_back(decoder.float64());
+					} else if (column.type == OutputHelper::INT64) {
+						column.integers.push_back(decoder.int64());
+					} else {
+						column.strings.push_back(decoder.string());
+					}
+				}
+				if (decoder.offset() != end) {
+					throw std::runtime_error("Block byte count does not match its values");
+				}
+			}
+			table.rows += rows;
+			++table.blocks;
+		} else if (tag == 'E') {
+			contents.tables[decoder.string()] = table;
+		} else {
+			throw std::runtime_error("Unknown record tag");
+		}
+	}
+	return contents;
+}
+
+int check(bool passed, const std::string& description) {
+	std::cout << (passed ? "PASS " : "FAIL ") << description << std::endl;
+	return passed ? 0 : 1;
+}
+
+void write(const std::string& fileName) {
+	OutputHelper::BinaryStream out(3);
+	out.open(fileName.c_str());
+
+	out.addMetaKey("condition").addMetaValue(std::string("outcome"));
+	out.addMetaKey("iterations").addMetaValue(17);
+	out.addMetaKey("log_likelihood").addMetaValue(-123.25);
+	out.addMetaKey("variance").addMetaValue(std::vector<double>{0.5, 2.0});
+
+	// Integers arrive first in "estimate"; doubles later must not be truncated
+	out.addHeader("label", OutputHelper::INT64).addHeader("estimate", OutputHelper::FLOAT64)
+		.addHeader("name", OutputHelper::STRING).addHeader("undeclared").addEndl();
+	out.addValue(1).addValue(2).addValue("a").addValue(3).addEndl();
+	out.addValue(int64_t(1234567890123)).addValue(0.25).addValue(7).addValue(0.5).addEndl();
+	out.addValue(3).addValue(-1.5).addValue(2.5).addValue(4).addEndl();
+	out.addValue(4.0).addValue(std::string("text")).addValue("b").addValue(1.0f).addEndl();
+	out.addValue(5.5).addValue(1e300).addEndl(); // Fraction in INT64, short row
+	out.addValue(6).addValue(6).addValue("c").addValue(6).addEndl();
+	out.addValue(7).addValue(7.75).addValue("d").addValue(7).addEndl();
+	out.endTable("mixed");
+
+	out.addHeader("label", OutputHelper::INT64).addHeader("value").addEndl();
+	out.endTable("empty");
+}
+
+int checkContents(const Contents& contents) {
+	const int64_t missing = std::numeric_limits<int64_t>::min();
+	int failures = 0;
+
+	failures += check(contents.magic == "CYCBIN01", "file starts with magic");
+	failures += check(contents.metaStrings.at("condition") == "outcome", "string metadata");
+	failures += check(contents.metaIntegers.at("iterations") == 17, "integer metadata");
+	failures += check(contents.metaDoubles.at("log_likelihood") == -123.25, "real metadata");
+	failures += check(contents.metaVectors.at("variance") == std::vector<double>({0.5, 2.0}),
+			"vector metadata");
+
+	const Table& mixed = contents.tables.at("mixed");
+	failures += check(mixed.rows == 7 && mixed.blocks == 3, "rows span three blocks");
+	failures += check(mixed.columns.size() == 4 &&
+			mixed.columns[0].type == OutputHelper::INT64 &&
+			mixed.columns[1].type == OutputHelper::FLOAT64 &&
+			mixed.columns[2].type == OutputHelper::STRING &&
+			mixed.columns[3].type == OutputHelper::FLOAT64, "declared column types");
+	failures += check(mixed.columns[0].integers ==
+			std::vector<int64_t>({1, 1234567890123, 3, 4, missing, 6, 7}),
+			"integers, with fractions as missing");
+
+	const std::vector<double>& estimate = mixed.columns[1].doubles;
+	failures += check(estimate.size() == 7 && estimate[0] == 2.0 && estimate[1] == 0.25 &&
+			estimate[2] == -1.5 && std::isnan(estimate[3]) && estimate[4] == 1e300 &&
+			estimate[5] == 6.0 && estimate[6] == 7.75, "doubles after integers are exact");
+	failures += check(mixed.columns[2].strings ==
+			std::vector<std::string>({"a", "7", "2.5", "b", "", "c", "d"}),
+			"strings, with numbers as text and padding as empty");
+
+	const std::vector<double>& undeclared = mixed.columns[3].doubles;
+	failures += check(undeclared.size() == 7 && undeclared[0] == 3.0 && undeclared[1] == 0.5 &&
+			undeclared[2] == 4.0 && undeclared[3] == 1.0 && std::isnan(undeclared[4]),
+			"undeclared column widens to doubles");
+
+	auto found = contents.tables.find("empty");
+	failures += check(found != contents.tables.end() && found->second.rows == 0 &&
+			found->second.columns.size() == 2 && found->second.columns[1].name == "value",
+			"header is written for a table without rows");
+	return failures;
+}
+
+} // namespace binarytest
+
+} // namespace bsccs
+
+int main(int argc, char* argv[]) {
+	using namespace bsccs::binarytest;
+
+	if (argc != 2) {
+		std::cerr << "Usage: " << argv[0] << " <scratch file>" << std::endl;
+		return 1;
+	}
+	write(argv[1]);
+	try {
+		return checkContents(read(argv[1])) == 0 ? 0 : 1;
+	} catch (const std::exception& e) {
+		std::cerr << "FAIL " << e.what() << std::endl;
+		return 1;
+	}
+}
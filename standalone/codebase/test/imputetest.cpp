@@ -0,0 +1,120 @@
+/*
+ * imputetest.cpp
+ *
+ *  Runs ImputeVariables on a synthetic BBR file with missing indicator, dense and outcome
+ *  entries, once on a single thread and once with imputations spread over several threads,
+ *  and requires identical imputed data sets.  Each imputation is seeded on its own, so the
+ *  thread count must not change any imputed value.
+ *
+ *  Usage: imputetest <scratch directory>
+ */
+
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+
+#include "imputation/ImputeVariables.h"
+
+namespace bsccs {
+
+namespace imputetest {
+
+const int nImputations = 4;
+
+// Covariates 1-4 are indicators and 5 is dense; covariates 2, 4 and 5 and the outcome have gaps
+void writeData(const std::string& fileName) {
+	std::mt19937 generator(17);
+	std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+	std::ofstream out(fileName.c_str());
+	for (int i = 0; i < 300; ++i) {
+		const double dense = 2.0 * uniform(generator) - 1.0;
+		const bool event = uniform(generator) < 0.3 + 0.2 * dense;
+		if (uniform(generator) < 0.05) {
+			out << "NA";
+		} else {
+			out << (event ? 1 : 0);
+		}
+		for (int id = 1; id <= 4; ++id) {
+			const double draw = uniform(generator);
+			if ((id % 2 == 0) && draw < 0.06) {
+				out << " " << id << ":NA";
+			} else if (draw < 0.15 * id) {
+				out << " " << id << ":1";
+			}
+		}
+		if (uniform(generator) < 0.08) {
+			out << " 5:NA";
+		} else {
+			out << " 5:" << dense;
+		}
+		out << "\n";
+	}
+}
+
+std::string readFile(const std::string& fileName) {
+	std::ifstream in(fileName.c_str());
+	std::ostringstream contents;
+	contents << in.rdbuf();
+	return contents.str();
+}
+
+std::string imputedName(const std::string& directory, const std::string& name, int imputation) {
+	std::ostringstream fileName;
+	fileName << directory << "/" << name << "_imputed_" << imputation << ".txt";
+	return fileName.str();
+}
+
+void runImputation(const std::string& directory, const std::string& name, int threads) {
+	CCDArguments arguments = CCDArguments();
+	arguments.inFileName = directory + "/" + name + ".txt";
+	arguments.fileFormat = "bbr";
+	arguments.hyperprior = 1.0;
+	arguments.seed = 123;
+	arguments.noiseLevel = SILENT;
+	arguments.modeFinding.tolerance = 1E-6;
+	arguments.crossValidation.fold = 5;
+	arguments.crossValidation.foldToCompute = 5;
+	arguments.crossValidation.gridSteps = 3;
+
+	writeData(arguments.inFileName);
+	ImputeVariables imputation;
+	imputation.initialize(arguments, nImputations, true, threads);
+	imputation.impute();
+}
+
+int check(bool passed, const std::string& description) {
+	std::cout << (passed ? "PASS " : "FAIL ") << description << std::endl;
+	return passed ? 0 : 1;
+}
+
+} // namespace imputetest
+
+} // namespace bsccs
+
+int main(int argc, char* argv[]) {
+	using namespace bsccs::imputetest;
+
+	if (argc != 2) {
+		std::cerr << "Usage: " << argv[0] << " <scratch directory>" << std::endl;
+		return 1;
+	}
+	const std::string directory = argv[1];
+
+	runImputation(directory, "single", 1);
+	runImputation(directory, "threaded", 3);
+
+	int failures = 0;
+	for (int i = 0; i < nImputations; ++i) {
+		const std::string single = readFile(imputedName(directory, "single", i));
+		const std::string threaded = readFile(imputedName(directory, "threaded", i));
+		std::ostringstream description;
+		description << "imputation " << i << " is the same on 1 and 3 threads";
+		failures += check(!single.empty() && single == threaded, description.str());
+	}
+	failures += check(readFile(imputedName(directory, "single", 0)) !=
+			readFile(imputedName(directory, "single", 1)), "imputations draw different values");
+	return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,252 @@
+/*
+ * packtest.cpp
+ *
+ *  Fits the same synthetic designs with per-column storage and with columns packed into
+ *  the matrix-wide arena (CompressedDataMatrix::packColumns()) and requires identical
+ *  estimates.  Also checks that mutable access to a packed column moves it out of the
+ *  arena without disturbing its own or any other column's entries, and that repacking
+ *  afterwards keeps every column intact.
+ *
+ *  Usage: packtest
+ */
+
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "CyclicCoordinateDescent.h"
+#include "ModelData.h"
+#include "engine/AbstractModelSpecifics.h"
+#include "priors/JointPrior.h"
+#include "io/CmdLineProgressLogger.h"
+
+namespace bsccs {
+
+namespace packtest {
+
+class SilentLogger : public loggers::ProgressLogger {
+public:
+	void writeLine(const std::ostringstream& /*stream*/) { }
+	void yield() { }
+};
+
+static const loggers::ProgressLoggerPtr logger = bsccs::make_shared<SilentLogger>();
+static const loggers::ErrorHandlerPtr error = bsccs::make_shared<loggers::CerrErrorHandler>();
+
+bool isStratified(const ModelType modelType) {
+	return modelType == ModelType::CONDITIONAL_LOGISTIC
+		|| modelType == ModelType::CONDITIONAL_POISSON;
+}
+
+bool isSurvival(const ModelType modelType) {
+	return modelType == ModelType::COX;
+}
+
+// Two dense columns, then alternating sparse indicator and sparse real-valued columns
+ModelData* synthesize(const ModelType modelType, bool pack) {
+	const int N = 2000;
+	const int nColumns = 12;
+	const int stratumSize = isStratified(modelType) ? 10 : 1;
+
+	std::mt19937 generator(31);
+	std::uniform_real_distribution<double> uniform(0.0, 1.0);
+	std::normal_distribution<double> normal(0.0, 1.0);
+
+	std::vector<IdType> stratumId(N);
+	std::vector<IdType> rowId(N);
+	std::vector<double> y(N);
+	std::vector<double> time(N);
+	for (int i = 0; i < N; ++i) {
+		stratumId[i] = i / stratumSize;
+		rowId[i] = i;
+		if (modelType == ModelType::NORMAL) {
+			y[i] = normal(generator);
+		} else if (modelType == ModelType::POISSON) {
+			y[i] = std::floor(2.0 * uniform(generator));
+		} else {
+			y[i] = (uniform(generator) < 0.3 || i % stratumSize == 0) ? 1.0 : 0.0;
+		}
+		time[i] = isSurvival(modelType) ? 1.0 + 10.0 * uniform(generator) :
+				1.0 + uniform(generator);
+	}
+
+	std::vector<int64_t> covariateId;
+	std::vector<int64_t> covariateRowId;
+	std::vector<double> covariateValue;
+	for (int j = 0; j < nColumns; ++j) {
+		const double density = (j < 2) ? 1.0 : 0.02 * (j + 1);
+		for (int i = 0; i < N; ++i) {
+			if (uniform(generator) < density) {
+				covariateId.push_back(j + 1);
+				covariateRowId.push_back(i);
+				covariateValue.push_back(j < 2 ? normal(generator) :
+						(j % 2 == 0) ? 1.0 : 0.5 + uniform(generator));
+			}
+		}
+	}
+
+	ModelData* data = new ModelData(modelType, logger, error);
+	data->loadY(stratumId, rowId, y, time);
+	data->loadMultipleX(covariateId, covariateRowId, covariateValue, true, true, false, false);
+	data->convertColumnToDense(data->getColumnIndex(1));
+	data->convertColumnToDense(data->getColumnIndex(2));
+	if (isSurvival(modelType)) {
+		data->sortRows(true);
+	}
+	if (pack) {
+		data->packColumns();
+	}
+	data->setIsFinalized(true);
+	return data;
+}
+
+std::vector<double> fit(ModelData& data, priors::PriorType priorType) {
+	AbstractModelSpecifics* specifics = AbstractModelSpecifics::factory(data.getModelType(), data);
+	priors::PriorPtr covariatePrior = (priorType == priors::LAPLACE) ?
+			priors::PriorPtr(bsccs::make_shared<priors::LaplacePrior>(1.0)) :
+			priors::PriorPtr(bsccs::make_shared<priors::NormalPrior>(1.0));
+	priors::JointPriorPtr prior =
+			bsccs::make_shared<priors::FullyExchangeableJointPrior>(covariatePrior);
+	CyclicCoordinateDescent ccd(data, *specifics, prior, logger, error);
+	ccd.setNoiseLevel(SILENT);
+	ModeFindingArguments arguments;
+	arguments.tolerance = 1e-8;
+	ccd.update(arguments);
+
+	std::vector<double> estimates;
+	for (int j = 0; j < ccd.getBetaSize(); ++j) {
+		estimates.push_back(ccd.getBeta(j));
+	}
+	estimates.push_back(ccd.getLogLikelihood());
+	delete specifics;
+	return estimates;
+}
+
+int check(bool passed, const std::string& description) {
+	std::cout << (passed ? "PASS " : "FAIL ") << description << std::endl;
+	return passed ? 0 : 1;
+}
+
+int checkFits() {
+	const std::vector<std::pair<ModelType, std::string>> models = {
+		{ModelType::NORMAL, "ls"},
+		{ModelType::POISSON, "pr"},
+		{ModelType::LOGISTIC, "lr"},
+		{ModelType::CONDITIONAL_LOGISTIC, "clr"},
+		{ModelType::COX, "cox"}
+	};
+	const std::vector<std::pair<priors::PriorType, std::string>> priorTypes = {
+		{priors::LAPLACE, "laplace"},
+		{priors::NORMAL, "normal"}
+	};
+
+	int failures = 0;
+	for (const auto& model : models) {
+		ModelData* unpacked = synthesize(model.first, false);
+		ModelData* packed = synthesize(model.first, true);
+		failures += check(!unpacked->isPacked() && packed->isPacked(),
+				model.second + " storage layouts differ");
+		for (const auto& prior : priorTypes) {
+			failures += check(fit(*unpacked, prior.first) == fit(*packed, prior.first),
+					model.second + " " + prior.second + " estimates match unpacked fit");
+		}
+		delete unpacked;
+		delete packed;
+	}
+	return failures;
+}
+
+struct Contents {
+	std::vector<int> columns;
+	std::vector<real> data;
+};
+
+std::vector<Contents> copyColumns(const ModelData& data) {
+	std::vector<Contents> contents(data.getNumberOfColumns());
+	for (size_t j = 0; j < contents.size(); ++j) {
+		const CompressedDataColumn& column = data.getColumn(j);
+		const ColumnView<int> columns = column.getColumnsView();
+		const ColumnView<real> values = column.getDataView();
+		contents[j].columns.assign(columns.begin(), columns.end());
+		contents[j].data.assign(values.begin(), values.end());
+	}
+	return contents;
+}
+
+bool sameColumns(const std::vector<Contents>& lhs, const std::vector<Contents>& rhs) {
+	if (lhs.size() != rhs.size()) {
+		return false;
+	}
+	for (size_t j = 0; j < lhs.size(); ++j) {
+		if (lhs[j].columns != rhs[j].columns || lhs[j].data != rhs[j].data) {
+			return false;
+		}
+	}
+	return true;
+}
+
+int checkMutation() {
+	ModelData* data = synthesize(ModelType::LOGISTIC, true);
+	std::vector<Contents> expected = copyColumns(*data);
+	int failures = 0;
+
+	// Dense column
+	CompressedDataColumn& dense = data->getColumn(data->getColumnIndex(1));
+	std::vector<real>& values = dense.getDataVector();
+	failures += check(!dense.isPacked(), "getDataVector() unpacks a dense column");
+	failures += check(sameColumns(copyColumns(*data), expected),
+			"unpacking a dense column keeps every column intact");
+	values[3] += 1.0;
+	expected[data->getColumnIndex(1)].data[3] += 1.0;
+
+	// Sparse column: indices move out of the arena, the rest stay packed
+	const size_t sparseIndex = data->getColumnIndex(6);
+	CompressedDataColumn& sparse = data->getColumn(sparseIndex);
+	std::vector<int>& rows = sparse.getColumnsVector();
+	failures += check(!sparse.isPacked() && data->getColumn(sparseIndex + 1).isPacked(),
+			"getColumnsVector() unpacks only its own column");
+	rows.pop_back();
+	expected[sparseIndex].columns.pop_back();
+	if (!expected[sparseIndex].data.empty()) {
+		sparse.getDataVector().pop_back();
+		expected[sparseIndex].data.pop_back();
+	}
+
+	// Explicit unpack of a column left in the arena
+	CompressedDataColumn& other = data->getColumn(data->getColumnIndex(9));
+	other.unpack();
+	failures += check(!other.isPacked(), "unpack() releases a packed column");
+	failures += check(sameColumns(copyColumns(*data), expected),
+			"mutated columns change and all others stay intact");
+
+	data->packColumns();
+	bool allPacked = true;
+	for (size_t j = 0; j < data->getNumberOfColumns(); ++j) {
+		allPacked = allPacked && data->getColumn(j).isPacked();
+	}
+	failures += check(allPacked, "repacking moves every column back into the arena");
+	failures += check(sameColumns(copyColumns(*data), expected),
+			"repacking keeps mutated and untouched columns intact");
+
+	delete data;
+	return failures;
+}
+
+} // namespace packtest
+
+} // namespace bsccs
+
+int main(int argc, char* argv[]) {
+	using namespace bsccs::packtest;
+
+	if (argc != 1) {
+		std::cerr << "Usage: " << argv[0] << std::endl;
+		return 1;
+	}
+	int failures = checkFits();
+	failures += checkMutation();
+	return failures == 0 ? 0 : 1;
+}
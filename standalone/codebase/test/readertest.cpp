@@ -0,0 +1,135 @@
+/*
+ * readertest.cpp
+ *
+ *  Checks the chunked SCCS and BBR readers against the ModelData the previous
+ *  (stringstream-based) readers produced for the fixtures in data/.  Each fixture is
+ *  read with several thread counts, so chunk boundaries fall inside patients and rows.
+ *
+ *  Usage: readertest <data directory>
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+#include "ModelData.h"
+#include "io/SCCSInputReader.h"
+#include "io/BBRInputReader.h"
+#include "io/ChunkedFileParser.h"
+
+namespace bsccs {
+
+namespace readertest {
+
+template <typename T>
+void writeVector(std::ostream& out, const char* name, const std::vector<T>& values) {
+	out << name;
+	for (const auto& value : values) {
+		out << " " << value;
+	}
+	out << "\n";
+}
+
+// Text form of everything the readers fill in, used as the expected output
+std::string dump(ModelData& modelData) {
+	std::ostringstream out;
+	out << std::setprecision(17);
+	out << "rows " << modelData.getNumberOfRows() << "\n";
+	out << "patients " << modelData.getNumberOfPatients() << "\n";
+	out << "condition " << modelData.getConditionId() << "\n";
+	writeVector(out, "pid", modelData.getPidVectorRef());
+	writeVector(out, "y", modelData.getYVectorRef());
+	writeVector(out, "z", modelData.getZVectorRef());
+	writeVector(out, "offs", modelData.getTimeVectorRef());
+	writeVector(out, "nevents", modelData.getNEventsVectorRef());
+	for (size_t j = 0; j < modelData.getNumberOfColumns(); ++j) {
+		CompressedDataColumn& column = modelData.getColumn(j);
+		out << "column " << column.getNumericalLabel() << " " << column.getTypeString() << "\n";
+		if (column.getFormatType() == DENSE) {
+			writeVector(out, "data", column.getDataVector());
+		} else {
+			writeVector(out, "rows", column.getColumnsVector());
+		}
+	}
+	return out.str();
+}
+
+std::string readExpected(const std::string& fileName) {
+	std::ifstream in(fileName.c_str());
+	std::ostringstream contents;
+	contents << in.rdbuf();
+	return contents.str();
+}
+
+int check(bool passed, const std::string& description) {
+	std::cout << (passed ? "PASS " : "FAIL ") << description << std::endl;
+	return passed ? 0 : 1;
+}
+
+template <typename Reader>
+int checkReader(const std::string& directory, const std::string& name) {
+	const std::string expected = readExpected(directory + "/" + name + ".expected");
+	int failures = check(!expected.empty(), name + ".expected is readable");
+	for (int threads : {1, 2, 3, 7}) {
+		Reader reader(threads);
+		reader.readFile((directory + "/" + name + ".txt").c_str());
+		std::ostringstream description;
+		description << name << ".txt with " << threads << " thread(s)";
+		failures += check(dump(*reader.getModelData()) == expected, description.str());
+	}
+	return failures;
+}
+
+int checkNumbers() {
+	using namespace parsing;
+	auto token = [](const std::string& text) {
+		Token token;
+		token.begin = text.data();
+		token.end = text.data() + text.size();
+		return token;
+	};
+	const std::string maxInt = "2147483647";
+	const std::string tooBig = "2147483648";
+	const std::string huge = "12345678901234567890123";
+	const std::string negative = "-42";
+
+	int integer = 0;
+	int failures = 0;
+	failures += check(parseInteger(token(maxInt), integer) && integer == 2147483647,
+			"largest int parses");
+	failures += check(!parseInteger(token(tooBig), integer), "int overflow is rejected");
+	failures += check(parseInteger(token(negative), integer) && integer == -42,
+			"negative int parses");
+
+	long longInteger = 0;
+	failures += check(!parseInteger(token(huge), longInteger), "long overflow is rejected");
+
+	real value = 0.0;
+	failures += check(parseReal(token(huge), value) && value == 12345678901234567890123.0,
+			"real falls back to strtod on integer overflow");
+	return failures;
+}
+
+} // namespace readertest
+
+} // namespace bsccs
+
+int main(int argc, char* argv[]) {
+	using namespace bsccs;
+	using namespace bsccs::readertest;
+
+	if (argc != 2) {
+		std::cerr << "Usage: " << argv[0] << " <data directory>" << std::endl;
+		return 1;
+	}
+	const std::string directory = argv[1];
+
+	int failures = checkNumbers();
+	failures += checkReader<SCCSInputReader>(directory, "sccs");
+	failures += checkReader<BBRInputReader<NoImputation> >(directory, "bbr");
+
+	return failures == 0 ? 0 : 1;
+}